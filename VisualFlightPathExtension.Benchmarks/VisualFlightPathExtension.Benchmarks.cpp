@@ -0,0 +1,569 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "udpCommand.h"
+#include "numberUtils.h"
+#include "byteOrder.h"
+#include "log.h"
+#include "indicatorTypeTable.h"
+#include "pathGenerator.h"
+#include "geodesy.h"
+#include "udpProxy.h"
+#include "telemetrySubscribers.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <streambuf>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <sstream>
+#include <cstdlib>
+#include <new>
+#include <cmath>
+
+/// <summary>
+/// Micro-benchmarks of the hot paths of the extension. Each benchmark measures the current implementation next to a
+/// reference which mirrors the replaced approach, so both can be compared on the same machine. Build in Release mode.
+///
+/// Usage: VisualFlightPathExtension.Benchmarks [benchmark name]
+/// </summary>
+
+namespace
+{
+    /// <summary>
+    /// Receives the results of the measured operations, so the compiler cannot remove them.
+    /// </summary>
+    volatile unsigned long long benchmarkSink = 0;
+
+    /// <summary>
+    /// Number of calls of the global operator new, see below.
+    /// </summary>
+    std::atomic<unsigned long long> allocationCount{ 0 };
+}
+
+/// <summary>
+/// Counts the allocations, so benchmarks can report the allocations per operation.
+/// </summary>
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    /// <summary>
+    /// Runs the operation the given number of times and prints the throughput.
+    /// </summary>
+    /// <param name="label">Name of the measured variant</param>
+    /// <param name="iterations">Number of calls of the operation</param>
+    /// <param name="operation">Callable unsigned long long(unsigned long long iteration)</param>
+    /// <param name="itemsPerIteration">Number of items (e.g. values) processed by one call, the throughput is given in items</param>
+    template <typename Operation>
+    void measure(const std::string& label, unsigned long long iterations, Operation&& operation, unsigned long long itemsPerIteration = 1)
+    {
+        unsigned long long sum = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned long long i = 0; i < iterations; i++)
+        {
+            sum += operation(i);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        benchmarkSink = benchmarkSink + sum;
+
+        std::cout << "  " << std::left << std::setw(48) << label << std::right << std::fixed << std::setprecision(2) <<
+            std::setw(10) << iterations * itemsPerIteration / seconds / 1e6 << " M/s" << std::endl;
+    }
+
+    /// <summary>
+    /// Parses alternating SET and REMOVE messages and invalid SET messages with the allocation free CommandParser and
+    /// with the class based CommandConfigurationParser, which allocates and throws like the former parser.
+    /// </summary>
+    void runCommandParserBenchmark()
+    {
+        char setMessage[SET_MESSAGE_LENGTH] = {};
+        writeUshortInNetworkByteOrder(COMMAND_ID_SET, setMessage);
+        writeUshortInNetworkByteOrder(5, setMessage + 2);
+        writeUintInNetworkByteOrder(1, setMessage + 4);
+        writeDoubleInNetworkByteOrder(51.36, setMessage + 8);
+        writeDoubleInNetworkByteOrder(7.47, setMessage + 16);
+        writeDoubleInNetworkByteOrder(1000, setMessage + 24);
+
+        char removeMessage[10] = {};
+        writeUshortInNetworkByteOrder(COMMAND_ID_REMOVE, removeMessage);
+        for (ushort i = 0; i < 4; i++)
+        {
+            writeUshortInNetworkByteOrder(i + 1, removeMessage + 2 + i * 2);
+        }
+
+        char invalidMessage[SET_MESSAGE_LENGTH];
+        std::memcpy(invalidMessage, setMessage, SET_MESSAGE_LENGTH);
+        writeDoubleInNetworkByteOrder(95.0, invalidMessage + 8);
+
+        // the parsed command holds the largest message inline, it lives in a queue slot in the extension
+        static ParsedCommand command;
+
+        measure("CommandParser, SET and REMOVE", 5000000, [&](unsigned long long i) {
+            bool isSet = i % 2 == 0;
+            ParseError error = CommandParser::parse(isSet ? setMessage : removeMessage, isSet ? SET_MESSAGE_LENGTH : 10, command);
+            return static_cast<unsigned long long>(error) + command.index();
+        });
+        measure("CommandConfigurationParser, SET and REMOVE", 500000, [&](unsigned long long i) {
+            bool isSet = i % 2 == 0;
+            return static_cast<unsigned long long>(CommandConfigurationParser::parse(isSet ? setMessage : removeMessage, isSet ? SET_MESSAGE_LENGTH : 10)->getCommand());
+        });
+        measure("CommandParser, invalid SET", 5000000, [&](unsigned long long) {
+            return static_cast<unsigned long long>(CommandParser::parse(invalidMessage, SET_MESSAGE_LENGTH, command));
+        });
+        measure("CommandConfigurationParser, invalid SET", 500000, [&](unsigned long long) {
+            try
+            {
+                CommandConfigurationParser::parse(invalidMessage, SET_MESSAGE_LENGTH);
+                return 0ull;
+            }
+            catch (const std::invalid_argument&)
+            {
+                return 1ull;
+            }
+        });
+    }
+
+    /// <summary>
+    /// Byte by byte reversal which was used to read network byte order before the bswap and SIMD conversion.
+    /// </summary>
+    double readDoubleByReversal(const char* src)
+    {
+        char tmp[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            tmp[i] = src[7 - i];
+        }
+
+        double value;
+        std::memcpy(&value, tmp, sizeof(value));
+        return value;
+    }
+
+    /// <summary>
+    /// Decodes doubles in network byte order with the byte reversal loop, the single value helper and every bulk
+    /// implementation the CPU supports. One SET record (6 doubles) shows the per call overhead, 1000 records (48 KB in
+    /// and out) stay in the L2 cache and show the decoding throughput, 100000 records (4.8 MB in and out) exceed the L2
+    /// cache and are limited by the L3 or memory bandwidth.
+    /// </summary>
+    void runByteOrderBenchmark()
+    {
+        ByteOrderImplementation selectedImplementation = getByteOrderImplementation();
+
+        for (size_t records : { 1, 1000, 100000 })
+        {
+            size_t count = records * 6;
+            unsigned long long iterations = 600000000 / count;
+            std::vector<char> raw(count * 8);
+            std::vector<double> values(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                writeDoubleInNetworkByteOrder(i * 0.5, raw.data() + i * 8);
+            }
+
+            std::string size = std::to_string(records) + (records == 1 ? " record" : " records");
+            measure(size + ", byte reversal", iterations, [&](unsigned long long) {
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = readDoubleByReversal(raw.data() + i * 8);
+                }
+                return static_cast<unsigned long long>(values[count - 1]);
+            }, count);
+            measure(size + ", single value bswap", iterations, [&](unsigned long long) {
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = readDoubleinNetworkByteOrder(raw.data() + i * 8);
+                }
+                return static_cast<unsigned long long>(values[count - 1]);
+            }, count);
+
+            for (ByteOrderImplementation implementation : { BYTE_ORDER_SCALAR, BYTE_ORDER_SSSE3, BYTE_ORDER_AVX2 })
+            {
+                if (!setByteOrderImplementation(implementation))
+                {
+                    continue;
+                }
+
+                measure(size + ", bulk " + getByteOrderImplementationName(implementation), iterations, [&](unsigned long long) {
+                    readDoublesInNetworkByteOrder(raw.data(), values.data(), count);
+                    return static_cast<unsigned long long>(values[count - 1]);
+                }, count);
+            }
+        }
+
+        setByteOrderImplementation(selectedImplementation);
+    }
+
+    /// <summary>
+    /// Receiver of the UDPProxy which ignores all messages.
+    /// </summary>
+    class NullCallback : public UDPProxyCallback
+    {
+    public:
+        void handleMessage(char*, uint) override
+        {
+        }
+    };
+
+    /// <summary>
+    /// Stream buffer which discards everything, so console output does not distort the measurements.
+    /// </summary>
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+
+    /// <summary>
+    /// Measures the latency of Logger::logInfo for several threads, first with synchronous printing (before Logger::start)
+    /// and then with the background writer. The console output is discarded. The first call of a thread registers its log
+    /// buffer, it is reported separately and not included in the percentiles.
+    /// </summary>
+    void runLoggerBenchmark()
+    {
+        const int threadCount = 4;
+        const int messagesPerThread = 50000;
+        const std::string message = "Set Indicator: Indicator 12 of type 3 Lat: 51.360000, Long: 7.470000, Height: 1000.000000";
+
+        for (bool isAsynchronous : { false, true })
+        {
+            NullBuffer nullBuffer;
+            std::streambuf* consoleBuffer = std::cout.rdbuf(&nullBuffer);
+            if (isAsynchronous)
+            {
+                Logger::start();
+            }
+
+            std::vector<std::vector<long long>> latencies(threadCount);
+            std::vector<long long> firstLatencies(threadCount);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; t++)
+            {
+                threads.emplace_back([&latencies, &firstLatencies, &message, t, messagesPerThread] {
+                    latencies[t].reserve(messagesPerThread);
+
+                    std::chrono::steady_clock::time_point firstStart = std::chrono::steady_clock::now();
+                    Logger::logInfo(message);
+                    firstLatencies[t] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - firstStart).count();
+
+                    for (int i = 0; i < messagesPerThread; i++)
+                    {
+                        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                        Logger::logInfo(message);
+                        latencies[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+                        // bursts of log lines with pauses in between, like the command executor under load
+                        if (i % 64 == 63)
+                        {
+                            std::this_thread::sleep_for(std::chrono::microseconds(50));
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (isAsynchronous)
+            {
+                Logger::stop();
+            }
+            std::cout.rdbuf(consoleBuffer);
+
+            std::vector<long long> all;
+            for (const std::vector<long long>& threadLatencies : latencies)
+            {
+                all.insert(all.end(), threadLatencies.begin(), threadLatencies.end());
+            }
+            std::sort(all.begin(), all.end());
+
+            std::cout << "  " << std::left << std::setw(14) << (isAsynchronous ? "asynchronous" : "synchronous") << std::right <<
+                "p50 " << all[all.size() / 2] << " ns, p99 " << all[all.size() * 99 / 100] << " ns, max " << all.back() << " ns, first call max " <<
+                *std::max_element(firstLatencies.begin(), firstLatencies.end()) << " ns";
+            if (isAsynchronous)
+            {
+                std::cout << ", " << Logger::getDroppedRecordCount() << " dropped";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /// <summary>
+    /// Compares the indicator type lookup by copying the whole mapping per lookup (the former behaviour) with a lookup
+    /// in an atomically published IndicatorTypeTable snapshot. Both use 15 mappings.
+    /// </summary>
+    void runTypeTableBenchmark()
+    {
+        const uint typeCount = 15;
+        std::unordered_map<uint, std::string> mapping;
+        std::string properties;
+        for (uint id = 1; id <= typeCount; id++)
+        {
+            std::string name = "VFP_Circle_S_" + std::to_string(id);
+            mapping[id] = name;
+            properties += std::to_string(id) + "=" + name + "\n";
+        }
+
+        std::istringstream input(properties);
+        std::atomic<std::shared_ptr<const IndicatorTypeTable>> table(IndicatorTypeTable::parse(input, nullptr));
+
+        measure("map copy per lookup", 1000000, [&](unsigned long long i) {
+            std::unordered_map<uint, std::string> copy = mapping;
+            std::unordered_map<uint, std::string>::const_iterator it = copy.find(static_cast<uint>(i % typeCount + 1));
+            return static_cast<unsigned long long>(it == copy.end() ? 0 : it->second.size());
+        });
+        measure("snapshot load and getName", 20000000, [&](unsigned long long i) {
+            std::shared_ptr<const IndicatorTypeTable> snapshot = table.load();
+            return static_cast<unsigned long long>(std::strlen(snapshot->getName(static_cast<uint>(i % typeCount + 1))));
+        });
+    }
+
+    /// <summary>
+    /// Generates a path of 100000 rings through 8 waypoints with great-circle segments and with the Catmull-Rom spline.
+    /// The generator is reused like in the extension, so only the first path allocates its buffers.
+    /// </summary>
+    void runPathGeneratorBenchmark()
+    {
+        const size_t ringCount = 100000;
+        std::vector<PathWaypoint> waypoints;
+        double length = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            // zigzag, so the spline has curvature at every waypoint
+            waypoints.push_back(PathWaypoint{ 51.0 + i * 0.2, 7.0 + (i % 2) * 0.3, 1000.0 + i * 200.0 });
+            if (i > 0)
+            {
+                length += getGreatCircleDistance(waypoints[i - 1].latitude, waypoints[i - 1].longitude, waypoints[i].latitude, waypoints[i].longitude);
+            }
+        }
+        double spacing = length / ringCount;
+
+        PathGenerator generator;
+        for (PathInterpolation interpolation : { PATH_INTERPOLATION_GREAT_CIRCLE, PATH_INTERPOLATION_CATMULL_ROM })
+        {
+            size_t rings = generator.generate(waypoints, spacing, interpolation, ringCount).size();
+            measure(std::to_string(rings) + " rings, " + getPathInterpolationName(interpolation), 50, [&](unsigned long long) {
+                std::span<const WorldPositionStruct> positions = generator.generate(waypoints, spacing, interpolation, ringCount);
+                return static_cast<unsigned long long>(positions.back().heading);
+            }, rings);
+        }
+    }
+
+    /// <summary>
+    /// Encodes the same sequence of aircraft states (a 10 minute flight at 60 Hz with a slow turn and climb) with
+    /// TelemetryEncoder in version 1 and version 2, and prints the encoding throughput and the bytes per second at 60 Hz.
+    /// </summary>
+    void runTelemetryFormatBenchmark()
+    {
+        const int stateRate = 60;
+        const size_t stateCount = stateRate * 600;
+        static AircraftStateStruct states[stateCount];
+        AircraftStateStruct state{ 51.36, 7.47, 3000.0, 90.0, 0.0, 0.0, 120.0 };
+        for (size_t i = 0; i < stateCount; i++)
+        {
+            double seconds = static_cast<double>(i) / stateRate;
+            state.heading = std::fmod(90.0 + seconds * 0.5, 360.0);
+            state.bank = 15.0 + std::sin(seconds) * 0.5;
+            state.pitch = -2.0 + std::sin(seconds * 0.3) * 0.2;
+            state.altitude += 500.0 / 60.0 / stateRate;
+            state.speed = 120.0 + std::sin(seconds * 0.1) * 2.0;
+
+            // 120 kts along the heading
+            double distance = state.speed * 0.514444 / stateRate;
+            state.latitude += distance * std::cos(state.heading * 3.14159265358979 / 180.0) / 111320.0;
+            state.longitude += distance * std::sin(state.heading * 3.14159265358979 / 180.0) / (111320.0 * std::cos(state.latitude * 3.14159265358979 / 180.0));
+            states[i] = state;
+        }
+
+        char buffer[TELEMETRY_MAX_MESSAGE_LENGTH];
+        for (TelemetryFormat format : { TELEMETRY_FORMAT_V1, TELEMETRY_FORMAT_V2 })
+        {
+            TelemetryEncoder encoder(format);
+            unsigned long long bytes = 0;
+            for (size_t i = 0; i < stateCount; i++)
+            {
+                bytes += encoder.encode(states[i], i * 1000000 / stateRate, buffer);
+            }
+
+            encoder.setFormat(format);
+            measure(std::string(getTelemetryFormatName(format)) + ", encode", 50, [&](unsigned long long iteration) {
+                unsigned long long length = 0;
+                for (size_t i = 0; i < stateCount; i++)
+                {
+                    length += encoder.encode(states[i], (iteration * stateCount + i) * 1000000 / stateRate, buffer);
+                }
+                return length;
+            }, stateCount);
+
+            double bytesPerState = static_cast<double>(bytes) / stateCount;
+            std::cout << "    " << std::setprecision(1) << bytesPerState << " bytes per state, " << std::setprecision(0) <<
+                bytesPerState * stateRate << " bytes/s per subscriber at " << stateRate << " Hz" << std::endl;
+        }
+    }
+
+    /// <summary>
+    /// Sends version 1 aircraft states to 1 and 8 subscribers through the TelemetrySubscriberRegistry and
+    /// UDPProxy::sendDatagrams, which queues them in preallocated buffers and flushes all with one system call where the
+    /// platform supports it (sendmmsg). The reference mirrors the former path: a new 56 byte buffer per message and one
+    /// system call per message. The messages go to loopback ports without a receiver, so only the send path is measured.
+    /// </summary>
+    void runUDPSendBenchmark()
+    {
+        UDPProxy udpProxy;
+        NullCallback callback;
+
+        // only errors of the proxy are printed
+        Logger::setLogLevel(LOG_LEVEL_WARNING);
+        bool isStarted = udpProxy.startUDPProxy(0, &callback);
+        Logger::setLogLevel(LOG_LEVEL_INFO);
+        if (!isStarted)
+        {
+            std::cout << "  UDP socket could not be opened" << std::endl;
+            return;
+        }
+
+        const uint loopbackAddress = 0x7F000001;
+        const ushort firstPort = 10990;
+        AircraftStateStruct state{ 51.36, 7.47, 3000.0, 90.0, 0.0, -2.0, 120.0 };
+
+        for (uint subscriberCount : { 1, 8 })
+        {
+            TelemetrySubscriberRegistry registry;
+            for (uint i = 0; i < subscriberCount; i++)
+            {
+                registry.subscribe(loopbackAddress, static_cast<ushort>(firstPort + i), TELEMETRY_FORMAT_V1, 0, true, std::chrono::steady_clock::now());
+            }
+            std::string subscribers = std::to_string(subscriberCount) + (subscriberCount == 1 ? " subscriber" : " subscribers");
+            unsigned long long iterations = 200000 / subscriberCount;
+
+            // prints the allocations and system calls per message of the last measurement
+            auto measureSend = [&](const std::string& label, auto&& send) {
+                unsigned long long allocations = allocationCount.load(std::memory_order_relaxed);
+                unsigned long long systemCalls = udpProxy.getSendStatistics().systemCalls;
+                measure(subscribers + ", " + label, iterations, send, subscriberCount);
+                double messages = static_cast<double>(iterations * subscriberCount);
+                std::cout << "    " << std::setprecision(2) << (allocationCount.load(std::memory_order_relaxed) - allocations) / messages <<
+                    " allocations and " << (udpProxy.getSendStatistics().systemCalls - systemCalls) / messages << " system calls per message" << std::endl;
+            };
+
+            measureSend("new buffer, one call each", [&](unsigned long long i) {
+                TelemetryEncoder encoder;
+                for (uint s = 0; s < subscriberCount; s++)
+                {
+                    char* message = new char[TELEMETRY_V1_MESSAGE_LENGTH];
+                    uint length = encoder.encode(state, i, message);
+                    UDPDatagram datagram{ message, length, loopbackAddress, static_cast<ushort>(firstPort + s) };
+                    udpProxy.sendDatagrams(std::span<const UDPDatagram>(&datagram, 1));
+                    delete[] message;
+                }
+                return 1ull;
+            });
+            measureSend("registry, batched send", [&](unsigned long long i) {
+                std::span<const UDPDatagram> datagrams = registry.publish(state, std::chrono::steady_clock::now(), i);
+                udpProxy.sendDatagrams(datagrams);
+                return static_cast<unsigned long long>(datagrams.size());
+            });
+        }
+
+        udpProxy.stopUDPProxy();
+    }
+
+    /// <summary>
+    /// A benchmark which can be selected on the command line.
+    /// </summary>
+    struct Benchmark
+    {
+        const char* name;
+        const char* description;
+        void (*run)();
+    };
+
+    const Benchmark benchmarks[] = {
+        { "command-parser", "Parsing of command messages", runCommandParserBenchmark },
+        { "byte-order", "Decoding of doubles in network byte order (throughput in doubles)", runByteOrderBenchmark },
+        { "logger", "Latency of logInfo with 4 threads, synchronous and with the background writer", runLoggerBenchmark },
+        { "type-table", "Lookup of the model name of an indicator type (throughput in lookups)", runTypeTableBenchmark },
+        { "path-generator", "Generation of the ring positions of a PATH command (throughput in rings)", runPathGeneratorBenchmark },
+        { "telemetry-format", "Encoding of aircraft states in the wire formats (throughput in states)", runTelemetryFormatBenchmark },
+        { "udp-send", "Sending of aircraft states to the telemetry subscribers (throughput in messages)", runUDPSendBenchmark },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    const char* selected = argc > 1 ? argv[1] : nullptr;
+    bool found = false;
+
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        if (selected == nullptr || std::strcmp(selected, benchmark.name) == 0)
+        {
+            found = true;
+            std::cout << benchmark.name << ": " << benchmark.description << std::endl;
+            benchmark.run();
+        }
+    }
+
+    if (!found)
+    {
+        std::cout << "Unknown benchmark " << selected << ", available:";
+        for (const Benchmark& benchmark : benchmarks)
+        {
+            std::cout << " " << benchmark.name;
+        }
+        std::cout << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -1,11 +1,117 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "udpCommand.h"
+#include "numberUtils.h"
+#include "byteOrder.h"
+#include "indicatorTypeTable.h"
+#include "indicatorRegistry.h"
+#include "indicatorPool.h"
+#include "objectScheduler.h"
+#include "indicatorGrid.h"
+#include "indicatorVirtualizer.h"
+#include "indicatorLod.h"
+#include "pathGenerator.h"
+#include "indicatorAnchor.h"
+#include "gateDetector.h"
+#include "geodesy.h"
+#include "fakeSimBackend.h"
+#include "telemetry.h"
+#include "telemetryController.h"
+#include "telemetryFormat.h"
+#include "telemetrySubscribers.h"
+#include "udpSendQueue.h"
+#include "ringBuffer.h"
 
 #include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <cmath>
+#include <unordered_set>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
+namespace
+{
+	/// Plain values of a SET record for building test messages
+	struct SetRecord
+	{
+		ushort id;
+		uint indicatorTypeID;
+		double values[6];
+	};
+
+	/// Difference of two angles in degrees, considering the wrap around at 360 degrees
+	double getAngleDifference(double a, double b)
+	{
+		double difference = std::fmod(std::fabs(a - b), 360.0);
+		return difference > 180.0 ? 360.0 - difference : difference;
+	}
+
+	void writeSetRecord(const SetRecord& record, char* dst)
+	{
+		writeUshortInNetworkByteOrder(record.id, dst);
+		writeUintInNetworkByteOrder(record.indicatorTypeID, dst + 2);
+		for (int i = 0; i < 6; i++)
+		{
+			writeDoubleInNetworkByteOrder(record.values[i], dst + 6 + i * 8);
+		}
+	}
+
+	std::vector<char> encodeSet(const SetRecord& record)
+	{
+		std::vector<char> message(SET_MESSAGE_LENGTH);
+		writeUshortInNetworkByteOrder(COMMAND_ID_SET, message.data());
+		writeSetRecord(record, message.data() + 2);
+		return message;
+	}
+
+	std::vector<char> encodePath(ushort firstID, uint indicatorTypeID, double spacing, ushort interpolation, const std::vector<PathWaypoint>& waypoints)
+	{
+		std::vector<char> message(PATH_HEADER_LENGTH + waypoints.size() * PATH_WAYPOINT_LENGTH);
+		writeUshortInNetworkByteOrder(COMMAND_ID_PATH, message.data());
+		writeUshortInNetworkByteOrder(firstID, message.data() + 2);
+		writeUintInNetworkByteOrder(indicatorTypeID, message.data() + 4);
+		writeDoubleInNetworkByteOrder(spacing, message.data() + 8);
+		writeUshortInNetworkByteOrder(interpolation, message.data() + 16);
+		writeUshortInNetworkByteOrder(static_cast<ushort>(waypoints.size()), message.data() + 18);
+		for (size_t i = 0; i < waypoints.size(); i++)
+		{
+			char* dst = message.data() + PATH_HEADER_LENGTH + i * PATH_WAYPOINT_LENGTH;
+			writeDoubleInNetworkByteOrder(waypoints[i].latitude, dst);
+			writeDoubleInNetworkByteOrder(waypoints[i].longitude, dst + 8);
+			writeDoubleInNetworkByteOrder(waypoints[i].altitude, dst + 16);
+		}
+		return message;
+	}
+
+	std::vector<char> encodeSetBatch(const std::vector<SetRecord>& records)
+	{
+		std::vector<char> message(SET_BATCH_HEADER_LENGTH + records.size() * SET_RECORD_LENGTH);
+		writeUshortInNetworkByteOrder(COMMAND_ID_SET_BATCH, message.data());
+		writeUshortInNetworkByteOrder(static_cast<ushort>(records.size()), message.data() + 2);
+		for (size_t i = 0; i < records.size(); i++)
+		{
+			writeSetRecord(records[i], message.data() + SET_BATCH_HEADER_LENGTH + i * SET_RECORD_LENGTH);
+		}
+		return message;
+	}
+
+	bool areSetCommandsEqual(SetIndicatorCommandConfiguration& a, SetIndicatorCommandConfiguration& b)
+	{
+		WorldPosition posA = a.getPosition();
+		WorldPosition posB = b.getPosition();
+
+		return a.getID() == b.getID() && a.getIndicatorTypeID() == b.getIndicatorTypeID() &&
+			posA.getLatitude() == posB.getLatitude() && posA.getLongitude() == posB.getLongitude() &&
+			posA.getAltitude() == posB.getAltitude() && posA.getHeading() == posB.getHeading() &&
+			posA.getBank() == posB.getBank() && posA.getPitch() == posB.getPitch();
+	}
+}
+
 TEST_CLASS(VisualFlightPathExtensionTests)
 {
 public:
@@ -40,6 +146,32 @@ public:
 		}
 	}
 
+	TEST_METHOD(TestParseCommandWithoutConfiguration)
+	{
+		// these commands are only available through CommandParser
+		std::vector<std::vector<char>> messages = {
+			{ 0, 4, 0, 2 }, // TELEMETRY_FORMAT
+			{ 0, 5, 0, 2, 0, 10, 0, 0 }, // SUBSCRIBE
+			{ 0, 6, 0, 0 }, // UNSUBSCRIBE
+			encodePath(0, 1, 250.0, PATH_INTERPOLATION_GREAT_CIRCLE, { { 51.36, 7.47, 1000 }, { 51.40, 7.50, 1500 } }),
+			std::vector<char>(ANCHOR_MESSAGE_LENGTH),
+		};
+		writeUshortInNetworkByteOrder(COMMAND_ID_ANCHOR, messages.back().data());
+
+		for (std::vector<char>& message : messages)
+		{
+			try
+			{
+				CommandConfigurationParser::parse(message.data(), (uint)message.size());
+				Assert::Fail(L"Expected std::invalid_argument was not thrown");
+			}
+			catch (const std::invalid_argument e)
+			{
+				Assert::IsTrue(strcmp(e.what(), "unknown_command") == 0);
+			}
+		}
+	}
+
 	TEST_METHOD(TestRemoveCommandWithoutIndicatorID)
 	{
 		char rawBytes[] = { 0, 2 };
@@ -227,4 +359,1575 @@ public:
 			Assert::IsTrue(strcmp(e.what(), "LONGITUDE_OUT_OF_RANGE") == 0);
 		}
 	}
-};
+
+	TEST_METHOD(TestSetBatchCommandEquivalentToSingleSetCommands)
+	{
+		std::vector<SetRecord> records = {
+			{ 1, 1, { 50.0379, 8.5622, 1200.5, 250.0, -5.25, 3.0 } },
+			{ 2, 7, { -33.9461, 151.1772, 21.0, 0.0, 0.0, -12.5 } },
+			{ 65535, 15, { 89.9999, -179.9999, 45000.0, 359.9, 90.0, -90.0 } },
+		};
+
+		std::vector<char> batchMessage = encodeSetBatch(records);
+		std::unique_ptr<AbstractCommandConfiguration> batchCommand = CommandConfigurationParser::parse(batchMessage.data(), (uint)batchMessage.size());
+
+		Assert::IsTrue(SET_BATCH == batchCommand->getCommand());
+
+		std::vector<SetIndicatorCommandConfiguration>& batchIndicators = static_cast<SetIndicatorBatchCommandConfiguration*>(batchCommand.get())->getIndicators();
+		Assert::IsTrue(batchIndicators.size() == records.size());
+
+		for (size_t i = 0; i < records.size(); i++)
+		{
+			std::vector<char> singleMessage = encodeSet(records[i]);
+			std::unique_ptr<AbstractCommandConfiguration> singleCommand = CommandConfigurationParser::parse(singleMessage.data(), (uint)singleMessage.size());
+
+			Assert::IsTrue(SET == singleCommand->getCommand());
+			Assert::IsTrue(areSetCommandsEqual(*static_cast<SetIndicatorCommandConfiguration*>(singleCommand.get()), batchIndicators[i]));
+		}
+	}
+
+	TEST_METHOD(TestSetBatchCommandWithInvalidLength)
+	{
+		std::vector<char> message = encodeSetBatch({ { 1, 1, { 0, 0, 0, 0, 0, 0 } }, { 2, 1, { 0, 0, 0, 0, 0, 0 } } });
+
+		try
+		{
+			// count says two records, but the message only contains one and a half
+			CommandConfigurationParser::parse(message.data(), (uint)message.size() - SET_RECORD_LENGTH / 2);
+			Assert::Fail(L"Expected std::invalid_argument was not thrown");
+		}
+		catch (const std::invalid_argument e)
+		{
+			Assert::IsTrue(strcmp(e.what(), "set_batch_invalid_length") == 0);
+		}
+	}
+
+	TEST_METHOD(TestSetBatchCommandWithoutRecords)
+	{
+		char rawBytes[] = { 0, 3,  // command
+							0, 0}; // count
+
+		try
+		{
+			CommandConfigurationParser::parse(rawBytes, 4);
+			Assert::Fail(L"Expected std::invalid_argument was not thrown");
+		}
+		catch (const std::invalid_argument e)
+		{
+			Assert::IsTrue(strcmp(e.what(), "set_batch_invalid_length") == 0);
+		}
+	}
+
+	TEST_METHOD(TestSetBatchCommandWithInvalidRecord)
+	{
+		std::vector<char> message = encodeSetBatch({ { 1, 1, { 0, 0, 0, 0, 0, 0 } }, { 2, 1, { 0, 180.00000001, 0, 0, 0, 0 } } });
+
+		try
+		{
+			CommandConfigurationParser::parse(message.data(), (uint)message.size());
+			Assert::Fail(L"Expected std::invalid_argument was not thrown");
+		}
+		catch (const std::invalid_argument e)
+		{
+			Assert::IsTrue(strcmp(e.what(), "LONGITUDE_OUT_OF_RANGE") == 0);
+		}
+	}
+
+	TEST_METHOD(TestCommandParserReportsErrorsWithoutException)
+	{
+		ParsedCommand command;
+		char tooShort[] = { 0 };
+		char unknownCommand[] = { 1, 0 };
+		char removeInvalidLength[] = { 0, 2, 0 };
+		std::vector<char> setInvalidLatitude = encodeSet({ 1, 1, { 90.00000001, 0, 0, 0, 0, 0 } });
+
+		Assert::IsTrue(PARSE_MISSING_COMMAND == CommandParser::parse(tooShort, 1, command));
+		Assert::IsTrue(PARSE_UNKNOWN_COMMAND == CommandParser::parse(unknownCommand, 2, command));
+		Assert::IsTrue(PARSE_REMOVE_INVALID_LENGTH == CommandParser::parse(removeInvalidLength, 3, command));
+		Assert::IsTrue(PARSE_SET_INVALID_LENGTH == CommandParser::parse(setInvalidLatitude.data(), SET_MESSAGE_LENGTH - 1, command));
+		Assert::IsTrue(PARSE_LATITUDE_OUT_OF_RANGE == CommandParser::parse(setInvalidLatitude.data(), SET_MESSAGE_LENGTH, command));
+	}
+
+	TEST_METHOD(TestCommandParserSetCommand)
+	{
+		ParsedCommand command;
+		std::vector<char> message = encodeSet({ 4, 2, { 50.5, -8.25, 1000, 90, 5, -3 } });
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(message.data(), (uint)message.size(), command));
+
+		const SetIndicatorCommand* setCommand = std::get_if<SetIndicatorCommand>(&command);
+		Assert::IsNotNull(setCommand);
+		Assert::IsTrue(setCommand->id == 4);
+		Assert::IsTrue(setCommand->indicatorTypeID == 2);
+		Assert::IsTrue(setCommand->position.latitude == 50.5);
+		Assert::IsTrue(setCommand->position.longitude == -8.25);
+		Assert::IsTrue(setCommand->position.altitude == 1000);
+		Assert::IsTrue(setCommand->position.heading == 90);
+		Assert::IsTrue(setCommand->position.bank == 5);
+		Assert::IsTrue(setCommand->position.pitch == -3);
+	}
+
+	TEST_METHOD(TestCommandParserRemoveCommand)
+	{
+		ParsedCommand command;
+		char rawBytes[] = { 0, 2, // command
+							0, 1, // id 1
+							1, 0 }; // id 256
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(rawBytes, 6, command));
+
+		const RemoveIndicatorsCommand* removeCommand = std::get_if<RemoveIndicatorsCommand>(&command);
+		Assert::IsNotNull(removeCommand);
+		Assert::IsTrue(removeCommand->count == 2);
+		Assert::IsTrue(removeCommand->ids[0] == 1);
+		Assert::IsTrue(removeCommand->ids[1] == 256);
+	}
+
+	TEST_METHOD(TestCommandParserTelemetryFormatCommand)
+	{
+		ParsedCommand command;
+		char rawBytes[] = { 0, 4, // command
+							0, 2 }; // format v2
+		char unknownFormat[] = { 0, 4, 0, 3 };
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(rawBytes, 4, command));
+		const TelemetryFormatCommand* formatCommand = std::get_if<TelemetryFormatCommand>(&command);
+		Assert::IsNotNull(formatCommand);
+		Assert::IsTrue(formatCommand->format == TELEMETRY_FORMAT_V2);
+
+		Assert::IsTrue(PARSE_TELEMETRY_FORMAT_INVALID_LENGTH == CommandParser::parse(rawBytes, 3, command));
+		Assert::IsTrue(PARSE_UNKNOWN_TELEMETRY_FORMAT == CommandParser::parse(unknownFormat, 4, command));
+	}
+
+	TEST_METHOD(TestCommandParserSubscriptionCommands)
+	{
+		ParsedCommand command;
+		CommandSender sender{ 0x7F000001, 5000 };
+		char subscribe[] = { 0, 5, // command
+							 0, 2, // format v2
+							 0, 10, // 10 Hz
+							 0, 0 }; // port of the sender
+		char subscribeOtherPort[] = { 0, 5, 0, 1, 0, 0, 0x17, 0x70 }; // v1, every state, port 6000
+		char unsubscribe[] = { 0, 6, 0, 0 };
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(subscribe, 8, command, sender));
+		const SubscribeCommand* subscribeCommand = std::get_if<SubscribeCommand>(&command);
+		Assert::IsNotNull(subscribeCommand);
+		Assert::IsTrue(subscribeCommand->format == TELEMETRY_FORMAT_V2 && subscribeCommand->rate == 10);
+		Assert::IsTrue(subscribeCommand->subscriber.address == 0x7F000001 && subscribeCommand->subscriber.port == 5000);
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(subscribeOtherPort, 8, command, sender));
+		subscribeCommand = std::get_if<SubscribeCommand>(&command);
+		Assert::IsTrue(subscribeCommand->format == TELEMETRY_FORMAT_V1 && subscribeCommand->rate == 0 && subscribeCommand->subscriber.port == 6000);
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(unsubscribe, 4, command, sender));
+		const UnsubscribeCommand* unsubscribeCommand = std::get_if<UnsubscribeCommand>(&command);
+		Assert::IsNotNull(unsubscribeCommand);
+		Assert::IsTrue(unsubscribeCommand->subscriber.port == 5000);
+
+		Assert::IsTrue(PARSE_SUBSCRIBE_INVALID_LENGTH == CommandParser::parse(subscribe, 6, command, sender));
+		Assert::IsTrue(PARSE_UNSUBSCRIBE_INVALID_LENGTH == CommandParser::parse(unsubscribe, 2, command, sender));
+		subscribe[3] = 7;
+		Assert::IsTrue(PARSE_UNKNOWN_TELEMETRY_FORMAT == CommandParser::parse(subscribe, 8, command, sender));
+	}
+
+	TEST_METHOD(TestCommandParserPath)
+	{
+		ParsedCommand command;
+		std::vector<PathWaypoint> waypoints = { { 51.36, 7.47, 1000 }, { 51.40, 7.50, 1500 }, { 51.45, 7.48, 2000 } };
+		std::vector<char> message = encodePath(100, 17, 250.0, PATH_INTERPOLATION_CATMULL_ROM, waypoints);
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(message.data(), static_cast<uint>(message.size()), command));
+		const PathCommand* pathCommand = std::get_if<PathCommand>(&command);
+		Assert::IsNotNull(pathCommand);
+		Assert::IsTrue(pathCommand->firstID == 100 && pathCommand->indicatorTypeID == 17 && pathCommand->spacing == 250.0);
+		Assert::IsTrue(pathCommand->interpolation == PATH_INTERPOLATION_CATMULL_ROM && pathCommand->count == 3);
+		Assert::AreEqual(51.45, pathCommand->waypoints[2].latitude);
+		Assert::AreEqual(2000.0, pathCommand->waypoints[2].altitude);
+
+		Assert::IsTrue(PARSE_PATH_INVALID_LENGTH == CommandParser::parse(message.data(), static_cast<uint>(message.size() - 1), command));
+		std::vector<char> singleWaypoint = encodePath(0, 1, 250.0, PATH_INTERPOLATION_GREAT_CIRCLE, { waypoints[0] });
+		Assert::IsTrue(PARSE_PATH_INVALID_LENGTH == CommandParser::parse(singleWaypoint.data(), static_cast<uint>(singleWaypoint.size()), command));
+		std::vector<char> noSpacing = encodePath(0, 1, 0.0, PATH_INTERPOLATION_GREAT_CIRCLE, waypoints);
+		Assert::IsTrue(PARSE_PATH_INVALID_SPACING == CommandParser::parse(noSpacing.data(), static_cast<uint>(noSpacing.size()), command));
+		std::vector<char> unknownInterpolation = encodePath(0, 1, 250.0, 2, waypoints);
+		Assert::IsTrue(PARSE_UNKNOWN_PATH_INTERPOLATION == CommandParser::parse(unknownInterpolation.data(), static_cast<uint>(unknownInterpolation.size()), command));
+		waypoints[1].latitude = 91;
+		std::vector<char> invalidWaypoint = encodePath(0, 1, 250.0, PATH_INTERPOLATION_GREAT_CIRCLE, waypoints);
+		Assert::IsTrue(PARSE_LATITUDE_OUT_OF_RANGE == CommandParser::parse(invalidWaypoint.data(), static_cast<uint>(invalidWaypoint.size()), command));
+	}
+
+	TEST_METHOD(TestCommandParserAnchor)
+	{
+		ParsedCommand command;
+		char message[ANCHOR_MESSAGE_LENGTH];
+		writeUshortInNetworkByteOrder(COMMAND_ID_ANCHOR, message);
+		writeUshortInNetworkByteOrder(42, message + 2);
+		writeUintInNetworkByteOrder(3, message + 4);
+		writeUshortInNetworkByteOrder(ANCHOR_FRAME_BODY, message + 8);
+		double offset[6] = { 200, -10, 5, 0, 0, 0 };
+		for (int i = 0; i < 6; i++)
+		{
+			writeDoubleInNetworkByteOrder(offset[i], message + 10 + i * 8);
+		}
+
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(message, ANCHOR_MESSAGE_LENGTH, command));
+		const AnchorIndicatorCommand* anchorCommand = std::get_if<AnchorIndicatorCommand>(&command);
+		Assert::IsNotNull(anchorCommand);
+		Assert::IsTrue(anchorCommand->id == 42 && anchorCommand->indicatorTypeID == 3 && anchorCommand->frame == ANCHOR_FRAME_BODY);
+		Assert::IsTrue(anchorCommand->offset.x == 200 && anchorCommand->offset.y == -10 && anchorCommand->offset.z == 5);
+
+		Assert::IsTrue(PARSE_ANCHOR_INVALID_LENGTH == CommandParser::parse(message, ANCHOR_MESSAGE_LENGTH - 1, command));
+		writeUshortInNetworkByteOrder(2, message + 8);
+		Assert::IsTrue(PARSE_UNKNOWN_ANCHOR_FRAME == CommandParser::parse(message, ANCHOR_MESSAGE_LENGTH, command));
+		writeUshortInNetworkByteOrder(ANCHOR_FRAME_ENU, message + 8);
+
+		// non-finite and huge values are rejected, each offset and angle is checked
+		double invalidValues[] = { std::nan(""), INFINITY, -INFINITY, 1e308, ANCHOR_MAX_OFFSET * 2 };
+		for (int i = 0; i < 6; i++)
+		{
+			for (double invalidValue : invalidValues)
+			{
+				writeDoubleInNetworkByteOrder(invalidValue, message + 10 + i * 8);
+				Assert::IsTrue(PARSE_ANCHOR_INVALID_OFFSET == CommandParser::parse(message, ANCHOR_MESSAGE_LENGTH, command));
+			}
+			writeDoubleInNetworkByteOrder(offset[i], message + 10 + i * 8);
+		}
+		writeDoubleInNetworkByteOrder(ANCHOR_MAX_OFFSET, message + 10);
+		writeDoubleInNetworkByteOrder(-ANCHOR_MAX_ANGLE, message + 34);
+		Assert::IsTrue(PARSE_OK == CommandParser::parse(message, ANCHOR_MESSAGE_LENGTH, command));
+	}
+
+	TEST_METHOD(TestAnchorResolution)
+	{
+		WorldPositionStruct aircraft{ 51.36, 7.47, 3000, 0, 0, 0 };
+
+		// east-north-up offsets keep their length on the ellipsoid
+		WorldPositionStruct north = resolveAnchor(aircraft, ANCHOR_FRAME_ENU, AnchorOffset{ 0, 1000, 0, 45, 0, 0 });
+		Assert::AreEqual(1000.0, getGreatCircleDistance(aircraft.latitude, aircraft.longitude, north.latitude, north.longitude), 5.0);
+		Assert::AreEqual(aircraft.longitude, north.longitude, 1e-9);
+		Assert::AreEqual(45.0, north.heading);
+		WorldPositionStruct above = resolveAnchor(aircraft, ANCHOR_FRAME_ENU, AnchorOffset{ 0, 0, 100 * METERS_PER_FOOT, 0, 0, 0 });
+		Assert::AreEqual(3100.0, above.altitude, 1e-3);
+		Assert::AreEqual(aircraft.latitude, above.latitude, 1e-9);
+
+		// 200 m ahead of an aircraft heading east
+		aircraft.heading = 90;
+		WorldPositionStruct ahead = resolveAnchor(aircraft, ANCHOR_FRAME_BODY, AnchorOffset{ 200, 0, 0, 0, 0, 0 });
+		Assert::AreEqual(aircraft.latitude, ahead.latitude, 1e-5);
+		Assert::AreEqual(200.0, getGreatCircleDistance(aircraft.latitude, aircraft.longitude, ahead.latitude, ahead.longitude), 1.0);
+		Assert::IsTrue(ahead.longitude > aircraft.longitude);
+		Assert::AreEqual(90.0, ahead.heading);
+
+		// the nose is 10 degrees up (negative pitch like SimConnect), so a point ahead is above the aircraft
+		aircraft.pitch = -10;
+		ahead = resolveAnchor(aircraft, ANCHOR_FRAME_BODY, AnchorOffset{ 200, 0, 0, 0, 0, 0 });
+		Assert::AreEqual(3000.0 + 200 * std::sin(10 * DEGREES_TO_RADIANS) / METERS_PER_FOOT, ahead.altitude, 0.5);
+		Assert::AreEqual(-10.0, ahead.pitch);
+
+		// banked 30 degrees to the left (positive like SimConnect), the right wing tip is above the aircraft
+		aircraft.pitch = 0;
+		aircraft.bank = 30;
+		double enu[3];
+		rotateBodyToEnu(aircraft.heading, aircraft.pitch, aircraft.bank, 0, 10, 0, enu);
+		Assert::AreEqual(5.0, enu[2], 1e-9);
+		Assert::AreEqual(-10 * std::cos(30 * DEGREES_TO_RADIANS), enu[1], 1e-9);
+	}
+
+	TEST_METHOD(TestGateDetector)
+	{
+		Assert::AreEqual(GATE_RADIUS_SMALL, getGateRadius("VFP_Circle_S"));
+		Assert::AreEqual(GATE_RADIUS_MEDIUM, getGateRadius("VFP_Circle_M_blue"));
+		Assert::AreEqual(0.0, getGateRadius("VFP_Circle_XL"));
+		Assert::AreEqual(0.0, getGateRadius("VFP_Arrow"));
+
+		// small ring facing east, the aircraft flies along the parallels at the height of the ring
+		const double metersPerDegree = EARTH_MEAN_RADIUS * DEGREES_TO_RADIANS;
+		const double latitude = 51.36;
+		const double longitude = 7.47;
+		const double metersPerDegreeLongitude = metersPerDegree * std::cos(latitude * DEGREES_TO_RADIANS);
+		auto aircraftAt = [&](double east, double north) {
+			AircraftStateStruct state{};
+			state.latitude = latitude + north / metersPerDegree;
+			state.longitude = longitude + east / metersPerDegreeLongitude;
+			state.altitude = 1000;
+			state.heading = 90;
+			return state;
+		};
+
+		GateDetector detector;
+		detector.update(1, WorldPositionStruct{ latitude, longitude, 1000, 90, 0, 0 }, GATE_RADIUS_SMALL);
+
+		// the first state only starts the segment
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(-100, 5), 1000000).empty());
+		std::span<const GateEvent> events = detector.addAircraftState(aircraftAt(100, 5), 3000000);
+		Assert::AreEqual((size_t)1, events.size());
+		Assert::AreEqual((ushort)1, events[0].id);
+		Assert::AreEqual((int)GATE_PASSED, (int)events[0].type);
+		Assert::AreEqual(5.0, events[0].missDistance, 0.05);
+		Assert::AreEqual(2000000.0, (double)events[0].timestamp, 1000.0);
+
+		// back to the west 30 m north of the center is within the miss range, 50 m north is not
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(100, 30), 4000000).empty());
+		events = detector.addAircraftState(aircraftAt(-100, 30), 6000000);
+		Assert::AreEqual((size_t)1, events.size());
+		Assert::AreEqual((int)GATE_MISSED, (int)events[0].type);
+		Assert::AreEqual(30.0, events[0].missDistance, 0.05);
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(-100, 50), 7000000).empty());
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(100, 50), 8000000).empty());
+
+		// a jump through the ring is not a passage
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(-2000, 0), 9000000).empty());
+
+		// rings in other cells do not add to the cost of a segment
+		for (ushort id = 100; id < 20100; id++)
+		{
+			detector.update(id, WorldPositionStruct{ latitude + 1 + id / 10000.0, longitude, 1000, 90, 0, 0 }, GATE_RADIUS_LARGE);
+		}
+		GateStatistics before = detector.getStatistics();
+		detector.addAircraftState(aircraftAt(-1900, 0), 9500000);
+		GateStatistics after = detector.getStatistics();
+		Assert::AreEqual((size_t)20001, after.gates);
+		Assert::AreEqual(before.segments + 1, after.segments);
+		Assert::AreEqual(before.candidates, after.candidates);
+
+		// a removed ring is not passed
+		detector.remove(1);
+		detector.addAircraftState(aircraftAt(-100, 0), 10000000);
+		Assert::IsTrue(detector.addAircraftState(aircraftAt(100, 0), 11000000).empty());
+
+		// gate events are version 2 messages with their own frame types
+		GateEvent event{ 4711, GATE_MISSED, 123456789, 17.25 };
+		char message[TELEMETRY_V2_GATE_EVENT_LENGTH];
+		Assert::AreEqual((uint)TELEMETRY_V2_GATE_EVENT_LENGTH, encodeGateEvent(event, 42, message));
+		GateEvent decoded{};
+		uint sequence = 0;
+		Assert::IsTrue(decodeGateEvent(message, TELEMETRY_V2_GATE_EVENT_LENGTH, decoded, &sequence));
+		Assert::AreEqual((uint)42, sequence);
+		Assert::AreEqual(event.id, decoded.id);
+		Assert::AreEqual((int)event.type, (int)decoded.type);
+		Assert::AreEqual(event.timestamp, decoded.timestamp);
+		Assert::AreEqual(event.missDistance, decoded.missDistance, 1e-6);
+		TelemetryDecoder telemetryDecoder;
+		TelemetryFrame frame;
+		Assert::IsFalse(telemetryDecoder.decode(message, TELEMETRY_V2_GATE_EVENT_LENGTH, frame));
+	}
+
+	TEST_METHOD(TestPathGenerator)
+	{
+		PathGenerator generator;
+
+		// 10 km east along the equator, climbing 1000 ft: a position every km including both ends
+		std::vector<PathWaypoint> straight = { { 0, 0, 1000 }, { 0, 10000 / (EARTH_MEAN_RADIUS * DEGREES_TO_RADIANS), 2000 } };
+		std::span<const WorldPositionStruct> positions = generator.generate(straight, 1000, PATH_INTERPOLATION_GREAT_CIRCLE, 1000);
+		Assert::AreEqual((size_t)11, positions.size());
+		Assert::IsFalse(generator.wasTruncated());
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			Assert::AreEqual(i * 1000.0, getGreatCircleDistance(0, 0, positions[i].latitude, positions[i].longitude), 0.01);
+			Assert::AreEqual(1000.0 + i * 100.0, positions[i].altitude, 0.01);
+			Assert::AreEqual(0.0, getAngleDifference(90.0, positions[i].heading), 1e-6);
+			Assert::IsTrue(positions[i].pitch < 0); // climbing
+		}
+
+		// the great circle from Frankfurt to New York starts to the north west and crosses the meridians with changing heading
+		std::vector<PathWaypoint> transatlantic = { { 50.03, 8.56, 0 }, { 40.64, -73.78, 0 } };
+		positions = generator.generate(transatlantic, 10000, PATH_INTERPOLATION_GREAT_CIRCLE, 10000);
+		Assert::AreEqual(0.0, getAngleDifference(294.4, positions.front().heading), 0.5);
+		Assert::IsTrue(positions.back().heading > 225.0 && positions.back().heading < 250.0);
+
+		// the spline passes through the waypoints and keeps the spacing along the ground track
+		std::vector<PathWaypoint> curve = { { 51.36, 7.47, 1000 }, { 51.38, 7.50, 1200 }, { 51.40, 7.47, 1400 }, { 51.42, 7.50, 1600 } };
+		positions = generator.generate(curve, 50, PATH_INTERPOLATION_CATMULL_ROM, 100000);
+		Assert::IsTrue(positions.size() > 100);
+		for (const PathWaypoint& waypoint : curve)
+		{
+			double nearest = 1e9;
+			for (const WorldPositionStruct& position : positions)
+			{
+				nearest = std::min(nearest, getGreatCircleDistance(waypoint.latitude, waypoint.longitude, position.latitude, position.longitude));
+			}
+			Assert::IsTrue(nearest < 50.0);
+		}
+		for (size_t i = 1; i < positions.size(); i++)
+		{
+			double distance = getGreatCircleDistance(positions[i - 1].latitude, positions[i - 1].longitude, positions[i].latitude, positions[i].longitude);
+			Assert::AreEqual(50.0, distance, 1.0);
+		}
+
+		// the heading follows the tangent
+		double bearing = std::atan2(getLongitudeDifference(positions[10].longitude, positions[11].longitude) * std::cos(positions[10].latitude * DEGREES_TO_RADIANS),
+			positions[11].latitude - positions[10].latitude) / DEGREES_TO_RADIANS;
+		Assert::AreEqual(0.0, getAngleDifference(bearing, positions[10].heading), 2.0);
+
+		positions = generator.generate(curve, 50, PATH_INTERPOLATION_CATMULL_ROM, 10);
+		Assert::AreEqual((size_t)10, positions.size());
+		Assert::IsTrue(generator.wasTruncated());
+	}
+
+	TEST_METHOD(TestBulkByteOrderConversionMatchesSingleValues)
+	{
+		ByteOrderImplementation initialImplementation = getByteOrderImplementation();
+		ByteOrderImplementation implementations[] = { BYTE_ORDER_SCALAR, BYTE_ORDER_SSSE3, BYTE_ORDER_AVX2 };
+
+		for (ByteOrderImplementation implementation : implementations)
+		{
+			if (!setByteOrderImplementation(implementation))
+			{
+				continue; // not supported by this CPU
+			}
+
+			// every length up to several vector widths, so the vector loops and the scalar tails are used
+			for (size_t count = 0; count < 40; count++)
+			{
+				std::vector<double> doubles(count);
+				std::vector<ushort> ushorts(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					doubles[i] = i * 1.5 - 17.25;
+					ushorts[i] = static_cast<ushort>(i * 517 + 3);
+				}
+
+				// offset by one byte to test unaligned buffers
+				std::vector<char> raw(1 + count * 8);
+				writeDoublesInNetworkByteOrder(doubles.data(), raw.data() + 1, count);
+				for (size_t i = 0; i < count; i++)
+				{
+					Assert::IsTrue(readDoubleinNetworkByteOrder(raw.data() + 1 + i * 8) == doubles[i]);
+				}
+
+				std::vector<double> decodedDoubles(count);
+				readDoublesInNetworkByteOrder(raw.data() + 1, decodedDoubles.data(), count);
+				Assert::IsTrue(decodedDoubles == doubles);
+
+				writeUShortsInNetworkByteOrder(ushorts.data(), raw.data() + 1, count);
+				for (size_t i = 0; i < count; i++)
+				{
+					Assert::IsTrue(readUShortNetworkByteOrder(raw.data() + 1 + i * 2) == ushorts[i]);
+				}
+
+				std::vector<ushort> decodedUShorts(count);
+				readUShortsInNetworkByteOrder(raw.data() + 1, decodedUShorts.data(), count);
+				Assert::IsTrue(decodedUShorts == ushorts);
+			}
+		}
+
+		setByteOrderImplementation(initialImplementation);
+	}
+
+	TEST_METHOD(TestIndicatorTypeTableDenseAndSparseIDs)
+	{
+		std::istringstream input("1=VFP_Circle_S\r\n2=VFP_Circle_M\n\n70000=VFP_Custom\n3=VFP_Circle_S\n");
+		std::vector<std::string> invalidLines;
+
+		std::shared_ptr<const IndicatorTypeTable> table = IndicatorTypeTable::parse(input, &invalidLines);
+
+		Assert::IsTrue(invalidLines.empty());
+		Assert::IsTrue(table->size() == 4);
+		Assert::IsTrue(strcmp(table->getName(1), "VFP_Circle_S") == 0);
+		Assert::IsTrue(strcmp(table->getName(2), "VFP_Circle_M") == 0);
+		Assert::IsTrue(strcmp(table->getName(70000), "VFP_Custom") == 0);
+		Assert::IsTrue(table->getName(0) == nullptr);
+		Assert::IsTrue(table->getName(4) == nullptr);
+		Assert::IsTrue(table->getName(70001) == nullptr);
+
+		// equal model names are stored once
+		Assert::IsTrue(table->getName(1) == table->getName(3));
+		Assert::IsTrue(table->getIndicatorTypeIDs() == std::vector<uint>({ 1, 2, 3, 70000 }));
+	}
+
+	TEST_METHOD(TestIndicatorTypeTableInvalidLines)
+	{
+		std::istringstream input("1=VFP_Circle_S\nabc=VFP_Circle_M\n2\n=VFP_Circle_L\n3=\n4=a=b\n1=VFP_Other\n");
+		std::vector<std::string> invalidLines;
+
+		std::shared_ptr<const IndicatorTypeTable> table = IndicatorTypeTable::parse(input, &invalidLines);
+
+		Assert::IsTrue(invalidLines.size() == 5);
+		Assert::IsTrue(table->size() == 1);
+
+		// the first mapping of an id is kept
+		Assert::IsTrue(strcmp(table->getName(1), "VFP_Circle_S") == 0);
+	}
+
+	TEST_METHOD(TestIndicatorTypeTablePoolSizes)
+	{
+		std::istringstream input("1=VFP_Circle_S,8\n2=VFP_Circle_M\n3=VFP_Circle_S,16\n4=VFP_Circle_L,\n5=VFP_Circle_L,x\n6=,4\n1=VFP_Circle_M,4\n");
+		std::vector<std::string> invalidLines;
+
+		std::shared_ptr<const IndicatorTypeTable> table = IndicatorTypeTable::parse(input, &invalidLines);
+
+		Assert::IsTrue(invalidLines.size() == 3);
+		Assert::IsTrue(table->size() == 3);
+		Assert::IsTrue(strcmp(table->getName(1), "VFP_Circle_S") == 0);
+
+		// a model used by several types gets the largest pool, ignored mappings do not count
+		std::vector<IndicatorPoolSize> poolSizes = table->getPoolSizes();
+		Assert::AreEqual((size_t)1, poolSizes.size());
+		Assert::IsTrue(poolSizes[0].modelName == "VFP_Circle_S" && poolSizes[0].size == 16);
+	}
+
+	TEST_METHOD(TestIndicatorTypeTableLodGroups)
+	{
+		std::istringstream input("1=VFP_Circle_S\n20=VFP_Circle_S_blue@2|VFP_Circle_M_blue@10|VFP_Circle_L_blue,4\n21=VFP_Circle_S@5|VFP_Circle_L@5\n"
+			"22=VFP_Circle_S@2|VFP_Circle_L@3\n23=VFP_Circle_S|VFP_Circle_L\n");
+		std::vector<std::string> invalidLines;
+
+		std::shared_ptr<const IndicatorTypeTable> table = IndicatorTypeTable::parse(input, &invalidLines);
+
+		// the distances have to ascend and only the last model has none
+		Assert::IsTrue(invalidLines.size() == 3);
+		Assert::IsTrue(table->size() == 2);
+		Assert::IsTrue(table->getLodGroup(1) == nullptr);
+
+		// the nearest model is the plain mapping, the pool size applies to all models
+		std::shared_ptr<const IndicatorLodGroup> group = table->getLodGroup(20);
+		Assert::IsTrue(group != nullptr && group->levels.size() == 3);
+		Assert::IsTrue(strcmp(table->getName(20), "VFP_Circle_S_blue") == 0);
+		Assert::AreEqual(10000.0, group->levels[1].maxDistance);
+		Assert::IsTrue(std::isinf(group->levels[2].maxDistance));
+		Assert::AreEqual((size_t)3, table->getPoolSizes().size());
+	}
+
+	TEST_METHOD(TestIndicatorLodSelection)
+	{
+		IndicatorLodGroup group;
+		Assert::IsTrue(parseIndicatorLodGroup("S@2|M@10|L", &group));
+
+		Assert::AreEqual(0u, group.selectLevel(1500));
+		Assert::AreEqual(1u, group.selectLevel(2100));
+		Assert::AreEqual(2u, group.selectLevel(50000));
+
+		// within the hysteresis the current level is kept in both directions
+		Assert::AreEqual(0u, group.selectLevel(2100, 0));
+		Assert::AreEqual(1u, group.selectLevel(2300, 0));
+		Assert::AreEqual(1u, group.selectLevel(1900, 1));
+		Assert::AreEqual(0u, group.selectLevel(1700, 1));
+		Assert::AreEqual(2u, group.selectLevel(50000, 0));
+		Assert::AreEqual(0u, group.selectLevel(100, 2));
+
+		// the nearest swaps are kept
+		std::vector<IndicatorLodSwap> swaps = { { 1, 1, 3000 }, { 2, 0, 500 }, { 3, 2, 12000 }, { 4, 1, 2500 } };
+		Assert::AreEqual((size_t)2, limitIndicatorLodSwaps(swaps, 2));
+		Assert::IsTrue(swaps.size() == 2 && swaps[0].id == 2 && swaps[1].id == 4);
+		Assert::AreEqual((size_t)0, limitIndicatorLodSwaps(swaps, 2));
+	}
+
+	TEST_METHOD(TestIndicatorPool)
+	{
+		IndicatorPool pool;
+		std::vector<IndicatorPoolSize> sizes = { { "VFP_Circle_S", 2 }, { "VFP_Circle_M", 1 } };
+		pool.configure(sizes);
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		IndicatorPoolRefill refills[INDICATOR_POOL_REFILL_BATCH];
+
+		// nothing is created before the parking position is known
+		Assert::AreEqual((size_t)0, pool.getRefills(time, refills));
+		pool.setParkingPosition(51.36, 7.47);
+		Assert::AreEqual(INDICATOR_POOL_PARKING_ALTITUDE, pool.getParkingPosition().altitude);
+		Assert::AreEqual((size_t)3, pool.getRefills(time, refills));
+		Assert::AreEqual((size_t)0, pool.getRefills(time, refills));
+
+		// an empty pool is a miss, models without pool are not counted
+		Assert::AreEqual(0u, pool.claim("VFP_Circle_S"));
+		Assert::AreEqual(0u, pool.claim("VFP_Circle_L"));
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			Assert::IsTrue((refills[i].requestID & INDICATOR_POOL_REQUEST_FLAG) != 0);
+			Assert::IsTrue(pool.addCreated(refills[i].requestID, static_cast<uint>(100 + i)));
+		}
+		Assert::IsFalse(pool.addCreated(refills[0].requestID, 200));
+		Assert::IsFalse(pool.addCreated(INDICATOR_POOL_REQUEST_FLAG | 7, 201));
+
+		uint claimed = pool.claim("VFP_Circle_S");
+		Assert::IsTrue(claimed == 100 || claimed == 101);
+		Assert::AreEqual(1ull, pool.getStatistics()[0].hits);
+
+		// the claimed SimObject is replaced, returned SimObjects are kept up to the capacity
+		Assert::AreEqual((size_t)1, pool.getRefills(time, refills));
+		Assert::IsTrue(pool.release("VFP_Circle_S", claimed));
+		Assert::IsTrue(pool.release("VFP_Circle_S", 300));
+		Assert::IsTrue(pool.release("VFP_Circle_S", 301));
+		Assert::IsFalse(pool.release("VFP_Circle_S", 302));
+		Assert::IsFalse(pool.release("VFP_Circle_L", 303));
+
+		// lost create requests are given up after the timeout
+		Assert::AreEqual((size_t)0, pool.getRefills(time, refills));
+		Assert::AreEqual(1u, pool.getStatistics()[0].pending);
+		pool.getRefills(time + std::chrono::milliseconds(INDICATOR_POOL_CREATE_TIMEOUT + 1), refills);
+		Assert::AreEqual(0u, pool.getStatistics()[0].pending);
+
+		// smaller and removed pools hand out their surplus
+		sizes.resize(1);
+		sizes[0].size = 1;
+		pool.configure(sizes);
+		uint surplus[INDICATOR_POOL_REFILL_BATCH];
+		Assert::AreEqual((size_t)3, pool.takeSurplus(surplus));
+		Assert::AreEqual((size_t)0, pool.takeSurplus(surplus));
+
+		std::vector<IndicatorPoolStatistics> statistics = pool.getStatistics();
+		Assert::AreEqual((size_t)1, statistics.size());
+		Assert::IsTrue(statistics[0].modelName == "VFP_Circle_S" && statistics[0].parked == 2 && statistics[0].misses == 1 && statistics[0].returned == 3);
+
+		pool.clear();
+		Assert::AreEqual(0u, pool.claim("VFP_Circle_S"));
+	}
+
+	TEST_METHOD(TestObjectScheduler)
+	{
+		ObjectSchedulerConfiguration configuration;
+		Assert::IsTrue(parseObjectSchedulerConfiguration("50:10", &configuration));
+		Assert::IsTrue(configuration.rate == 50 && configuration.burst == 10);
+		Assert::IsTrue(parseObjectSchedulerConfiguration("0", &configuration));
+		Assert::IsTrue(configuration.rate == 0 && configuration.burst == OBJECT_SCHEDULER_DEFAULT_BURST);
+		Assert::IsFalse(parseObjectSchedulerConfiguration("-1", &configuration));
+		Assert::IsFalse(parseObjectSchedulerConfiguration("50:0", &configuration));
+		Assert::IsFalse(parseObjectSchedulerConfiguration("fast", &configuration));
+
+		// 10 operations per second, at most 5 at once
+		ObjectScheduler scheduler;
+		scheduler.configure(ObjectSchedulerConfiguration{ 10, 5 });
+		Assert::IsTrue(scheduler.isEnabled());
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+		// indicators every km north of the aircraft, requested from the farthest to the nearest
+		Assert::IsTrue(scheduler.scheduleCreate(10, 1010, 51.36 + 10 / 111.0, 7.47, time));
+		for (ushort id = 9; id >= 1; id--)
+		{
+			Assert::IsFalse(scheduler.scheduleCreate(id, 1000 + id, 51.36 + id / 111.0, 7.47, time));
+		}
+		scheduler.scheduleRemove(500, time);
+		scheduler.scheduleRemove(501, time);
+		Assert::AreEqual((size_t)0, scheduler.acquire(1, time));
+
+		// the removals come first, then the nearest creations
+		std::vector<uint> removes;
+		std::vector<ScheduledCreate> creates;
+		scheduler.takeDue(time, 51.36, 7.47, true, removes, creates);
+		Assert::IsTrue(removes == std::vector<uint>{ 500, 501 });
+		Assert::AreEqual((size_t)3, creates.size());
+		for (size_t i = 0; i < creates.size(); i++)
+		{
+			Assert::AreEqual((ushort)(i + 1), creates[i].id);
+			Assert::AreEqual(1000u + creates[i].id, creates[i].requestID);
+		}
+
+		// the bucket is empty, the next token is available after 100 ms
+		removes.clear();
+		creates.clear();
+		scheduler.takeDue(time, 51.36, 7.47, true, removes, creates);
+		Assert::IsTrue(removes.empty() && creates.empty());
+		Assert::AreEqual(100u, scheduler.getWaitTimeout(time, 1000u));
+
+		// a canceled creation is skipped, a moved one is ordered by its new position, a new request keeps the place in the queue
+		Assert::IsTrue(scheduler.cancelCreate(4));
+		Assert::IsFalse(scheduler.cancelCreate(4));
+		scheduler.updateCreate(10, 51.36, 7.47);
+		Assert::IsFalse(scheduler.scheduleCreate(5, 2005, 51.36 + 5 / 111.0, 7.47, time));
+		time += std::chrono::milliseconds(200);
+		scheduler.takeDue(time, 51.36, 7.47, true, removes, creates);
+		Assert::AreEqual((size_t)2, creates.size());
+		Assert::AreEqual((ushort)10, creates[0].id);
+		Assert::AreEqual((ushort)5, creates[1].id);
+		Assert::AreEqual(2005u, creates[1].requestID);
+
+		ObjectSchedulerStatistics statistics = scheduler.getStatistics();
+		Assert::AreEqual((size_t)4, statistics.queuedCreates);
+		Assert::AreEqual((size_t)0, statistics.queuedRemoves);
+		Assert::AreEqual((size_t)12, statistics.maxQueueDepth);
+		Assert::AreEqual(5ull, statistics.creates);
+		Assert::AreEqual(2ull, statistics.removes);
+		Assert::AreEqual(1ull, statistics.canceled);
+		Assert::AreEqual(200000ull, statistics.maxWait);
+
+		// without pacing everything which is waiting is taken, in the order of the requests without aircraft position
+		scheduler.configure(ObjectSchedulerConfiguration{ 0, 5 });
+		Assert::IsFalse(scheduler.isEnabled());
+		creates.clear();
+		scheduler.takeDue(time, 0, 0, false, removes, creates);
+		Assert::AreEqual((size_t)4, creates.size());
+		Assert::AreEqual((ushort)9, creates[0].id);
+		Assert::AreEqual((ushort)6, creates[3].id);
+		Assert::AreEqual((size_t)16, scheduler.acquire(16, time));
+		Assert::AreEqual(1000u, scheduler.getWaitTimeout(time, 1000u));
+	}
+
+	TEST_METHOD(TestIndicatorGridMatchesLinearSearch)
+	{
+		IndicatorGrid grid;
+		std::mt19937 random(7);
+		std::uniform_real_distribution<double> offset(-0.5, 0.5);
+		std::vector<std::pair<double, double>> positions(20000);
+
+		// clusters around Hagen, the antimeridian and close to the north pole
+		const double centers[3][2] = { { 51.36, 7.47 }, { -17.0, 179.9 }, { 88.9, 20.0 } };
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			positions[i] = { centers[i % 3][0] + offset(random), centers[i % 3][1] + offset(random) };
+			if (positions[i].second > 180.0)
+			{
+				positions[i].second -= 360.0;
+			}
+			grid.update(static_cast<ushort>(i), 0, 0);
+			grid.update(static_cast<ushort>(i), positions[i].first, positions[i].second);
+		}
+		for (ushort id = 0; id < 1000; id++)
+		{
+			Assert::IsTrue(grid.remove(id));
+		}
+		Assert::IsFalse(grid.remove(0));
+		Assert::AreEqual((size_t)19000, grid.size());
+
+		for (const double* center : centers)
+		{
+			std::vector<IndicatorDistance> result;
+			grid.query(center[0], center[1], 20000, result);
+
+			std::unordered_set<ushort> expected;
+			for (size_t i = 1000; i < positions.size(); i++)
+			{
+				if (getGreatCircleDistance(center[0], center[1], positions[i].first, positions[i].second) <= 20000)
+				{
+					expected.insert(static_cast<ushort>(i));
+				}
+			}
+
+			Assert::IsFalse(expected.empty());
+			Assert::AreEqual(expected.size(), result.size());
+			for (const IndicatorDistance& found : result)
+			{
+				Assert::IsTrue(expected.count(found.id) == 1);
+			}
+		}
+
+		grid.clear();
+		Assert::AreEqual((size_t)0, grid.size());
+		Assert::IsFalse(grid.contains(1500));
+	}
+
+	TEST_METHOD(TestIndicatorVirtualizer)
+	{
+		VirtualizationConfiguration configuration;
+		Assert::IsTrue(parseVirtualizationConfiguration("20", &configuration));
+		Assert::IsTrue(configuration.radius == 20000 && configuration.maxCount == 0);
+		Assert::IsTrue(parseVirtualizationConfiguration("2.5:100", &configuration));
+		Assert::IsTrue(configuration.radius == 2500 && configuration.maxCount == 100);
+		Assert::IsFalse(parseVirtualizationConfiguration("0", &configuration));
+		Assert::IsFalse(parseVirtualizationConfiguration("20:0", &configuration));
+		Assert::IsFalse(parseVirtualizationConfiguration("20:", &configuration));
+
+		// 200 indicators in a row to the north, 100 m apart
+		IndicatorGrid grid;
+		for (ushort id = 0; id < 200; id++)
+		{
+			grid.update(id, 51.0 + id * 100.0 / 111195.0, 7.0);
+		}
+
+		IndicatorVirtualizer virtualizer;
+		Assert::IsTrue(virtualizer.isInRange(60.0, 7.0));
+		configuration.radius = 5000;
+		configuration.maxCount = 40;
+		virtualizer.configure(configuration);
+		Assert::IsFalse(virtualizer.isInRange(51.0, 7.0));
+
+		// the nearest indicators are materialized first, limited by the maximum count
+		std::vector<ushort> materialize;
+		std::vector<ushort> retire;
+		virtualizer.update(grid, 51.0, 7.0, materialize, retire);
+		Assert::AreEqual((size_t)40, materialize.size());
+		Assert::IsTrue(materialize[0] == 0 && materialize[1] == 1 && retire.empty());
+		for (ushort id : materialize)
+		{
+			virtualizer.markResident(id);
+		}
+		Assert::IsFalse(virtualizer.isInRange(51.0, 7.0));
+
+		// after flying 2 km north the indicators behind are pushed out by the maximum count
+		materialize.clear();
+		virtualizer.update(grid, 51.0 + 2000.0 / 111195.0, 7.0, materialize, retire);
+		Assert::AreEqual(materialize.size(), retire.size());
+		for (ushort id : retire)
+		{
+			Assert::IsTrue(id < 40);
+			virtualizer.markVirtual(id);
+		}
+		for (ushort id : materialize)
+		{
+			Assert::IsTrue(id >= 40);
+			virtualizer.markResident(id);
+		}
+
+		// far away, everything is retired
+		materialize.clear();
+		retire.clear();
+		virtualizer.update(grid, 40.0, 7.0, materialize, retire);
+		Assert::IsTrue(materialize.empty());
+		Assert::AreEqual((size_t)40, retire.size());
+
+		VirtualizationStatistics statistics = virtualizer.getStatistics(grid);
+		Assert::IsTrue(statistics.updates == 3 && statistics.total == 200 && statistics.resident == 40);
+		virtualizer.clearResidents();
+		Assert::AreEqual((size_t)0, virtualizer.getStatistics(grid).resident);
+	}
+
+	TEST_METHOD(TestIndicatorRegistryStateTransitions)
+	{
+		IndicatorRegistry registry;
+		uint removedObject;
+
+		IndicatorCreateRequest first = registry.beginCreate(7);
+		Assert::IsTrue((first.requestID & INDICATOR_CREATE_REQUEST_FLAG) != 0);
+		Assert::IsTrue(first.previousSimObjectID == 0);
+		Assert::IsTrue(registry.getState(7) == INDICATOR_SLOT_PENDING);
+		Assert::IsTrue(registry.getSimObject(7) == 0);
+
+		Assert::IsTrue(registry.assignSimObject(first.requestID, 500) == INDICATOR_ASSIGN_OK);
+		Assert::IsTrue(registry.getSimObject(7) == 500);
+
+		// replacing an active indicator returns its SimObject
+		IndicatorCreateRequest second = registry.beginCreate(7);
+		Assert::IsTrue(second.previousSimObjectID == 500);
+		Assert::IsTrue(second.requestID != first.requestID);
+
+		// replacing a pending indicator makes the first request outdated
+		IndicatorCreateRequest third = registry.beginCreate(7);
+		Assert::IsTrue(third.previousSimObjectID == 0);
+		Assert::IsTrue(registry.assignSimObject(second.requestID, 501) == INDICATOR_ASSIGN_STALE);
+		Assert::IsTrue(registry.assignSimObject(third.requestID, 502) == INDICATOR_ASSIGN_OK);
+
+		Assert::IsTrue(registry.remove(7, removedObject));
+		Assert::IsTrue(removedObject == 502);
+		Assert::IsFalse(registry.remove(7, removedObject));
+
+		// removing a pending indicator makes its request outdated
+		IndicatorCreateRequest fourth = registry.beginCreate(65535);
+		Assert::IsTrue(registry.remove(65535, removedObject));
+		Assert::IsTrue(removedObject == 0);
+		Assert::IsTrue(registry.assignSimObject(fourth.requestID, 503) == INDICATOR_ASSIGN_STALE);
+
+		Assert::IsTrue(registry.assignSimObject(1000, 504) == INDICATOR_ASSIGN_UNKNOWN);
+		Assert::IsTrue(registry.getStatistics().staleAssignments == 2);
+		Assert::IsTrue(registry.getUsedIndicatorIDs().empty());
+	}
+
+	TEST_METHOD(TestIndicatorRegistryConcurrentTraffic)
+	{
+		const int commandThreads = 4;
+		const int assignThreads = 2;
+		const int operationsPerThread = 20000;
+		const ushort indicatorCount = 64;
+
+		IndicatorRegistry registry;
+		std::mutex pendingMutex;
+		std::vector<uint> pendingRequests;
+		std::atomic<uint> nextSimObjectID{ 1 };
+		std::atomic<uint> createdObjects{ 0 };
+		std::atomic<uint> removedObjects{ 0 };
+		std::atomic<int> runningCommandThreads{ commandThreads };
+
+		// every SimObject has to be either active in exactly one slot or removed exactly once
+		auto assignPending = [&](bool untilEmpty)
+		{
+			while (true)
+			{
+				uint requestID;
+				{
+					std::scoped_lock lk(pendingMutex);
+					if (pendingRequests.empty())
+					{
+						if (untilEmpty || runningCommandThreads == 0)
+						{
+							return;
+						}
+						continue;
+					}
+					requestID = pendingRequests.back();
+					pendingRequests.pop_back();
+				}
+
+				uint simObjectID = nextSimObjectID.fetch_add(1);
+				createdObjects++;
+				if (registry.assignSimObject(requestID, simObjectID) == INDICATOR_ASSIGN_STALE)
+				{
+					removedObjects++;
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < commandThreads; t++)
+		{
+			threads.emplace_back([&, t]
+			{
+				std::mt19937 random(t);
+				for (int i = 0; i < operationsPerThread; i++)
+				{
+					ushort id = static_cast<ushort>(random() % indicatorCount);
+					if (random() % 3 != 0)
+					{
+						IndicatorCreateRequest request = registry.beginCreate(id);
+						if (request.previousSimObjectID != 0)
+						{
+							removedObjects++;
+						}
+						std::scoped_lock lk(pendingMutex);
+						pendingRequests.push_back(request.requestID);
+					}
+					else
+					{
+						uint simObjectID;
+						if (registry.remove(id, simObjectID) && simObjectID != 0)
+						{
+							removedObjects++;
+						}
+					}
+				}
+				runningCommandThreads--;
+			});
+		}
+		for (int t = 0; t < assignThreads; t++)
+		{
+			threads.emplace_back([&] { assignPending(false); });
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		assignPending(true);
+
+		std::unordered_set<uint> activeObjects;
+		for (ushort id = 0; id < indicatorCount; id++)
+		{
+			Assert::IsTrue(registry.getState(id) != INDICATOR_SLOT_PENDING || registry.getSimObject(id) == 0);
+			uint simObjectID = registry.getSimObject(id);
+			if (simObjectID != 0)
+			{
+				Assert::IsTrue(activeObjects.insert(simObjectID).second);
+			}
+		}
+
+		Assert::IsTrue(createdObjects.load() == removedObjects.load() + activeObjects.size());
+		Assert::IsTrue(registry.getStatistics().active == activeObjects.size());
+	}
+
+	TEST_METHOD(TestFakeSimBackendIsDeterministic)
+	{
+		FakeSimBackendConfiguration configuration;
+		configuration.latency = 0;
+		configuration.jitter = 0;
+		configuration.failureRate = 0.5;
+		configuration.objectCap = 3;
+		configuration.frameRate = 0;
+		configuration.seed = 42;
+
+		// two instances with the same seed report the same events
+		std::vector<std::vector<uint>> reported;
+		for (int run = 0; run < 2; run++)
+		{
+			FakeSimBackend backend(configuration);
+			WorldPositionStruct position{};
+			SimEvent event;
+			std::vector<uint> events;
+
+			Assert::IsTrue(backend.open());
+			Assert::IsTrue(backend.getNextEvent(event));
+			Assert::IsTrue(event.type == SIM_EVENT_RUNNING_STATE && event.isRunning);
+
+			for (uint requestID = 1; requestID <= 10; requestID++)
+			{
+				backend.createObject("VFP_Circle_S", position, requestID);
+			}
+			while (backend.getNextEvent(event))
+			{
+				events.push_back(event.type == SIM_EVENT_OBJECT_ASSIGNED ? event.requestID : 0);
+			}
+
+			FakeSimBackendStatistics statistics = backend.getStatistics();
+			Assert::IsTrue(events.size() == 10);
+			Assert::IsTrue(statistics.created + statistics.failed == 10);
+			Assert::IsTrue(statistics.existing <= 3);
+
+			// the connection is lost together with all SimObjects
+			backend.simulateQuit();
+			Assert::IsTrue(backend.getNextEvent(event));
+			Assert::IsTrue(event.type == SIM_EVENT_QUIT);
+			Assert::IsTrue(backend.getStatistics().existing == 0);
+			Assert::IsFalse(backend.createObject("VFP_Circle_S", position, 11));
+
+			reported.push_back(events);
+		}
+
+		Assert::IsTrue(reported[0] == reported[1]);
+	}
+
+	TEST_METHOD(TestIndicatorMove)
+	{
+		WorldPositionStruct position{ 51.36, 7.47, 3000.0, 359.99, 0, 0 };
+
+		// differences below the tolerance do not move the indicator
+		WorldPositionStruct other = position;
+		other.latitude += 0.0000001;
+		other.altitude += 0.1;
+		other.heading = 0.01;
+		Assert::IsTrue(isSamePosition(position, other));
+
+		other = position;
+		other.longitude += 0.00001;
+		Assert::IsFalse(isSamePosition(position, other));
+		other = position;
+		other.altitude += 1.0;
+		Assert::IsFalse(isSamePosition(position, other));
+		other = position;
+		other.pitch = 1.0;
+		Assert::IsFalse(isSamePosition(position, other));
+
+		// only existing SimObjects can be moved
+		FakeSimBackendConfiguration configuration;
+		configuration.latency = 0;
+		configuration.frameRate = 0;
+		FakeSimBackend backend(configuration);
+		SimEvent event;
+
+		Assert::IsFalse(backend.moveObject(1, position));
+		Assert::IsTrue(backend.open());
+		Assert::IsTrue(backend.getNextEvent(event));
+		Assert::IsTrue(backend.createObject("VFP_Circle_S", position, 1));
+		Assert::IsTrue(backend.getNextEvent(event));
+		Assert::IsTrue(event.type == SIM_EVENT_OBJECT_ASSIGNED);
+
+		Assert::IsTrue(backend.moveObject(event.objectID, other));
+		Assert::IsTrue(backend.moveObject(event.objectID + 1, other));
+		Assert::IsTrue(backend.getNextEvent(event));
+		Assert::IsTrue(event.type == SIM_EVENT_EXCEPTION && event.exception == FAKE_SIM_EXCEPTION_UNKNOWN_OBJECT);
+
+		FakeSimBackendStatistics statistics = backend.getStatistics();
+		Assert::AreEqual(1ull, statistics.created);
+		Assert::AreEqual(1ull, statistics.moved);
+		Assert::AreEqual((size_t)1, statistics.existing);
+	}
+
+	TEST_METHOD(TestTelemetryConfiguration)
+	{
+		TelemetryConfiguration configuration;
+
+		Assert::IsTrue(parseTelemetryConfiguration("sim-frame", &configuration));
+		Assert::IsTrue(configuration.period == TELEMETRY_PERIOD_SIM_FRAME && configuration.periodCount == 1 && configuration.rate == 0);
+
+		Assert::IsTrue(parseTelemetryConfiguration("visual-frame:3", &configuration));
+		Assert::IsTrue(configuration.period == TELEMETRY_PERIOD_VISUAL_FRAME && configuration.periodCount == 3);
+		Assert::IsTrue(toString(configuration) == "visual-frame:3");
+
+		Assert::IsTrue(parseTelemetryConfiguration("30hz", &configuration));
+		Assert::IsTrue(configuration.period == TELEMETRY_PERIOD_SIM_FRAME && configuration.rate == 30);
+		Assert::IsTrue(toString(configuration) == "30hz");
+
+		Assert::IsTrue(parseTelemetryConfiguration("second", &configuration));
+		Assert::IsTrue(toString(configuration) == "second");
+		Assert::IsFalse(configuration.adaptive);
+
+		Assert::IsTrue(parseTelemetryConfiguration("adaptive:sim-frame", &configuration));
+		Assert::IsTrue(configuration.adaptive && configuration.period == TELEMETRY_PERIOD_SIM_FRAME);
+		Assert::IsTrue(toString(configuration) == "adaptive:sim-frame");
+		Assert::IsFalse(parseTelemetryConfiguration("adaptive:", &configuration));
+		Assert::IsTrue(parseTelemetryConfiguration("second", &configuration));
+
+		// invalid values keep the previous configuration
+		Assert::IsFalse(parseTelemetryConfiguration("sim-frame:0", &configuration));
+		Assert::IsFalse(parseTelemetryConfiguration("sim-frame:", &configuration));
+		Assert::IsFalse(parseTelemetryConfiguration("0hz", &configuration));
+		Assert::IsFalse(parseTelemetryConfiguration("hz", &configuration));
+		Assert::IsFalse(parseTelemetryConfiguration("frame", &configuration));
+		Assert::IsTrue(configuration.period == TELEMETRY_PERIOD_SECOND);
+	}
+
+	TEST_METHOD(TestTelemetryController)
+	{
+		TelemetryController controller;
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+		// straight flight north with 120 kts, the position follows the extrapolation
+		AircraftStateStruct state{};
+		state.latitude = 51.0;
+		state.longitude = 7.0;
+		state.altitude = 3000;
+		state.speed = 120;
+		double latitudePerFrame = 120 * 1852.0 / 3600.0 / 60.0 / 111195.0;
+
+		Assert::IsTrue(controller.shouldSend(state, time));
+		for (int i = 0; i < 30; i++)
+		{
+			time += std::chrono::microseconds(16667);
+			state.latitude += latitudePerFrame;
+			Assert::IsFalse(controller.shouldSend(state, time));
+		}
+
+		// a turn exceeds the attitude dead-band
+		time += std::chrono::microseconds(16667);
+		state.latitude += latitudePerFrame;
+		state.bank = 5;
+		Assert::IsTrue(controller.shouldSend(state, time));
+
+		// a climb exceeds the altitude dead-band
+		time += std::chrono::microseconds(16667);
+		state.latitude += latitudePerFrame;
+		state.altitude += 20;
+		Assert::IsTrue(controller.shouldSend(state, time));
+
+		// while paused only the keep alive is sent
+		controller.setPaused(true);
+		time += std::chrono::milliseconds(500);
+		state.heading = 90;
+		Assert::IsFalse(controller.shouldSend(state, time));
+		Assert::IsFalse(controller.isKeepAliveDue(time));
+		time += std::chrono::milliseconds(600);
+		Assert::IsTrue(controller.shouldSend(state, time));
+
+		// without new states the keep alive is due after the interval
+		controller.setPaused(false);
+		Assert::IsFalse(controller.isKeepAliveDue(time + std::chrono::milliseconds(999)));
+		Assert::IsTrue(controller.isKeepAliveDue(time + std::chrono::milliseconds(1000)));
+
+		TelemetryControllerStatistics statistics = controller.getStatistics();
+		Assert::AreEqual(3ull, statistics.sent);
+		Assert::AreEqual(31ull, statistics.suppressed);
+		Assert::AreEqual(2ull, statistics.keepAlive);
+
+		// after a reset the next state is sent
+		controller.reset();
+		Assert::IsTrue(controller.shouldSend(state, time));
+	}
+
+	TEST_METHOD(TestTelemetryFormatRoundTrip)
+	{
+		TelemetryEncoder encoder(TELEMETRY_FORMAT_V1);
+		TelemetryDecoder decoder;
+		TelemetryFrame frame;
+		char buffer[TELEMETRY_MAX_MESSAGE_LENGTH];
+
+		// version 1 is lossless
+		AircraftStateStruct state{};
+		state.latitude = 51.3612345;
+		state.longitude = 179.9999;
+		state.altitude = 3012.5;
+		state.heading = 359.9;
+		state.bank = -12.5;
+		state.pitch = 3.25;
+		state.speed = 121.5;
+
+		Assert::AreEqual((uint)TELEMETRY_V1_MESSAGE_LENGTH, encoder.encode(state, 1, buffer));
+		Assert::IsTrue(decoder.decode(buffer, TELEMETRY_V1_MESSAGE_LENGTH, frame));
+		Assert::IsTrue(frame.format == TELEMETRY_FORMAT_V1);
+		Assert::IsTrue(std::memcmp(&frame.state, &state, sizeof(state)) == 0);
+
+		// version 2: a keyframe followed by delta frames, the flight crosses the antimeridian and heading 0
+		encoder.setFormat(TELEMETRY_FORMAT_V2);
+		for (uint i = 0; i < 2 * TELEMETRY_KEYFRAME_INTERVAL + 2; i++)
+		{
+			uint length = encoder.encode(state, 1000 + i * 16667ull, buffer);
+			bool isKeyframe = i % (TELEMETRY_KEYFRAME_INTERVAL + 1) == 0;
+			Assert::AreEqual((uint)(isKeyframe ? TELEMETRY_V2_KEYFRAME_LENGTH : TELEMETRY_V2_DELTA_LENGTH), length);
+
+			Assert::IsTrue(decoder.decode(buffer, length, frame));
+			Assert::IsTrue(frame.format == TELEMETRY_FORMAT_V2);
+			Assert::IsTrue(frame.type == (isKeyframe ? TELEMETRY_FRAME_KEY : TELEMETRY_FRAME_DELTA));
+			Assert::AreEqual(i, frame.sequence);
+			Assert::AreEqual(1000 + i * 16667ull, frame.timestamp);
+			Assert::AreEqual(state.latitude, frame.state.latitude, 1e-6);
+			Assert::AreEqual(0, getAngleDifference(state.longitude, frame.state.longitude), 1e-6);
+			Assert::AreEqual(state.altitude, frame.state.altitude, 0.1);
+			Assert::AreEqual(0, getAngleDifference(state.heading, frame.state.heading), 0.01);
+			Assert::AreEqual(state.bank, frame.state.bank, 0.01);
+			Assert::AreEqual(state.pitch, frame.state.pitch, 0.01);
+			Assert::AreEqual(state.speed, frame.state.speed, 0.01);
+
+			state.latitude += 0.00001;
+			state.longitude += 0.00001;
+			if (state.longitude >= 180)
+			{
+				state.longitude -= 360;
+			}
+			state.altitude += 1.3;
+			state.heading = std::fmod(state.heading + 0.05, 360.0);
+			state.bank += 0.2;
+			state.speed += 0.1;
+		}
+
+		// a jump which does not fit into a delta frame is sent as keyframe
+		state.latitude += 1;
+		Assert::AreEqual((uint)TELEMETRY_V2_KEYFRAME_LENGTH, encoder.encode(state, 0, buffer));
+		Assert::IsTrue(decoder.decode(buffer, TELEMETRY_V2_KEYFRAME_LENGTH, frame));
+		Assert::AreEqual(state.latitude, frame.state.latitude, 1e-6);
+
+		// delta frames of a lost keyframe are rejected
+		TelemetryDecoder lateDecoder;
+		uint length = encoder.encode(state, 0, buffer);
+		Assert::AreEqual((uint)TELEMETRY_V2_DELTA_LENGTH, length);
+		Assert::IsFalse(lateDecoder.decode(buffer, length, frame));
+		Assert::IsTrue(decoder.decode(buffer, length, frame));
+		Assert::IsFalse(decoder.decode(buffer, length - 1, frame));
+	}
+
+	TEST_METHOD(TestTelemetrySubscriberRegistry)
+	{
+		TelemetrySubscriberRegistry registry;
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		AircraftStateStruct state{};
+		state.latitude = 51.0;
+		state.longitude = 7.0;
+
+		Assert::IsTrue(SUBSCRIBE_ADDED == registry.subscribe(0x7F000001, 10988, TELEMETRY_FORMAT_V1, 0, true, time));
+		Assert::IsTrue(SUBSCRIBE_ADDED == registry.subscribe(0x7F000001, 5000, TELEMETRY_FORMAT_V2, 10, false, time));
+		Assert::IsTrue(SUBSCRIBE_ADDED == registry.subscribe(0x7F000002, 5000, TELEMETRY_FORMAT_V2, 10, false, time));
+		Assert::IsTrue(SUBSCRIBE_RENEWED == registry.subscribe(0x7F000002, 5000, TELEMETRY_FORMAT_V2, 10, false, time));
+
+		// one second with 60 states: the target receives all of them, the 10 Hz subscribers share one message
+		uint sentToTarget = 0;
+		uint sentToSubscribers = 0;
+		for (int i = 0; i < 60; i++)
+		{
+			std::span<const UDPDatagram> datagrams = registry.publish(state, time + std::chrono::microseconds(i * 16667), i);
+			for (const UDPDatagram& datagram : datagrams)
+			{
+				if (datagram.port == 10988)
+				{
+					Assert::AreEqual((uint)TELEMETRY_V1_MESSAGE_LENGTH, datagram.length);
+					sentToTarget++;
+				}
+				else
+				{
+					Assert::IsTrue(datagram.data == datagrams.back().data);
+					sentToSubscribers++;
+				}
+			}
+			state.latitude += 0.00001;
+		}
+		Assert::AreEqual(60u, sentToTarget);
+		Assert::AreEqual(22u, sentToSubscribers); // at 0, 83, 183, ... 983 ms
+
+		// events are only sent to version 2 subscribers, the version 1 target receives no datagram
+		char event[TELEMETRY_V2_GATE_EVENT_LENGTH] = {};
+		std::span<const UDPDatagram> eventDatagrams = registry.publishEvent(event, sizeof(event));
+		Assert::AreEqual((size_t)2, eventDatagrams.size());
+		for (const UDPDatagram& datagram : eventDatagrams)
+		{
+			Assert::IsTrue(datagram.port == 5000);
+			Assert::IsTrue(datagram.data == event);
+		}
+
+		// unknown subscribers and the maximum number of subscribers
+		Assert::IsFalse(registry.unsubscribe(0x7F000003, 5000));
+		for (uint i = 0; i < TELEMETRY_MAX_SUBSCRIBERS - 3; i++)
+		{
+			Assert::IsTrue(SUBSCRIBE_ADDED == registry.subscribe(0x0A000000 + i, 5000, TELEMETRY_FORMAT_V1, 1, false, time));
+		}
+		Assert::IsTrue(SUBSCRIBE_FULL == registry.subscribe(0x7F000003, 5000, TELEMETRY_FORMAT_V1, 0, false, time));
+		Assert::IsTrue(registry.unsubscribe(0x7F000002, 5000));
+		Assert::AreEqual((size_t)TELEMETRY_MAX_SUBSCRIBERS - 1, registry.getStatistics().size());
+
+		// only the subscribers which did not renew their subscription expire
+		time += std::chrono::milliseconds(TELEMETRY_SUBSCRIPTION_TIMEOUT - 1000);
+		Assert::IsTrue(registry.setFormat(0x7F000001, 5000, TELEMETRY_FORMAT_V1));
+		Assert::IsTrue(SUBSCRIBE_RENEWED == registry.subscribe(0x7F000001, 5000, TELEMETRY_FORMAT_V1, 10, false, time));
+		Assert::AreEqual((size_t)0, registry.removeExpiredSubscribers(time).size());
+		Assert::AreEqual((size_t)TELEMETRY_MAX_SUBSCRIBERS - 3, registry.removeExpiredSubscribers(time + std::chrono::milliseconds(1000)).size());
+
+		std::vector<TelemetrySubscriberStatistics> statistics = registry.getStatistics();
+		Assert::AreEqual((size_t)2, statistics.size());
+		Assert::IsTrue(statistics[0].isPermanent && statistics[0].sent == 60);
+		Assert::IsTrue(statistics[1].format == TELEMETRY_FORMAT_V1 && statistics[1].sent == 11);
+	}
+
+	TEST_METHOD(TestRingBufferFifoOrder)
+	{
+		RingBuffer<std::string> buffer(4, BLOCK);
+		std::string item;
+		Assert::IsFalse(buffer.pop(item));
+
+		// several rounds, so the positions wrap around the slots
+		for (int round = 0; round < 5; round++)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				Assert::IsTrue(buffer.push("element " + std::to_string(round * 3 + i)));
+			}
+			for (int i = 0; i < 3; i++)
+			{
+				Assert::IsTrue(buffer.pop(item));
+				Assert::AreEqual("element " + std::to_string(round * 3 + i), item);
+			}
+			Assert::IsFalse(buffer.pop(item));
+		}
+
+		RingBufferStatistics statistics = buffer.getStatistics();
+		Assert::AreEqual(15ull, statistics.enqueued);
+		Assert::AreEqual(0ull, statistics.dropped);
+		Assert::AreEqual((size_t)3, statistics.highWaterMark);
+		Assert::AreEqual((size_t)0, statistics.size);
+		Assert::AreEqual((size_t)4, statistics.capacity);
+	}
+
+	TEST_METHOD(TestRingBufferDropNewest)
+	{
+		RingBuffer<int> buffer(4, DROP_NEWEST);
+		for (int i = 0; i < 4; i++)
+		{
+			Assert::IsTrue(buffer.push(int(i)));
+		}
+		Assert::IsFalse(buffer.push(4));
+		Assert::IsFalse(buffer.push(5));
+
+		RingBufferStatistics statistics = buffer.getStatistics();
+		Assert::AreEqual(4ull, statistics.enqueued);
+		Assert::AreEqual(2ull, statistics.dropped);
+		Assert::AreEqual((size_t)4, statistics.highWaterMark);
+		Assert::AreEqual((size_t)4, statistics.size);
+
+		// the elements which were accepted are kept
+		int item;
+		for (int expected = 0; expected < 4; expected++)
+		{
+			Assert::IsTrue(buffer.pop(item));
+			Assert::AreEqual(expected, item);
+		}
+		Assert::IsFalse(buffer.pop(item));
+	}
+
+	TEST_METHOD(TestRingBufferDropOldest)
+	{
+		RingBuffer<int> buffer(4, DROP_OLDEST);
+		for (int i = 0; i < 10; i++)
+		{
+			Assert::IsTrue(buffer.push(int(i)));
+		}
+
+		// every push into the full buffer drops exactly one element
+		RingBufferStatistics statistics = buffer.getStatistics();
+		Assert::AreEqual(10ull, statistics.enqueued);
+		Assert::AreEqual(6ull, statistics.dropped);
+		Assert::AreEqual((size_t)4, statistics.highWaterMark);
+		Assert::AreEqual((size_t)4, statistics.size);
+
+		int item;
+		for (int expected = 6; expected < 10; expected++)
+		{
+			Assert::IsTrue(buffer.pop(item));
+			Assert::AreEqual(expected, item);
+		}
+		Assert::IsFalse(buffer.pop(item));
+	}
+
+	TEST_METHOD(TestRingBufferBlock)
+	{
+		RingBuffer<int> buffer(2, BLOCK);
+		Assert::IsTrue(buffer.push(0));
+		Assert::IsTrue(buffer.push(1));
+
+		// the producer waits until the consumer has made room, nothing is dropped
+		std::atomic_bool pushed = false;
+		std::thread producer([&buffer, &pushed] {
+			pushed = buffer.push(2);
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		Assert::IsFalse(pushed);
+
+		int item;
+		Assert::IsTrue(buffer.pop(item));
+		Assert::AreEqual(0, item);
+		producer.join();
+		Assert::IsTrue(pushed);
+
+		Assert::IsTrue(buffer.pop(item));
+		Assert::AreEqual(1, item);
+		Assert::IsTrue(buffer.pop(item));
+		Assert::AreEqual(2, item);
+		Assert::AreEqual(0ull, buffer.getStatistics().dropped);
+	}
+
+	TEST_METHOD(TestRingBufferClose)
+	{
+		RingBuffer<int> buffer(1, BLOCK);
+		Assert::AreEqual((size_t)RING_BUFFER_MIN_CAPACITY, buffer.getStatistics().capacity);
+
+		// a waiting consumer returns when the buffer is closed
+		std::thread closer([&buffer] {
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			buffer.close();
+		});
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Assert::IsFalse(buffer.waitForData(std::chrono::seconds(10)));
+		Assert::IsTrue(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+		closer.join();
+
+		Assert::IsTrue(buffer.isClosed());
+		Assert::IsFalse(buffer.push(1));
+
+		// a blocked producer returns as well and the element which was already queued can still be taken
+		RingBuffer<int> fullBuffer(2, BLOCK);
+		Assert::IsTrue(fullBuffer.push(1));
+		Assert::IsTrue(fullBuffer.push(2));
+		std::atomic_bool pushed = true;
+		std::thread producer([&fullBuffer, &pushed] {
+			pushed = fullBuffer.push(3);
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		fullBuffer.close();
+		producer.join();
+		Assert::IsFalse(pushed);
+
+		int item;
+		Assert::IsTrue(fullBuffer.pop(item));
+		Assert::AreEqual(1, item);
+		Assert::IsTrue(fullBuffer.pop(item));
+		Assert::AreEqual(2, item);
+		Assert::IsFalse(fullBuffer.pop(item));
+	}
+
+	TEST_METHOD(TestRingBufferConcurrentProducerAndConsumer)
+	{
+		const int count = 200000;
+
+		// with BLOCK every element arrives in order
+		RingBuffer<int> blockingBuffer(64, BLOCK);
+		std::thread producer([&blockingBuffer, count] {
+			for (int i = 0; i < count; i++)
+			{
+				blockingBuffer.push(int(i));
+			}
+		});
+		int expected = 0;
+		while (expected < count)
+		{
+			if (blockingBuffer.waitForData(std::chrono::milliseconds(100)))
+			{
+				while (blockingBuffer.consume([&expected](int& item) {
+					if (item != expected)
+					{
+						Assert::Fail(L"Element out of order");
+					}
+					expected++;
+				}))
+				{
+				}
+			}
+		}
+		producer.join();
+		Assert::AreEqual((unsigned long long)count, blockingBuffer.getStatistics().enqueued);
+
+		// with DROP_OLDEST elements may be lost, but the order is kept and every element is either taken or dropped
+		RingBuffer<int> droppingBuffer(64, DROP_OLDEST);
+		std::atomic_bool done = false;
+		std::thread droppingProducer([&droppingBuffer, &done, count] {
+			for (int i = 0; i < count; i++)
+			{
+				droppingBuffer.push(int(i));
+			}
+			done = true;
+		});
+		int last = -1;
+		unsigned long long taken = 0;
+		bool ordered = true;
+		while (!done || droppingBuffer.getStatistics().size != 0)
+		{
+			int item;
+			while (droppingBuffer.pop(item))
+			{
+				ordered = ordered && item > last;
+				last = item;
+				taken++;
+			}
+		}
+		droppingProducer.join();
+
+		RingBufferStatistics statistics = droppingBuffer.getStatistics();
+		Assert::IsTrue(ordered);
+		Assert::AreEqual(count - 1, last);
+		Assert::AreEqual((unsigned long long)count, taken + statistics.dropped);
+		Assert::IsTrue(statistics.highWaterMark <= 64);
+	}
+
+	TEST_METHOD(TestRingBufferDropOldestWhileConsuming)
+	{
+		RingBuffer<int> buffer(8, DROP_OLDEST);
+		for (int i = 0; i < 8; i++)
+		{
+			Assert::IsTrue(buffer.push(int(i)));
+		}
+
+		// without a consumer exactly the oldest element is dropped
+		Assert::IsTrue(buffer.push(8));
+		Assert::AreEqual(1ull, buffer.getStatistics().dropped);
+
+		// the consumer holds the oldest element while processing it, the producer waits for the slot instead of
+		// dropping the rest of the buffer
+		std::atomic_bool consuming = false;
+		int consumed = -1;
+		std::thread consumer([&buffer, &consuming, &consumed] {
+			buffer.consume([&consuming, &consumed](int& item) {
+				consumed = item;
+				consuming = true;
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			});
+		});
+		while (!consuming)
+		{
+			std::this_thread::yield();
+		}
+		Assert::IsTrue(buffer.push(9));
+		consumer.join();
+
+		Assert::AreEqual(1, consumed);
+		RingBufferStatistics statistics = buffer.getStatistics();
+		Assert::AreEqual(1ull, statistics.dropped);
+		Assert::AreEqual((size_t)8, statistics.size);
+
+		int item;
+		for (int expected = 2; expected <= 9; expected++)
+		{
+			Assert::IsTrue(buffer.pop(item));
+			Assert::AreEqual(expected, item);
+		}
+		Assert::IsFalse(buffer.pop(item));
+	}
+
+	TEST_METHOD(TestUDPSendQueue)
+	{
+		UDPSendQueue queue;
+		char message[UDP_MAX_SEND_MESSAGE_SIZE + 1] = { 1, 2, 3 };
+
+		// the messages are copied, so the caller may reuse its buffer
+		for (uint i = 0; i < UDP_SEND_BATCH_SIZE; i++)
+		{
+			message[0] = static_cast<char>(i);
+			Assert::IsTrue(queue.push(message, 3, 0x7F000001, static_cast<ushort>(5000 + i)));
+		}
+		Assert::IsTrue(queue.isFull());
+		Assert::IsFalse(queue.push(message, 3, 0x7F000001, 5000));
+
+		std::span<const UDPDatagram> datagrams = queue.getDatagrams();
+		Assert::AreEqual((size_t)UDP_SEND_BATCH_SIZE, datagrams.size());
+		Assert::IsTrue(datagrams[7].data[0] == 7 && datagrams[7].data[2] == 3 && datagrams[7].length == 3 && datagrams[7].port == 5007);
+
+		queue.clear();
+		Assert::IsFalse(queue.isFull());
+		Assert::IsFalse(queue.push(message, UDP_MAX_SEND_MESSAGE_SIZE + 1, 0x7F000001, 5000));
+		queue.recordSent(UDP_SEND_BATCH_SIZE, 1);
+
+		// only one error per interval is logged, the others are counted
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		unsigned long long suppressedErrors = 99;
+		Assert::IsTrue(queue.recordError(time, &suppressedErrors));
+		Assert::AreEqual(0ull, suppressedErrors);
+		for (int i = 0; i < 10; i++)
+		{
+			Assert::IsFalse(queue.recordError(time + std::chrono::milliseconds(i), &suppressedErrors));
+		}
+		Assert::IsTrue(queue.recordError(time + std::chrono::milliseconds(UDP_SEND_ERROR_LOG_INTERVAL), &suppressedErrors));
+		Assert::AreEqual(10ull, suppressedErrors);
+
+		UDPSendStatistics statistics = queue.getStatistics();
+		Assert::AreEqual((unsigned long long)UDP_SEND_BATCH_SIZE, statistics.datagrams);
+		Assert::AreEqual(1ull, statistics.systemCalls);
+		Assert::AreEqual(12ull, statistics.errors);
+	}
+};
\ No newline at end of file
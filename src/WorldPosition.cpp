@@ -18,6 +18,40 @@
  */
 #include "worldPosition.h"
 
+#include <cmath>
+
+/// Length of one degree latitude (in m)
+#define METERS_PER_DEGREE 111195.0
+
+/// Length of one foot (in m)
+#define METERS_PER_FOOT 0.3048
+
+/// <summary>
+/// Returns the difference between two angles, taking the wrap around at 360 degrees into account.
+/// </summary>
+static double getAngleDifference(double a, double b)
+{
+    double difference = std::fmod(std::fabs(a - b), 360.0);
+    return difference > 180.0 ? 360.0 - difference : difference;
+}
+
+bool isSamePosition(const WorldPositionStruct& a, const WorldPositionStruct& b)
+{
+    if (getAngleDifference(a.heading, b.heading) > WORLD_POSITION_ANGLE_TOLERANCE ||
+        getAngleDifference(a.bank, b.bank) > WORLD_POSITION_ANGLE_TOLERANCE ||
+        getAngleDifference(a.pitch, b.pitch) > WORLD_POSITION_ANGLE_TOLERANCE)
+    {
+        return false;
+    }
+
+    // local flat approximation, sufficient for distances in the range of the tolerance
+    double north = (a.latitude - b.latitude) * METERS_PER_DEGREE;
+    double east = getAngleDifference(a.longitude, b.longitude) * METERS_PER_DEGREE * std::cos(a.latitude * 3.14159265358979323846 / 180.0);
+    double up = (a.altitude - b.altitude) * METERS_PER_FOOT;
+
+    return north * north + east * east + up * up <= WORLD_POSITION_DISTANCE_TOLERANCE * WORLD_POSITION_DISTANCE_TOLERANCE;
+}
+
 WorldPosition::WorldPosition(double latitude, double longitude, double altitude, double heading, double bank, double pitch)
 {
     this->worldPositionStruct = WorldPositionStruct();
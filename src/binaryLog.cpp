@@ -0,0 +1,130 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "binaryLog.h"
+#include "console.h"
+
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+void writeBinaryLogHeader(std::ostream& file)
+{
+    file.write(BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_LENGTH);
+}
+
+void writeBinaryLogRecord(std::ostream& file, long long timestamp, LogLevel level, LogRecordType type, const char* payload, unsigned int length)
+{
+    char header[BINARY_LOG_RECORD_HEADER_LENGTH];
+    ushort payloadLength = static_cast<ushort>(length);
+
+    std::memcpy(header, &timestamp, 8);
+    header[8] = static_cast<char>(level);
+    header[9] = static_cast<char>(type);
+    std::memcpy(header + 10, &payloadLength, 2);
+
+    file.write(header, BINARY_LOG_RECORD_HEADER_LENGTH);
+    file.write(payload, payloadLength);
+}
+
+/// <summary>
+/// Returns the name of the log level for the rendered log.
+/// </summary>
+static const char* getLogLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LOG_LEVEL_INFO: return "INFO   ";
+    case LOG_LEVEL_WARNING: return "WARNING";
+    case LOG_LEVEL_ERROR: return "ERROR  ";
+    default: return "MESSAGE";
+    }
+}
+
+/// <summary>
+/// Appends the timestamp as "YYYY-MM-DD hh:mm:ss.uuuuuu" (UTC).
+/// </summary>
+static void formatTimestamp(long long timestamp, std::string& output)
+{
+    std::chrono::sys_time<std::chrono::microseconds> time{ std::chrono::microseconds(timestamp) };
+    std::chrono::sys_days day = std::chrono::floor<std::chrono::days>(time);
+    std::chrono::year_month_day date{ day };
+    std::chrono::hh_mm_ss<std::chrono::microseconds> timeOfDay{ time - day };
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02d:%02d:%02d.%06lld",
+        static_cast<int>(date.year()), static_cast<unsigned int>(date.month()), static_cast<unsigned int>(date.day()),
+        static_cast<int>(timeOfDay.hours().count()), static_cast<int>(timeOfDay.minutes().count()),
+        static_cast<int>(timeOfDay.seconds().count()), static_cast<long long>(timeOfDay.subseconds().count()));
+
+    output += buffer;
+}
+
+bool renderBinaryLog(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.good())
+    {
+        printError("Binary log " + path + " could not be opened.");
+        return false;
+    }
+
+    char magic[BINARY_LOG_MAGIC_LENGTH];
+    if (!file.read(magic, BINARY_LOG_MAGIC_LENGTH) || std::memcmp(magic, BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_LENGTH) != 0)
+    {
+        printError(path + " is not a binary log file.");
+        return false;
+    }
+
+    char header[BINARY_LOG_RECORD_HEADER_LENGTH];
+    char payload[sizeof(LogRecordPayload)];
+    std::string line;
+
+    while (file.read(header, BINARY_LOG_RECORD_HEADER_LENGTH))
+    {
+        long long timestamp;
+        ushort length;
+        std::memcpy(&timestamp, header, 8);
+        LogLevel level = static_cast<LogLevel>(header[8]);
+        LogRecordType type = static_cast<LogRecordType>(header[9]);
+        std::memcpy(&length, header + 10, 2);
+
+        if (length > sizeof(payload) || !file.read(payload, length))
+        {
+            printError("Binary log " + path + " is truncated or corrupted.");
+            return false;
+        }
+
+        line.clear();
+        formatTimestamp(timestamp, line);
+        line += " ";
+        line += getLogLevelName(level);
+        line += " ";
+        formatLogPayload(type, payload, length, line);
+        line += '\n';
+
+        std::cout << line;
+    }
+
+    std::cout << std::flush;
+    return true;
+}
\ No newline at end of file
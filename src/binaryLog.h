@@ -0,0 +1,58 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "log.h"
+#include "logRecord.h"
+#include <string>
+#include <ostream>
+
+/// Identifies a binary log file (8 bytes at the beginning of the file)
+#define BINARY_LOG_MAGIC "VFPLOG01"
+#define BINARY_LOG_MAGIC_LENGTH 8
+
+/// Length of the header of each record: timestamp (8), level (1), type (1), payload length (2)
+#define BINARY_LOG_RECORD_HEADER_LENGTH 12
+
+/// Contains the functions to write and render the binary log file. The payloads are stored as they are kept in memory,
+/// so a file can only be rendered by a build for the same platform.
+
+/// <summary>
+/// Writes the file header of a binary log file.
+/// </summary>
+/// <param name="file">The opened binary log file</param>
+void writeBinaryLogHeader(std::ostream& file);
+
+/// <summary>
+/// Appends a log record to a binary log file.
+/// </summary>
+/// <param name="file">The opened binary log file</param>
+/// <param name="timestamp">Creation time in microseconds since 1970-01-01 UTC</param>
+/// <param name="level">Log level of the record</param>
+/// <param name="type">Type of the payload</param>
+/// <param name="payload">Raw payload</param>
+/// <param name="length">Length of the payload</param>
+void writeBinaryLogRecord(std::ostream& file, long long timestamp, LogLevel level, LogRecordType type, const char* payload, unsigned int length);
+
+/// <summary>
+/// Prints all records of a binary log file as text on the console.
+/// </summary>
+/// <param name="path">Path of the binary log file</param>
+/// <returns>false if the file could not be read or is not a binary log file</returns>
+bool renderBinaryLog(const std::string& path);
\ No newline at end of file
@@ -0,0 +1,269 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "byteOrder.h"
+#include "numberUtils.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BYTE_ORDER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts all intrinsics without further options, GCC and Clang need the target per function
+#if defined(BYTE_ORDER_X86) && !defined(_MSC_VER)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+/// <summary>
+/// Function which reverses the bytes of every element of an array. Reading and writing network byte order is the same operation.
+/// </summary>
+typedef void (*SwapFunction)(const void* src, void* dst, size_t count);
+
+static void swap64Scalar(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t value;
+        std::memcpy(&value, in + i * 8, 8);
+        value = BYTESWAP_64(value);
+        std::memcpy(out + i * 8, &value, 8);
+    }
+}
+
+static void swap16Scalar(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ushort value;
+        std::memcpy(&value, in + i * 2, 2);
+        value = BYTESWAP_16(value);
+        std::memcpy(out + i * 2, &value, 2);
+    }
+}
+
+#ifdef BYTE_ORDER_X86
+
+TARGET_SSSE3 static void swap64SSSE3(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+    const __m128i mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8), _mm_shuffle_epi8(v, mask));
+    }
+
+    swap64Scalar(in + i * 8, out + i * 8, count - i);
+}
+
+TARGET_SSSE3 static void swap16SSSE3(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+    const __m128i mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), _mm_shuffle_epi8(v, mask));
+    }
+
+    swap16Scalar(in + i * 2, out + i * 2, count - i);
+}
+
+// _mm256_shuffle_epi8 shuffles within each 128 bit lane, so both lanes use the SSSE3 mask
+TARGET_AVX2 static void swap64AVX2(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+    const __m256i mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                          7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), _mm256_shuffle_epi8(v, mask));
+    }
+
+    // the tail uses legacy SSE instructions, which stall while the upper halves of the registers are dirty
+    _mm256_zeroupper();
+    swap64SSSE3(in + i * 8, out + i * 8, count - i);
+}
+
+TARGET_AVX2 static void swap16AVX2(const void* src, void* dst, size_t count)
+{
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+    const __m256i mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 2));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), _mm256_shuffle_epi8(v, mask));
+    }
+
+    // the tail uses legacy SSE instructions, which stall while the upper halves of the registers are dirty
+    _mm256_zeroupper();
+    swap16SSSE3(in + i * 2, out + i * 2, count - i);
+}
+
+#endif
+
+/// <summary>
+/// Detects the best implementation supported by the CPU (and by the operating system in case of the AVX registers).
+/// </summary>
+static ByteOrderImplementation detectByteOrderImplementation()
+{
+#if defined(BYTE_ORDER_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    return avx2 ? BYTE_ORDER_AVX2 : (ssse3 ? BYTE_ORDER_SSSE3 : BYTE_ORDER_SCALAR);
+#elif defined(BYTE_ORDER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return BYTE_ORDER_AVX2;
+    }
+    return __builtin_cpu_supports("ssse3") ? BYTE_ORDER_SSSE3 : BYTE_ORDER_SCALAR;
+#else
+    return BYTE_ORDER_SCALAR;
+#endif
+}
+
+/// <summary>
+/// Best implementation of this CPU, detected once.
+/// </summary>
+static const ByteOrderImplementation supportedImplementation = detectByteOrderImplementation();
+
+/// <summary>
+/// Active implementation and its functions.
+/// </summary>
+static ByteOrderImplementation activeImplementation = BYTE_ORDER_SCALAR;
+static SwapFunction activeSwap64 = swap64Scalar;
+static SwapFunction activeSwap16 = swap16Scalar;
+
+/// <summary>
+/// Selects the best implementation during static initialization, so the conversion functions never check the CPU again.
+/// </summary>
+[[maybe_unused]] static const bool isImplementationSelected = setByteOrderImplementation(supportedImplementation);
+
+bool isByteOrderImplementationSupported(ByteOrderImplementation implementation)
+{
+    return implementation <= supportedImplementation;
+}
+
+bool setByteOrderImplementation(ByteOrderImplementation implementation)
+{
+    if (!isByteOrderImplementationSupported(implementation))
+    {
+        return false;
+    }
+
+    switch (implementation)
+    {
+#ifdef BYTE_ORDER_X86
+    case BYTE_ORDER_AVX2:
+        activeSwap64 = swap64AVX2;
+        activeSwap16 = swap16AVX2;
+        break;
+    case BYTE_ORDER_SSSE3:
+        activeSwap64 = swap64SSSE3;
+        activeSwap16 = swap16SSSE3;
+        break;
+#endif
+    default:
+        activeSwap64 = swap64Scalar;
+        activeSwap16 = swap16Scalar;
+        break;
+    }
+
+    activeImplementation = implementation;
+    return true;
+}
+
+ByteOrderImplementation getByteOrderImplementation()
+{
+    return activeImplementation;
+}
+
+const char* getByteOrderImplementationName(ByteOrderImplementation implementation)
+{
+    switch (implementation)
+    {
+    case BYTE_ORDER_AVX2: return "AVX2";
+    case BYTE_ORDER_SSSE3: return "SSSE3";
+    default: return "scalar";
+    }
+}
+
+void readDoublesInNetworkByteOrder(const char* src, double* dst, size_t count)
+{
+    activeSwap64(src, dst, count);
+}
+
+void writeDoublesInNetworkByteOrder(const double* src, char* dst, size_t count)
+{
+    activeSwap64(src, dst, count);
+}
+
+void readUShortsInNetworkByteOrder(const char* src, ushort* dst, size_t count)
+{
+    activeSwap16(src, dst, count);
+}
+
+void writeUShortsInNetworkByteOrder(const ushort* src, char* dst, size_t count)
+{
+    activeSwap16(src, dst, count);
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include <cstddef>
+
+/// <summary>
+/// Implementations of the bulk byte order conversion. The best one supported by the CPU is selected at startup.
+/// </summary>
+enum ByteOrderImplementation {
+    /// One bswap instruction per value
+    BYTE_ORDER_SCALAR,
+    /// 16 bytes per SSSE3 shuffle
+    BYTE_ORDER_SSSE3,
+    /// 32 bytes per AVX2 shuffle
+    BYTE_ORDER_AVX2,
+};
+
+/// <summary>
+/// Converts an array of doubles in network byte order (e.g. the positions of a message) to host doubles.
+/// </summary>
+/// <param name="src">Source buffer, does not need to be aligned</param>
+/// <param name="dst">Destination array</param>
+/// <param name="count">Number of doubles</param>
+void readDoublesInNetworkByteOrder(const char* src, double* dst, size_t count);
+
+/// <summary>
+/// Writes an array of host doubles in network byte order.
+/// </summary>
+/// <param name="src">Source array</param>
+/// <param name="dst">Destination buffer, does not need to be aligned</param>
+/// <param name="count">Number of doubles</param>
+void writeDoublesInNetworkByteOrder(const double* src, char* dst, size_t count);
+
+/// <summary>
+/// Converts an array of ushorts in network byte order (e.g. the ids of a REMOVE message) to host ushorts.
+/// </summary>
+/// <param name="src">Source buffer, does not need to be aligned</param>
+/// <param name="dst">Destination array</param>
+/// <param name="count">Number of ushorts</param>
+void readUShortsInNetworkByteOrder(const char* src, ushort* dst, size_t count);
+
+/// <summary>
+/// Writes an array of host ushorts in network byte order.
+/// </summary>
+/// <param name="src">Source array</param>
+/// <param name="dst">Destination buffer, does not need to be aligned</param>
+/// <param name="count">Number of ushorts</param>
+void writeUShortsInNetworkByteOrder(const ushort* src, char* dst, size_t count);
+
+/// <summary>
+/// Returns the implementation which is currently used by the bulk conversion functions.
+/// </summary>
+/// <returns>Active implementation</returns>
+ByteOrderImplementation getByteOrderImplementation();
+
+/// <summary>
+/// Returns true if the given implementation is supported by the CPU.
+/// </summary>
+/// <param name="implementation">Requested implementation</param>
+/// <returns>true if the implementation can be used</returns>
+bool isByteOrderImplementationSupported(ByteOrderImplementation implementation);
+
+/// <summary>
+/// Selects the implementation used by the bulk conversion functions (e.g. to compare them in tests).
+/// Must not be called while another thread converts data.
+/// </summary>
+/// <param name="implementation">Requested implementation</param>
+/// <returns>false if the implementation is not supported by the CPU, the active implementation is not changed then</returns>
+bool setByteOrderImplementation(ByteOrderImplementation implementation);
+
+/// <summary>
+/// Returns a human-readable name of the given implementation (e.g. "AVX2").
+/// </summary>
+/// <param name="implementation">The implementation</param>
+/// <returns>Name of the implementation</returns>
+const char* getByteOrderImplementationName(ByteOrderImplementation implementation);
\ No newline at end of file
@@ -27,33 +27,25 @@ const char* COLOR_BLUE = "\033[34m";
 const char* COLOR_YELLOW = "\033[33m";
 const char* COLOR_RED = "\033[31m";
 
-void printHelp(ushort defaultReceivingPort, std::string defaultTargetIP, ushort defaultTargetPort)
+void printHelp(ushort defaultReceivingPort, std::string defaultTargetIP, ushort defaultTargetPort, uint defaultCommandQueueCapacity)
 {
-    std::cout << "Syntax: VisualFlightPathExtension [-p port] [-t ip address] [-tp target port]" << std::endl;
+    std::cout << "Syntax: VisualFlightPathExtension [-p port] [-t ip address] [-tp target port] [-qs queue size] [-qp queue policy] [-ll log level] [-lf log file] [-tr telemetry period] [-tf telemetry format] [-vr virtualization] [-or object rate] [-fs fake simulation]" << std::endl;
+    std::cout << "       VisualFlightPathExtension -rl log file" << std::endl;
     std::cout << std::endl << "Options:" << std::endl;
     std::cout << "\t-p\tReceiving UDP port ([1-65535], default: " << (int)defaultReceivingPort << ")" << std::endl;
     std::cout << "\t-t\tTarget IP address for flight status informations (default: " << defaultTargetIP << ")" << std::endl;
     std::cout << "\t-tp\tTarget UDP port ([1-65535], default: " << (int)defaultTargetPort << ")" << std::endl;
-}
-
-void Logger::logMessage(std::string message)
-{
-    printMessage(message);
-}
-
-void Logger::logInfo(std::string message)
-{
-    printInfo(message);
-}
-
-void Logger::logWarning(std::string message)
-{
-    printWarning(message);
-}
-
-void Logger::logError(std::string message)
-{
-    printError(message);
+    std::cout << "\t-qs\tCapacity of the command queue (default: " << defaultCommandQueueCapacity << ")" << std::endl;
+    std::cout << "\t-qp\tBehaviour if the command queue is full ([drop-oldest|drop-newest|block], default: drop-oldest)" << std::endl;
+    std::cout << "\t-ll\tMinimum level of logged messages ([info|warning|error], default: info)" << std::endl;
+    std::cout << "\t-lf\tWrite the log to a binary file, only warnings and errors are still shown on the console" << std::endl;
+    std::cout << "\t-tr\tPeriod of the aircraft state updates ([adaptive:][second|sim-frame[:n]|visual-frame[:n]|<rate>hz], default: second)" << std::endl;
+    std::cout << "\t-tf\tInitial wire format of the aircraft state messages ([v1|v2], default: v1)" << std::endl;
+    std::cout << "\t-vr\tOnly materialize indicators near the aircraft (radius km[:max count], e.g. 20:500, default: all indicators)" << std::endl;
+    std::cout << "\t-or\tMaximum rate of SimObject creations and removals (per second[:burst], e.g. 50:10, 0 for no limit, default: 100:20)" << std::endl;
+    std::cout << "\t-fs\tUse a simulated backend instead of SimConnect (latency ms:jitter ms:failure rate:object cap, e.g. 5:2:0.01:1000)" << std::endl;
+    std::cout << "\t-rl\tPrint a binary log file as text and exit" << std::endl;
+    std::cout << std::endl << "Console commands: exit, resetMappings, clearIndicators, stats, telemetry <period>" << std::endl;
 }
 
 void printMessage(std::string message)
@@ -74,4 +66,20 @@ void printWarning(std::string message)
 void printError(std::string message)
 {
     std::cout << COLOR_RED << message << COLOR_NORMAL << std::endl;
+}
+
+const char* getLogLevelColor(LogLevel level)
+{
+    switch (level)
+    {
+    case LOG_LEVEL_INFO: return COLOR_BLUE;
+    case LOG_LEVEL_WARNING: return COLOR_YELLOW;
+    case LOG_LEVEL_ERROR: return COLOR_RED;
+    default: return COLOR_NORMAL;
+    }
+}
+
+void printRaw(const std::string& text)
+{
+    std::cout << text << std::flush;
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "datatypes.h"
+#include "log.h"
 #include <string>
 
 /// Contains helper methods for printing on the console
@@ -29,7 +30,8 @@
 /// <param name="defaultReceivingPort">Default port for incoming requests</param>
 /// <param name="defaultTargetIP">Default target IP address for outgoing requests</param>
 /// <param name="defaultTargetPort">Default port for outgoing requests</param>
-void printHelp(ushort defaultReceivingPort, std::string defaultTargetIP, ushort defaultTargetPort);
+/// <param name="defaultCommandQueueCapacity">Default capacity of the command queue</param>
+void printHelp(ushort defaultReceivingPort, std::string defaultTargetIP, ushort defaultTargetPort, uint defaultCommandQueueCapacity);
 
 /// <summary>
 /// Prints a "normal" message on the console.
@@ -53,4 +55,17 @@ void printWarning(std::string message);
 /// Prints a message in error color on the console.
 /// </summary>
 /// <param name="message">The message to show on console</param>
-void printError(std::string message);
\ No newline at end of file
+void printError(std::string message);
+
+/// <summary>
+/// Returns the escape sequence of the console color which is used for the given log level.
+/// </summary>
+/// <param name="level">The log level</param>
+/// <returns>Escape sequence of the color</returns>
+const char* getLogLevelColor(LogLevel level);
+
+/// <summary>
+/// Prints already formatted text (e.g. several lines at once) on the console and flushes it once.
+/// </summary>
+/// <param name="text">The text to show on console</param>
+void printRaw(const std::string& text);
\ No newline at end of file
@@ -0,0 +1,344 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "fakeSimBackend.h"
+
+#include <algorithm>
+
+/// Start position of the simulated aircraft (Hagen)
+#define FAKE_AIRCRAFT_LATITUDE 51.36
+#define FAKE_AIRCRAFT_LONGITUDE 7.47
+#define FAKE_AIRCRAFT_ALTITUDE 3000.0
+#define FAKE_AIRCRAFT_SPEED 120.0
+
+FakeSimBackend::FakeSimBackend(const FakeSimBackendConfiguration& configuration)
+    : configuration(configuration), random(configuration.seed)
+{
+}
+
+const char* FakeSimBackend::getName() const
+{
+    return "Fake simulation";
+}
+
+bool FakeSimBackend::open()
+{
+    std::scoped_lock lk(mutex);
+
+    isOpen = true;
+    aircraftStateInterval = std::chrono::microseconds(0);
+
+    // answer to the initial query of the simulation state
+    SimEvent event{};
+    event.type = SIM_EVENT_RUNNING_STATE;
+    event.isRunning = true;
+    schedule(event, 0);
+
+    return true;
+}
+
+void FakeSimBackend::close()
+{
+    std::scoped_lock lk(mutex);
+
+    isOpen = false;
+    events = {};
+    existingObjects.clear();
+    statistics.existing = 0;
+}
+
+bool FakeSimBackend::createObject([[maybe_unused]] const char* modelName, [[maybe_unused]] const WorldPositionStruct& position, uint requestID)
+{
+    std::scoped_lock lk(mutex);
+
+    if (!isOpen)
+    {
+        return false;
+    }
+
+    SimEvent event{};
+    bool failed = std::uniform_real_distribution<double>(0, 1)(random) < configuration.failureRate;
+
+    if (failed || (configuration.objectCap != 0 && existingObjects.size() >= configuration.objectCap))
+    {
+        statistics.failed++;
+        event.type = SIM_EVENT_EXCEPTION;
+        event.exception = FAKE_SIM_EXCEPTION_CREATE_FAILED;
+        schedule(event, nextDelay());
+        return true;
+    }
+
+    // the object exists from now on, so it can be removed before its id is reported
+    uint objectID = nextObjectID++;
+    existingObjects.insert(objectID);
+    statistics.created++;
+    statistics.existing = existingObjects.size();
+
+    event.type = SIM_EVENT_OBJECT_ASSIGNED;
+    event.requestID = requestID;
+    event.objectID = objectID;
+    schedule(event, nextDelay());
+
+    return true;
+}
+
+bool FakeSimBackend::removeObject(uint objectID, [[maybe_unused]] uint requestID)
+{
+    std::scoped_lock lk(mutex);
+
+    if (!isOpen)
+    {
+        return false;
+    }
+
+    if (existingObjects.erase(objectID) == 0)
+    {
+        SimEvent event{};
+        event.type = SIM_EVENT_EXCEPTION;
+        event.exception = FAKE_SIM_EXCEPTION_UNKNOWN_OBJECT;
+        schedule(event, configuration.latency);
+        return true;
+    }
+
+    statistics.removed++;
+    statistics.existing = existingObjects.size();
+    return true;
+}
+
+bool FakeSimBackend::moveObject(uint objectID, [[maybe_unused]] const WorldPositionStruct& position)
+{
+    std::scoped_lock lk(mutex);
+
+    if (!isOpen)
+    {
+        return false;
+    }
+
+    if (existingObjects.count(objectID) == 0)
+    {
+        SimEvent event{};
+        event.type = SIM_EVENT_EXCEPTION;
+        event.exception = FAKE_SIM_EXCEPTION_UNKNOWN_OBJECT;
+        schedule(event, configuration.latency);
+        return true;
+    }
+
+    statistics.moved++;
+    return true;
+}
+
+bool FakeSimBackend::requestAircraftState(TelemetryPeriod period, uint periodCount, bool onlyChanged)
+{
+    std::scoped_lock lk(mutex);
+
+    if (!isOpen)
+    {
+        return false;
+    }
+
+    onlyChangedAircraftStates = onlyChanged;
+    if (configuration.frameRate == 0)
+    {
+        aircraftStateInterval = std::chrono::microseconds(0);
+    }
+    else if (period == TELEMETRY_PERIOD_SECOND)
+    {
+        aircraftStateInterval = std::chrono::microseconds(1000000ull * periodCount);
+    }
+    else
+    {
+        // simulation and visual frames have the same rate
+        aircraftStateInterval = std::chrono::microseconds(1000000ull * periodCount / configuration.frameRate);
+    }
+    nextAircraftStateUpdate = std::chrono::steady_clock::now();
+
+    eventsChanged.notify_all();
+    return true;
+}
+
+bool FakeSimBackend::waitForEvents(uint timeout)
+{
+    std::unique_lock<std::mutex> lk(mutex);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+    while (true)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (wakeUpRequested || getNextEventTime() <= now)
+        {
+            wakeUpRequested = false;
+            return true;
+        }
+        if (now >= deadline)
+        {
+            return false;
+        }
+
+        eventsChanged.wait_until(lk, std::min(getNextEventTime(), deadline));
+    }
+}
+
+void FakeSimBackend::wakeUp()
+{
+    {
+        std::scoped_lock lk(mutex);
+        wakeUpRequested = true;
+    }
+    eventsChanged.notify_all();
+}
+
+bool FakeSimBackend::getNextEvent(SimEvent& event)
+{
+    std::scoped_lock lk(mutex);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (!events.empty() && events.top().due <= now)
+    {
+        event = events.top().event;
+        event.readyTime = events.top().due;
+        events.pop();
+
+        if (event.type == SIM_EVENT_QUIT)
+        {
+            isOpen = false;
+            existingObjects.clear();
+            statistics.existing = 0;
+        }
+        return true;
+    }
+
+    while (isOpen && aircraftStateInterval.count() != 0 && nextAircraftStateUpdate <= now)
+    {
+        std::chrono::steady_clock::time_point frameTime = nextAircraftStateUpdate;
+
+        // like the simulation, frames which were missed are not reported later
+        nextAircraftStateUpdate += aircraftStateInterval;
+        if (nextAircraftStateUpdate < now)
+        {
+            nextAircraftStateUpdate = now + aircraftStateInterval;
+        }
+
+        // the aircraft does not move while the simulation is paused
+        if (isSimulationPaused && onlyChangedAircraftStates)
+        {
+            continue;
+        }
+
+        event = SimEvent{};
+        event.type = SIM_EVENT_AIRCRAFT_STATE;
+        event.readyTime = frameTime;
+        event.aircraftState = nextAircraftState();
+        return true;
+    }
+
+    return false;
+}
+
+void FakeSimBackend::simulateStart()
+{
+    std::scoped_lock lk(mutex);
+    SimEvent event{};
+    event.type = SIM_EVENT_STARTED;
+    schedule(event, 0);
+}
+
+void FakeSimBackend::simulateStop()
+{
+    std::scoped_lock lk(mutex);
+    SimEvent event{};
+    event.type = SIM_EVENT_STOPPED;
+    schedule(event, 0);
+}
+
+void FakeSimBackend::simulatePause(bool paused)
+{
+    std::scoped_lock lk(mutex);
+    isSimulationPaused = paused;
+
+    SimEvent event{};
+    event.type = SIM_EVENT_PAUSE;
+    event.isPaused = paused;
+    schedule(event, 0);
+}
+
+void FakeSimBackend::simulateQuit()
+{
+    std::scoped_lock lk(mutex);
+    SimEvent event{};
+    event.type = SIM_EVENT_QUIT;
+    schedule(event, 0);
+}
+
+FakeSimBackendStatistics FakeSimBackend::getStatistics()
+{
+    std::scoped_lock lk(mutex);
+    return statistics;
+}
+
+void FakeSimBackend::schedule(const SimEvent& event, uint delay)
+{
+    events.push(ScheduledEvent{ std::chrono::steady_clock::now() + std::chrono::milliseconds(delay), eventSequence++, event });
+
+    // the waiting thread has to recalculate the time of the next event
+    eventsChanged.notify_all();
+}
+
+std::chrono::steady_clock::time_point FakeSimBackend::getNextEventTime() const
+{
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::time_point::max();
+
+    if (!events.empty())
+    {
+        next = events.top().due;
+    }
+    if (isOpen && aircraftStateInterval.count() != 0)
+    {
+        next = std::min(next, nextAircraftStateUpdate);
+    }
+
+    return next;
+}
+
+uint FakeSimBackend::nextDelay()
+{
+    if (configuration.jitter == 0)
+    {
+        return configuration.latency;
+    }
+    return configuration.latency + std::uniform_int_distribution<uint>(0, configuration.jitter)(random);
+}
+
+AircraftStateStruct FakeSimBackend::nextAircraftState()
+{
+    // 1 nautical mile = 1/60 degree latitude
+    if (!isSimulationPaused)
+    {
+        flightHours += aircraftStateInterval.count() / 3600000000.0;
+    }
+
+    AircraftStateStruct state{};
+    state.latitude = FAKE_AIRCRAFT_LATITUDE + FAKE_AIRCRAFT_SPEED * flightHours / 60.0;
+    state.longitude = FAKE_AIRCRAFT_LONGITUDE;
+    state.altitude = FAKE_AIRCRAFT_ALTITUDE;
+    state.heading = 0;
+    state.bank = 0;
+    state.pitch = 0;
+    state.speed = FAKE_AIRCRAFT_SPEED;
+    return state;
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "simBackend.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <unordered_set>
+
+/// Exception code of a create request which failed
+#define FAKE_SIM_EXCEPTION_CREATE_FAILED 1
+
+/// Exception code of a remove or move request for an unknown SimObject
+#define FAKE_SIM_EXCEPTION_UNKNOWN_OBJECT 2
+
+/// <summary>
+/// Behaviour of the fake simulation.
+/// </summary>
+struct FakeSimBackendConfiguration {
+    /// <summary>
+    /// Time until a SimObject id is assigned in ms
+    /// </summary>
+    uint latency = 5;
+
+    /// <summary>
+    /// Maximum random time which is added to the latency in ms
+    /// </summary>
+    uint jitter = 0;
+
+    /// <summary>
+    /// Probability of a failing create request [0-1]
+    /// </summary>
+    double failureRate = 0;
+
+    /// <summary>
+    /// Maximum number of existing SimObjects, 0 for no limit
+    /// </summary>
+    uint objectCap = 0;
+
+    /// <summary>
+    /// Simulated frames per second, 0 to disable the aircraft state updates
+    /// </summary>
+    uint frameRate = 60;
+
+    /// <summary>
+    /// Seed of the random generator for jitter and failures
+    /// </summary>
+    uint seed = 1;
+};
+
+/// <summary>
+/// Snapshot of the counters of the fake simulation.
+/// </summary>
+struct FakeSimBackendStatistics {
+    unsigned long long created;
+    unsigned long long removed;
+    unsigned long long moved;
+    unsigned long long failed;
+    size_t existing;
+};
+
+/// <summary>
+/// In-process simulation which behaves like SimConnect without a running simulator, e.g. to test and measure the command path on
+/// any platform.
+///
+/// SimObject ids are assigned after the configured latency plus a random jitter, so assignments may arrive in another order than
+/// the requests. Create requests fail with the configured rate or when the object cap is reached. All random values are taken
+/// from a generator with a fixed seed, so the same sequence of calls results in the same ids, delays and failures.
+/// </summary>
+class FakeSimBackend : public SimBackend {
+public:
+    /// <summary>
+    /// Creates a fake simulation with the given behaviour.
+    /// </summary>
+    /// <param name="configuration">Behaviour of the simulation</param>
+    explicit FakeSimBackend(const FakeSimBackendConfiguration& configuration);
+
+    const char* getName() const override;
+    bool open() override;
+    void close() override;
+    bool createObject(const char* modelName, const WorldPositionStruct& position, uint requestID) override;
+    bool removeObject(uint objectID, uint requestID) override;
+    bool moveObject(uint objectID, const WorldPositionStruct& position) override;
+    bool requestAircraftState(TelemetryPeriod period, uint periodCount, bool onlyChanged) override;
+    bool waitForEvents(uint timeout) override;
+    void wakeUp() override;
+    bool getNextEvent(SimEvent& event) override;
+
+    /// <summary>
+    /// Reports a SIM_EVENT_STARTED event.
+    /// </summary>
+    void simulateStart();
+
+    /// <summary>
+    /// Reports a SIM_EVENT_STOPPED event.
+    /// </summary>
+    void simulateStop();
+
+    /// <summary>
+    /// Pauses or resumes the simulation, the aircraft does not move while the simulation is paused.
+    /// </summary>
+    /// <param name="paused">True to pause the simulation</param>
+    void simulatePause(bool paused);
+
+    /// <summary>
+    /// Closes the connection from the side of the simulation, all SimObjects are lost.
+    /// </summary>
+    void simulateQuit();
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <returns>Statistics of the fake simulation</returns>
+    FakeSimBackendStatistics getStatistics();
+
+private:
+    /// <summary>
+    /// Event which is reported when it is due.
+    /// </summary>
+    struct ScheduledEvent {
+        std::chrono::steady_clock::time_point due;
+        unsigned long long sequence; // keeps events with the same due time in order
+        SimEvent event;
+
+        bool operator>(const ScheduledEvent& other) const
+        {
+            return due != other.due ? due > other.due : sequence > other.sequence;
+        }
+    };
+
+    /// <summary>
+    /// Behaviour of the simulation.
+    /// </summary>
+    FakeSimBackendConfiguration configuration;
+
+    /// <summary>
+    /// Mutex for all members below.
+    /// </summary>
+    std::mutex mutex;
+
+    /// <summary>
+    /// Signaled when an event is scheduled or wakeUp is called.
+    /// </summary>
+    std::condition_variable eventsChanged;
+
+    /// <summary>
+    /// Set by wakeUp until waitForEvents returns.
+    /// </summary>
+    bool wakeUpRequested = false;
+
+    /// <summary>
+    /// Random generator for jitter and failures.
+    /// </summary>
+    std::mt19937 random;
+
+    /// <summary>
+    /// Events which are not reported yet, the next due event first.
+    /// </summary>
+    std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, std::greater<ScheduledEvent>> events;
+
+    /// <summary>
+    /// Number of scheduled events.
+    /// </summary>
+    unsigned long long eventSequence = 0;
+
+    /// <summary>
+    /// Ids of the existing SimObjects.
+    /// </summary>
+    std::unordered_set<uint> existingObjects;
+
+    /// <summary>
+    /// Id of the next created SimObject.
+    /// </summary>
+    uint nextObjectID = 1;
+
+    /// <summary>
+    /// Indicates if the connection is open.
+    /// </summary>
+    bool isOpen = false;
+
+    /// <summary>
+    /// Time between two aircraft state updates, 0 if the updates are not requested.
+    /// </summary>
+    std::chrono::microseconds aircraftStateInterval{ 0 };
+
+    /// <summary>
+    /// True if unchanged aircraft states are not reported.
+    /// </summary>
+    bool onlyChangedAircraftStates = false;
+
+    /// <summary>
+    /// True if the simulation is paused.
+    /// </summary>
+    bool isSimulationPaused = false;
+
+    /// <summary>
+    /// Time of the next aircraft state update.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextAircraftStateUpdate;
+
+    /// <summary>
+    /// Simulated flight time in hours, used to move the aircraft.
+    /// </summary>
+    double flightHours = 0;
+
+    /// <summary>
+    /// Counters of the simulation.
+    /// </summary>
+    FakeSimBackendStatistics statistics{};
+
+    /// <summary>
+    /// Schedules the event after the given delay.
+    /// </summary>
+    /// <param name="event">The event</param>
+    /// <param name="delay">Delay in ms</param>
+    void schedule(const SimEvent& event, uint delay);
+
+    /// <summary>
+    /// Returns the time at which the next event is available.
+    /// </summary>
+    /// <returns>Time of the next event or time_point::max if there is none</returns>
+    std::chrono::steady_clock::time_point getNextEventTime() const;
+
+    /// <summary>
+    /// Returns the latency plus a random jitter.
+    /// </summary>
+    /// <returns>Delay in ms</returns>
+    uint nextDelay();
+
+    /// <summary>
+    /// Creates the next aircraft state, the aircraft flies north with 120 knots.
+    /// </summary>
+    /// <returns>The aircraft state</returns>
+    AircraftStateStruct nextAircraftState();
+};
\ No newline at end of file
@@ -21,15 +21,35 @@
 #include "log.h"
 #include "udpCommand.h"
 #include "numberUtils.h"
+#include "byteOrder.h"
+#include "stringHelper.h"
 
 #include <string>
 #include <iostream>
 #include <memory>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
 
-void FlightPathVisualizer::start(ushort serverPort, std::string targetIP, ushort targetPort)
+void FlightPathVisualizer::start(ushort serverPort, std::string targetIP, ushort targetPort, uint commandQueueCapacity, OverflowPolicy commandQueueOverflowPolicy,
+    std::unique_ptr<SimBackend> simBackend, const TelemetryConfiguration& telemetryConfiguration, TelemetryFormat telemetryFormat,
+    const VirtualizationConfiguration& virtualizationConfiguration, const ObjectSchedulerConfiguration& objectSchedulerConfiguration)
 {
+    // the target given on the command line is a permanent subscriber which receives every state
+    uint targetAddress;
+    if (!UDPProxy::parseIPv4Address(targetIP, &targetAddress))
+    {
+        Logger::logError("Invalid target IP address " + targetIP + ". Abort.");
+        return;
+    }
+    telemetrySubscribers.subscribe(targetAddress, targetPort, telemetryFormat, 0, true, std::chrono::steady_clock::now());
+
+    Logger::logInfo("Byte order conversion: " + std::string(getByteOrderImplementationName(getByteOrderImplementation())));
+
+    commandQueue = std::make_unique<RingBuffer<ParsedCommand>>(commandQueueCapacity, commandQueueOverflowPolicy);
+
     udpProxy = new UDPProxy();
-    bool startUDPServRes = udpProxy->startUDPProxy(serverPort, this, targetIP, targetPort);
+    bool startUDPServRes = udpProxy->startUDPProxy(serverPort, this);
 
     if (!startUDPServRes)
     {
@@ -38,73 +58,262 @@ void FlightPathVisualizer::start(ushort serverPort, std::string targetIP, ushort
     }
 
     simConnectProxy = new SimConnectProxy();
-    simConnectProxy->startSimConnectProxy(this);
+    simConnectProxy->setTelemetryConfiguration(telemetryConfiguration);
+    simConnectProxy->setVirtualizationConfiguration(virtualizationConfiguration);
+    simConnectProxy->setObjectSchedulerConfiguration(objectSchedulerConfiguration);
+    simConnectProxy->startSimConnectProxy(this, std::move(simBackend));
+
+    isExecutorRunning = true;
+    commandExecutorThread = std::thread(&FlightPathVisualizer::runCommandExecutor, this);
 }
 
 void FlightPathVisualizer::handleMessage(char* message, uint length)
 {
-    std::unique_ptr<AbstractCommandConfiguration> command = nullptr;
-    try {
-        command = CommandConfigurationParser::parse(message, length);
+    queueMessage(message, length, CommandSender());
+}
+
+void FlightPathVisualizer::handleMessages(std::span<UDPMessage> messages)
+{
+    for (UDPMessage& message : messages)
+    {
+        queueMessage(message.data, message.length, CommandSender{ message.sourceAddress, message.sourcePort });
+    }
+}
+
+void FlightPathVisualizer::queueMessage(char* message, uint length, CommandSender sender)
+{
+    ParseError error = PARSE_OK;
+
+    // the command is parsed directly into the queue slot and executed by the command executor thread,
+    // so the UDP thread neither allocates nor waits for SimConnect
+    commandQueue->emplace([&](ParsedCommand& command) {
+        error = CommandParser::parse(message, length, command, sender);
+        return error == PARSE_OK;
+    });
+
+    if (error != PARSE_OK)
+    {
+        logParseError(error, message, length);
     }
-    catch (std::invalid_argument e)
+}
+
+void FlightPathVisualizer::logParseError(ParseError error, char* message, uint length)
+{
+    switch (error)
+    {
+    case PARSE_MISSING_COMMAND:
+        Logger::logError("Received invalid message (missing command): " + std::string(message, length));
+        break;
+    case PARSE_UNKNOWN_COMMAND:
+        Logger::logError("Received invalid message (invalid command id " + std::to_string(readUShortNetworkByteOrder(message)) + "): " + std::string(message, length));
+        break;
+    case PARSE_SET_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Set command): " + std::string(message, length));
+        break;
+    case PARSE_REMOVE_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Remove command): " + std::string(message, length));
+        break;
+    case PARSE_SET_BATCH_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Set Batch command): " + std::string(message, length));
+        break;
+    case PARSE_LATITUDE_OUT_OF_RANGE:
+        Logger::logError("Latitude is out of range");
+        break;
+    case PARSE_LONGITUDE_OUT_OF_RANGE:
+        Logger::logError("Longitude is out of range");
+        break;
+    case PARSE_TELEMETRY_FORMAT_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Telemetry Format command): " + std::string(message, length));
+        break;
+    case PARSE_SUBSCRIBE_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Subscribe command): " + std::string(message, length));
+        break;
+    case PARSE_UNSUBSCRIBE_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Unsubscribe command): " + std::string(message, length));
+        break;
+    case PARSE_PATH_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Path command): " + std::string(message, length));
+        break;
+    case PARSE_PATH_INVALID_SPACING:
+        Logger::logError("Received invalid message (Path spacing must be positive)");
+        break;
+    case PARSE_UNKNOWN_PATH_INTERPOLATION:
+        Logger::logError("Received invalid message (unknown path interpolation " + std::to_string(readUShortNetworkByteOrder(message + 16)) + ")");
+        break;
+    case PARSE_ANCHOR_INVALID_LENGTH:
+        Logger::logError("Received invalid message (Invalid message length for Anchor command): " + std::string(message, length));
+        break;
+    case PARSE_UNKNOWN_ANCHOR_FRAME:
+        Logger::logError("Received invalid message (unknown anchor frame " + std::to_string(readUShortNetworkByteOrder(message + 8)) + ")");
+        break;
+    case PARSE_ANCHOR_INVALID_OFFSET:
+        Logger::logError("Received invalid message (Anchor offset must be finite and within " + std::to_string(static_cast<int>(ANCHOR_MAX_OFFSET)) +
+            " m, angles within " + std::to_string(static_cast<int>(ANCHOR_MAX_ANGLE)) + " degrees)");
+        break;
+    case PARSE_UNKNOWN_TELEMETRY_FORMAT:
+        Logger::logError("Received invalid message (unknown telemetry format " + std::to_string(readUShortNetworkByteOrder(message + 2)) + ")");
+        break;
+    default:
+        break;
+    }
+}
+
+void FlightPathVisualizer::runCommandExecutor()
+{
+    while (isExecutorRunning)
     {
-        if (strcmp(e.what(), "missing_command") == 0)
+        for (const TelemetrySubscriberStatistics& subscriber : telemetrySubscribers.removeExpiredSubscribers(std::chrono::steady_clock::now()))
         {
-            Logger::logError("Received invalid message (missing command): " + std::string(message, length));
-        } else if (strcmp(e.what(), "unknown_command") == 0)
+            Logger::logInfo("Telemetry subscriber " + formatIPv4Address(subscriber.address, subscriber.port) + " expired after " +
+                std::to_string(subscriber.sent) + " states");
+        }
+
+        if (!commandQueue->waitForData(std::chrono::milliseconds(100)))
         {
-            Logger::logError("Received invalid message (invalid command id " + std::to_string(readUShortNetworkByteOrder(message)) + "): " + std::string(message, length));
-        } else if (strcmp(e.what(), "set_invalid_length") == 0)
+            continue;
+        }
+
+        // the commands are executed in place, they are too large to be copied out of the queue
+        while (commandQueue->consume([this](ParsedCommand& command) {
+            logCommand(command);
+            executeCommand(command);
+        }))
         {
-            Logger::logError("Received invalid message (Invalid message length for Set command): " + std::string(message, length));
-        } else if (strcmp(e.what(), "remove_invalid_length") == 0)
+        }
+    }
+}
+
+void FlightPathVisualizer::executeCommand(const ParsedCommand& command)
+{
+    if (const TelemetryFormatCommand* formatCommand = std::get_if<TelemetryFormatCommand>(&command))
+    {
+        TelemetryFormat format = static_cast<TelemetryFormat>(formatCommand->format);
+        if (telemetrySubscribers.setFormat(formatCommand->sender.address, formatCommand->sender.port, format))
         {
-            Logger::logError("Received invalid message (Invalid message length for Remove command): " + std::string(message, length));
+            Logger::logInfo("Telemetry format of " + formatIPv4Address(formatCommand->sender.address, formatCommand->sender.port) + ": " +
+                getTelemetryFormatName(format));
         }
-        else if (strcmp(e.what(), "LATITUDE_OUT_OF_RANGE") == 0)
+        else
         {
-            Logger::logError("Latitude is out of range");
+            setTelemetryFormat(format);
         }
-        else if (strcmp(e.what(), "LONGITUDE_OUT_OF_RANGE") == 0)
+        return;
+    }
+    else if (const SubscribeCommand* subscribeCommand = std::get_if<SubscribeCommand>(&command))
+    {
+        std::string subscriber = formatIPv4Address(subscribeCommand->subscriber.address, subscribeCommand->subscriber.port);
+        SubscribeResult result = telemetrySubscribers.subscribe(subscribeCommand->subscriber.address, subscribeCommand->subscriber.port,
+            static_cast<TelemetryFormat>(subscribeCommand->format), subscribeCommand->rate, false, std::chrono::steady_clock::now());
+
+        if (result == SUBSCRIBE_ADDED)
+        {
+            Logger::logInfo("Telemetry subscriber " + subscriber + " added");
+        }
+        else if (result == SUBSCRIBE_FULL)
+        {
+            Logger::logWarning("Telemetry subscriber " + subscriber + " rejected: already " + std::to_string(TELEMETRY_MAX_SUBSCRIBERS) + " subscribers");
+        }
+        return;
+    }
+    else if (const UnsubscribeCommand* unsubscribeCommand = std::get_if<UnsubscribeCommand>(&command))
+    {
+        std::string subscriber = formatIPv4Address(unsubscribeCommand->subscriber.address, unsubscribeCommand->subscriber.port);
+        if (telemetrySubscribers.unsubscribe(unsubscribeCommand->subscriber.address, unsubscribeCommand->subscriber.port))
+        {
+            Logger::logInfo("Telemetry subscriber " + subscriber + " removed");
+        }
+        else
         {
-            Logger::logError("Longitude is out of range");
+            Logger::logWarning("Unknown telemetry subscriber " + subscriber);
         }
+        return;
     }
 
-    // make sure command was parsed and is not null
-    if (command == nullptr) return;
+    simConnectProxy->handleCommand(command);
+}
 
-    AbstractCommandConfiguration* commandConfig = command.get();
+void FlightPathVisualizer::logCommand(const ParsedCommand& command)
+{
+    if (!Logger::isEnabled(LOG_LEVEL_INFO))
+    {
+        return;
+    }
 
-    Logger::logInfo(commandConfig->toString());
-    simConnectProxy->handleCommand(commandConfig);
+    // only the raw values are captured, they are formatted by the logger thread
+    if (const SetIndicatorCommand* setCommand = std::get_if<SetIndicatorCommand>(&command))
+    {
+        const WorldPositionStruct& position = setCommand->position;
+        SetIndicatorLogEvent event{ setCommand->id, setCommand->indicatorTypeID,
+            { position.latitude, position.longitude, position.altitude, position.heading, position.bank, position.pitch } };
+        Logger::logEvent(LOG_LEVEL_INFO, event);
+    }
+    else if (const SetIndicatorBatchCommand* batchCommand = std::get_if<SetIndicatorBatchCommand>(&command))
+    {
+        SetIndicatorBatchLogEvent event{ batchCommand->count, batchCommand->indicators[0].id, batchCommand->indicators[batchCommand->count - 1].id };
+        Logger::logEvent(LOG_LEVEL_INFO, event);
+    }
+    else if (const RemoveIndicatorsCommand* removeCommand = std::get_if<RemoveIndicatorsCommand>(&command))
+    {
+        RemoveIndicatorsLogEvent event;
+        event.count = removeCommand->count;
+        std::memcpy(event.ids, removeCommand->ids, std::min<size_t>(removeCommand->count, LOG_EVENT_MAX_IDS) * sizeof(ushort));
+        Logger::logEvent(LOG_LEVEL_INFO, event);
+    }
 }
 
 void FlightPathVisualizer::handleAircraftStateUpdate(AircraftState aircraftState)
 {
-    Logger::logInfo("Aircraft state received: Latitude: " + std::to_string(aircraftState.getLatitude()) +
-        " Longitude: " + std::to_string(aircraftState.getLongitude()) +
-        " Altitude: " + std::to_string(aircraftState.getAltitude()) +
-        " Heading: " + std::to_string(aircraftState.getHeading()) +
-        " Bank: " + std::to_string(aircraftState.getBank()) +
-        " Pitch: " + std::to_string(aircraftState.getPitch()) +
-        " Speed: " + std::to_string(aircraftState.getSpeed()));
+    AircraftStateStruct state;
+    state.latitude = aircraftState.getLatitude();
+    state.longitude = aircraftState.getLongitude();
+    state.altitude = aircraftState.getAltitude();
+    state.heading = aircraftState.getHeading();
+    state.bank = aircraftState.getBank();
+    state.pitch = aircraftState.getPitch();
+    state.speed = aircraftState.getSpeed();
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+    std::span<const UDPDatagram> datagrams = telemetrySubscribers.publish(state, now, timestamp);
+    udpProxy->sendDatagrams(datagrams);
+
+    unsigned long long bytes = 0;
+    for (const UDPDatagram& datagram : datagrams)
+    {
+        bytes += datagram.length;
+    }
+    telemetryBytes.fetch_add(bytes, std::memory_order_relaxed);
 
-    int contentLength = 56;
-    char* rawContent = new char[contentLength] {};
+    // with updates in every frame only a sample is logged
+    if (Logger::isEnabled(LOG_LEVEL_INFO))
+    {
+        if (now >= nextAircraftStateLog)
+        {
+            nextAircraftStateLog = now + std::chrono::milliseconds(AIRCRAFT_STATE_LOG_INTERVAL);
 
-    writeDoubleInNetworkByteOrder(aircraftState.getLatitude(), rawContent);
-    writeDoubleInNetworkByteOrder(aircraftState.getLongitude(), rawContent + 8);
-    writeDoubleInNetworkByteOrder(aircraftState.getAltitude(), rawContent + 16);
-    writeDoubleInNetworkByteOrder(aircraftState.getHeading(), rawContent + 24);
-    writeDoubleInNetworkByteOrder(aircraftState.getBank(), rawContent + 32);
-    writeDoubleInNetworkByteOrder(aircraftState.getPitch(), rawContent + 40);
-    writeDoubleInNetworkByteOrder(aircraftState.getSpeed(), rawContent + 48);
+            AircraftStateLogEvent event{ { state.latitude, state.longitude, state.altitude, state.heading, state.bank, state.pitch, state.speed } };
+            Logger::logEvent(LOG_LEVEL_INFO, event);
+        }
+    }
+}
 
-    udpProxy->sendData(rawContent, contentLength);
+void FlightPathVisualizer::handleGateEvents(std::span<const GateEvent> events)
+{
+    char message[TELEMETRY_V2_GATE_EVENT_LENGTH];
+    for (const GateEvent& event : events)
+    {
+        // the datagrams are copied into the send queue, so the buffer is reused for the next event
+        uint length = encodeGateEvent(event, gateEventSequence++, message);
+        std::span<const UDPDatagram> datagrams = telemetrySubscribers.publishEvent(message, length);
+        udpProxy->sendDatagrams(datagrams);
 
-    delete[] rawContent;
+        if (Logger::isEnabled(LOG_LEVEL_INFO))
+        {
+            GateLogEvent logEvent{ event.id, event.type == GATE_PASSED, event.missDistance };
+            Logger::logEvent(LOG_LEVEL_INFO, logEvent);
+        }
+    }
 }
 
 void FlightPathVisualizer::clearIndicatorMappings()
@@ -112,14 +321,107 @@ void FlightPathVisualizer::clearIndicatorMappings()
     simConnectProxy->resetIndicatorTypeMapping();
 }
 
+void FlightPathVisualizer::setTelemetryConfiguration(const TelemetryConfiguration& configuration)
+{
+    simConnectProxy->setTelemetryConfiguration(configuration);
+}
+
+void FlightPathVisualizer::setTelemetryFormat(TelemetryFormat format)
+{
+    telemetrySubscribers.setPermanentFormat(format);
+    Logger::logInfo("Telemetry format: " + std::string(getTelemetryFormatName(format)));
+}
+
 void FlightPathVisualizer::removeAllIndicators()
 {
     simConnectProxy->removeAllIndicators();
 }
 
+void FlightPathVisualizer::logStatistics()
+{
+    RingBufferStatistics queueStatistics = commandQueue->getStatistics();
+
+    Logger::logMessage("Command queue: " + std::to_string(queueStatistics.size) + "/" + std::to_string(queueStatistics.capacity) +
+        " queued, " + std::to_string(queueStatistics.enqueued) + " enqueued, " +
+        std::to_string(queueStatistics.dropped) + " dropped, high-water mark " + std::to_string(queueStatistics.highWaterMark));
+    IndicatorRegistryStatistics indicatorStatistics = simConnectProxy->getIndicatorStatistics();
+    Logger::logMessage("Indicators: " + std::to_string(indicatorStatistics.active) + " active, " + std::to_string(indicatorStatistics.pending) +
+        " pending, " + std::to_string(indicatorStatistics.staleAssignments) + " outdated SimObjects removed");
+    IndicatorPlacementStatistics placementStatistics = simConnectProxy->getPlacementStatistics();
+    Logger::logMessage("SET: " + std::to_string(placementStatistics.created) + " created, " + std::to_string(placementStatistics.moved) + " moved, " +
+        std::to_string(placementStatistics.deferredMoves) + " moved after creation, " + std::to_string(placementStatistics.unchanged) + " unchanged");
+    for (const IndicatorPoolStatistics& pool : simConnectProxy->getPoolStatistics())
+    {
+        Logger::logMessage("Pool " + pool.modelName + ": " + std::to_string(pool.parked) + "/" + std::to_string(pool.size) + " parked, " +
+            std::to_string(pool.pending) + " being created, " + std::to_string(pool.hits) + " hits, " + std::to_string(pool.misses) + " misses, " +
+            std::to_string(pool.returned) + " returned");
+    }
+    VirtualizationStatistics virtualizationStatistics = simConnectProxy->getVirtualizationStatistics();
+    if (virtualizationStatistics.updates > 0)
+    {
+        Logger::logMessage("Virtualization: " + std::to_string(virtualizationStatistics.resident) + " resident, " +
+            std::to_string(virtualizationStatistics.total - virtualizationStatistics.resident) + " virtual, " + std::to_string(virtualizationStatistics.materialized) +
+            " materialized, " + std::to_string(virtualizationStatistics.retired) + " retired in " + std::to_string(virtualizationStatistics.updates) +
+            " updates, query avg " + std::to_string(virtualizationStatistics.averageQueryTime) + " ns (" + std::to_string(virtualizationStatistics.averageExamined) +
+            " indicators examined), max " + std::to_string(virtualizationStatistics.maxQueryTime) + " ns");
+    }
+    AnchorStatistics anchorStatistics = simConnectProxy->getAnchorStatistics();
+    if (anchorStatistics.anchored > 0 || anchorStatistics.resolutions > 0)
+    {
+        Logger::logMessage("Anchored indicators: " + std::to_string(anchorStatistics.anchored) + " following the aircraft, placed with " +
+            std::to_string(anchorStatistics.resolutions) + " aircraft states, avg " + std::to_string(anchorStatistics.averageResolveTime) + " ns");
+    }
+    ObjectSchedulerStatistics schedulerStatistics = simConnectProxy->getObjectSchedulerStatistics();
+    if (schedulerStatistics.creates > 0 || schedulerStatistics.removes > 0 || schedulerStatistics.queuedCreates > 0 || schedulerStatistics.queuedRemoves > 0)
+    {
+        Logger::logMessage("Object operations: " + std::to_string(schedulerStatistics.creates) + " creations and " + std::to_string(schedulerStatistics.removes) +
+            " removals dispatched, " + std::to_string(schedulerStatistics.canceled) + " creations canceled, queue " +
+            std::to_string(schedulerStatistics.queuedCreates + schedulerStatistics.queuedRemoves) + " (max " + std::to_string(schedulerStatistics.maxQueueDepth) +
+            "), wait avg " + std::to_string(schedulerStatistics.averageWait) + " us, max " + std::to_string(schedulerStatistics.maxWait) + " us");
+    }
+    GateStatistics gateStatistics = simConnectProxy->getGateStatistics();
+    if (gateStatistics.gates > 0 || gateStatistics.passed > 0 || gateStatistics.missed > 0)
+    {
+        Logger::logMessage("Gates: " + std::to_string(gateStatistics.gates) + " rings, " + std::to_string(gateStatistics.passed) + " passed, " +
+            std::to_string(gateStatistics.missed) + " missed, " + std::to_string(gateStatistics.segments) + " segments tested against " +
+            std::to_string(gateStatistics.candidates) + " nearby rings, avg " + std::to_string(gateStatistics.averageTestTime) + " ns");
+    }
+    IndicatorLodStatistics lodStatistics = simConnectProxy->getLodStatistics();
+    if (lodStatistics.indicators > 0 || lodStatistics.swaps > 0)
+    {
+        Logger::logMessage("Level of detail: " + std::to_string(lodStatistics.indicators) + " indicators, " + std::to_string(lodStatistics.swaps) +
+            " models swapped in " + std::to_string(lodStatistics.updates) + " updates, " + std::to_string(lodStatistics.deferredSwaps) + " swaps postponed by the budget");
+    }
+    SimDispatchStatistics dispatchStatistics = simConnectProxy->getDispatchStatistics();
+    Logger::logMessage("Simulation events: " + std::to_string(dispatchStatistics.events) + " handled in " + std::to_string(dispatchStatistics.wakeUps) +
+        " wake-ups (" + std::to_string(dispatchStatistics.timeouts) + " timeouts), latency avg " + std::to_string(dispatchStatistics.averageLatency) +
+        " us, max " + std::to_string(dispatchStatistics.maxLatency) + " us");
+    Logger::logMessage("Aircraft states: " + std::to_string(dispatchStatistics.aircraftStates) + " sent (" + std::to_string(telemetryBytes.load()) +
+        " bytes), " + std::to_string(dispatchStatistics.skippedAircraftStates) + " skipped by the rate limit");
+    UDPSendStatistics sendStatistics = udpProxy->getSendStatistics();
+    Logger::logMessage("UDP send: " + std::to_string(sendStatistics.datagrams) + " messages in " + std::to_string(sendStatistics.systemCalls) +
+        " system calls, " + std::to_string(sendStatistics.errors) + " errors");
+    for (const TelemetrySubscriberStatistics& subscriber : telemetrySubscribers.getStatistics())
+    {
+        Logger::logMessage("Subscriber " + formatIPv4Address(subscriber.address, subscriber.port) + (subscriber.isPermanent ? " (target)" : "") +
+            ": format " + getTelemetryFormatName(subscriber.format) + ", rate " +
+            (subscriber.rate == 0 ? std::string("every state") : std::to_string(subscriber.rate) + " Hz") + ", " + std::to_string(subscriber.sent) + " sent");
+    }
+    TelemetryControllerStatistics telemetryStatistics = simConnectProxy->getTelemetryStatistics();
+    Logger::logMessage("Adaptive telemetry: " + std::to_string(telemetryStatistics.sent) + " sent, " + std::to_string(telemetryStatistics.suppressed) +
+        " suppressed, " + std::to_string(telemetryStatistics.keepAlive) + " keep alive");
+    Logger::logMessage("Log: " + std::to_string(Logger::getDroppedRecordCount()) + " messages dropped");
+}
+
 void FlightPathVisualizer::shutdown()
 {
     udpProxy->stopUDPProxy();
+
+    // stop the executor before SimConnect is closed
+    isExecutorRunning = false;
+    commandQueue->close();
+    commandExecutorThread.join();
+
     simConnectProxy->stopSimConnectProxy();
 }
 
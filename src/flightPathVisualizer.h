@@ -22,8 +22,18 @@
 #include "udpProxy.h"
 #include "udpCommand.h"
 #include "simConnectProxy.h"
+#include "ringBuffer.h"
+#include "telemetryFormat.h"
+#include "telemetrySubscribers.h"
 
 #include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+/// Minimum time between two logged aircraft states, so high update rates do not flood the log (in ms)
+#define AIRCRAFT_STATE_LOG_INTERVAL 1000
 
 /// <summary>
 /// Main class which controls and processes the data flow between SimConnectProxy and UDPProxy.
@@ -36,7 +46,16 @@ public:
     /// <param name="serverPort">The IP port for incoming data</param>
     /// <param name="targetIP">The IP address for outgoing data</param>
     /// <param name="targetPort">The IP port for outgoing data</param>
-    void start(ushort serverPort, std::string targetIP, ushort targetPort);
+    /// <param name="commandQueueCapacity">Maximum number of parsed commands waiting for execution</param>
+    /// <param name="commandQueueOverflowPolicy">Behaviour if the command queue is full</param>
+    /// <param name="simBackend">Connection to the simulation</param>
+    /// <param name="telemetryConfiguration">Period of the aircraft state updates</param>
+    /// <param name="telemetryFormat">Initial wire format of the aircraft state messages to the target, it may change it with a TELEMETRY_FORMAT command</param>
+    /// <param name="virtualizationConfiguration">Radius and maximum count of the materialized indicators around the aircraft</param>
+    /// <param name="objectSchedulerConfiguration">Pacing of the SimObject creations and removals</param>
+    void start(ushort serverPort, std::string targetIP, ushort targetPort, uint commandQueueCapacity, OverflowPolicy commandQueueOverflowPolicy,
+        std::unique_ptr<SimBackend> simBackend, const TelemetryConfiguration& telemetryConfiguration, TelemetryFormat telemetryFormat,
+        const VirtualizationConfiguration& virtualizationConfiguration, const ObjectSchedulerConfiguration& objectSchedulerConfiguration);
 
     /// <summary>
     /// Stops the processing.
@@ -44,7 +63,9 @@ public:
     void shutdown();
 
     void handleMessage(char* message, uint length) override;
+    void handleMessages(std::span<UDPMessage> messages) override;
     void handleAircraftStateUpdate(AircraftState aircraftState) override;
+    void handleGateEvents(std::span<const GateEvent> events) override;
 
     /// <summary>
     /// Advises the SimConnectProxy to clear the cached indicator type mappings.
@@ -56,6 +77,24 @@ public:
     /// </summary>
     void removeAllIndicators();
 
+    /// <summary>
+    /// Changes the period of the aircraft state updates which are sent to the target.
+    /// </summary>
+    /// <param name="configuration">New telemetry configuration</param>
+    void setTelemetryConfiguration(const TelemetryConfiguration& configuration);
+
+    /// <summary>
+    /// Changes the wire format of the aircraft state messages which are sent to the target given on the command line.
+    /// </summary>
+    /// <param name="format">New wire format</param>
+    void setTelemetryFormat(TelemetryFormat format);
+
+    /// <summary>
+    /// Logs the counters of all subsystems for the stats command: command queue, indicators and their pools, SimConnect
+    /// dispatch and object scheduling, gates, level of detail, UDP send, telemetry subscribers and the log.
+    /// </summary>
+    void logStatistics();
+
 private:
     /// <summary>
     /// The UDP Proxy for receiving and sending data over a UDP socket.
@@ -66,5 +105,73 @@ private:
     /// The SimConnect Proxy for data exchange with a running SimConnect application.
     /// </summary>
     SimConnectProxy* simConnectProxy;
+
+    /// <summary>
+    /// Parsed commands on their way from the UDP thread (producer) to the command executor thread (consumer).
+    /// </summary>
+    std::unique_ptr<RingBuffer<ParsedCommand>> commandQueue;
+
+    /// <summary>
+    /// Thread which executes the queued commands.
+    /// </summary>
+    std::thread commandExecutorThread;
+
+    /// <summary>
+    /// Indicates the status of the command executor thread.
+    /// </summary>
+    std::atomic_bool isExecutorRunning{ false };
+
+    /// <summary>
+    /// Receivers of the aircraft states: the target given on the command line and the clients which sent a SUBSCRIBE command.
+    /// </summary>
+    TelemetrySubscriberRegistry telemetrySubscribers;
+
+    /// <summary>
+    /// Number of bytes of all aircraft state messages.
+    /// </summary>
+    std::atomic<unsigned long long> telemetryBytes{ 0 };
+
+    /// <summary>
+    /// Sequence number of the next gate event. Only used by the SimConnect thread.
+    /// </summary>
+    uint gateEventSequence = 0;
+
+    /// <summary>
+    /// Time at which the next aircraft state is logged. Only used by the SimConnect thread.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextAircraftStateLog;
+
+    /// <summary>
+    /// Parses an incoming message directly into the next slot of the command queue and logs the reason if it is invalid.
+    /// </summary>
+    /// <param name="message">The message as char array</param>
+    /// <param name="length">The length of the array</param>
+    /// <param name="sender">Sender of the message</param>
+    void queueMessage(char* message, uint length, CommandSender sender);
+
+    /// <summary>
+    /// Logs the reason why a message could not be parsed.
+    /// </summary>
+    /// <param name="error">The parse error</param>
+    /// <param name="message">The message as char array</param>
+    /// <param name="length">The length of the array</param>
+    void logParseError(ParseError error, char* message, uint length);
+
+    /// <summary>
+    /// Logs the executed command as structured event.
+    /// </summary>
+    /// <param name="command">The executed command</param>
+    void logCommand(const ParsedCommand& command);
+
+    /// <summary>
+    /// Executes a command. Telemetry and subscription commands are handled here, all others by the SimConnectProxy.
+    /// </summary>
+    /// <param name="command">The command</param>
+    void executeCommand(const ParsedCommand& command);
+
+    /// <summary>
+    /// Takes the commands from the command queue and executes them until shutdown is called.
+    /// </summary>
+    void runCommandExecutor();
 };
 
@@ -0,0 +1,199 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gateDetector.h"
+#include "geodesy.h"
+#include "indicatorRegistry.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/// Prefix of the ring models, followed by the size S, M or L and optionally the color
+#define GATE_MODEL_PREFIX "VFP_Circle_"
+
+/// <summary>
+/// Converts a position into the local east-north-up frame of the gate, which is exact enough within a few km.
+/// </summary>
+static void toLocalFrame(double latitude, double longitude, double altitude, double originLatitude, double originLongitude, double originAltitude,
+    double local[3])
+{
+    local[0] = getLongitudeDifference(originLongitude, longitude) * DEGREES_TO_RADIANS * EARTH_MEAN_RADIUS * std::cos(originLatitude * DEGREES_TO_RADIANS);
+    local[1] = (latitude - originLatitude) * DEGREES_TO_RADIANS * EARTH_MEAN_RADIUS;
+    local[2] = altitude * METERS_PER_FOOT - originAltitude;
+}
+
+double getGateRadius(const char* modelName)
+{
+    size_t prefixLength = std::strlen(GATE_MODEL_PREFIX);
+    if (modelName == nullptr || std::strncmp(modelName, GATE_MODEL_PREFIX, prefixLength) != 0)
+    {
+        return 0;
+    }
+
+    // the size may be followed by the color, e.g. VFP_Circle_M_blue
+    const char* size = modelName + prefixLength;
+    if (size[0] == '\0' || (size[1] != '\0' && size[1] != '_'))
+    {
+        return 0;
+    }
+
+    switch (size[0])
+    {
+    case 'S':
+        return GATE_RADIUS_SMALL;
+    case 'M':
+        return GATE_RADIUS_MEDIUM;
+    case 'L':
+        return GATE_RADIUS_LARGE;
+    default:
+        return 0;
+    }
+}
+
+GateDetector::GateDetector()
+    : gates(new Gate[INDICATOR_REGISTRY_SIZE]())
+{
+}
+
+void GateDetector::update(ushort id, const WorldPositionStruct& position, double radius)
+{
+    if (radius <= 0)
+    {
+        remove(id);
+        return;
+    }
+
+    Gate& gate = gates[id];
+    gate.latitude = position.latitude;
+    gate.longitude = position.longitude;
+    gate.altitude = position.altitude * METERS_PER_FOOT;
+    gate.radius = radius;
+
+    // the ring lies in the plane of the lateral and vertical axis, so its normal is the longitudinal axis
+    rotateBodyToEnu(position.heading, position.pitch, position.bank, 1, 0, 0, gate.normal);
+
+    maxRadius = std::max(maxRadius, radius);
+    grid.update(id, position.latitude, position.longitude);
+}
+
+void GateDetector::remove(ushort id)
+{
+    if (gates[id].radius > 0)
+    {
+        gates[id].radius = 0;
+        grid.remove(id);
+    }
+}
+
+std::span<const GateEvent> GateDetector::addAircraftState(const AircraftStateStruct& state, uint64_t timestamp)
+{
+    events.clear();
+
+    if (hasPreviousState && grid.size() > 0)
+    {
+        double motion[3];
+        toLocalFrame(state.latitude, state.longitude, state.altitude, previousState.latitude, previousState.longitude,
+            previousState.altitude * METERS_PER_FOOT, motion);
+        double length = std::sqrt(motion[0] * motion[0] + motion[1] * motion[1] + motion[2] * motion[2]);
+
+        if (length > 0 && length <= GATE_MAX_SEGMENT_LENGTH)
+        {
+            // every ring whose miss range may touch the segment is within this radius around its midpoint
+            double latitude = (previousState.latitude + state.latitude) / 2;
+            double longitude = previousState.longitude + getLongitudeDifference(previousState.longitude, state.longitude) / 2;
+            double radius = length / 2 + maxRadius * GATE_MISS_RANGE;
+
+            candidates.clear();
+            grid.query(latitude, longitude, radius, candidates);
+
+            segments++;
+            testedCandidates += candidates.size();
+            for (const IndicatorDistance& candidate : candidates)
+            {
+                testGate(candidate.id, previousState, state, previousTimestamp, timestamp);
+            }
+
+            std::sort(events.begin(), events.end(), [](const GateEvent& a, const GateEvent& b) { return a.timestamp < b.timestamp; });
+        }
+    }
+
+    previousState = state;
+    previousTimestamp = timestamp;
+    hasPreviousState = true;
+    return std::span<const GateEvent>(events.data(), events.size());
+}
+
+void GateDetector::testGate(ushort id, const AircraftStateStruct& from, const AircraftStateStruct& to, uint64_t fromTimestamp, uint64_t toTimestamp)
+{
+    const Gate& gate = gates[id];
+
+    double start[3];
+    double end[3];
+    toLocalFrame(from.latitude, from.longitude, from.altitude, gate.latitude, gate.longitude, gate.altitude, start);
+    toLocalFrame(to.latitude, to.longitude, to.altitude, gate.latitude, gate.longitude, gate.altitude, end);
+
+    // signed distances to the ring plane, a point on the plane counts as in front of it
+    double startSide = start[0] * gate.normal[0] + start[1] * gate.normal[1] + start[2] * gate.normal[2];
+    double endSide = end[0] * gate.normal[0] + end[1] * gate.normal[1] + end[2] * gate.normal[2];
+    if ((startSide < 0) == (endSide < 0))
+    {
+        return;
+    }
+
+    double t = startSide / (startSide - endSide);
+    double crossing[3];
+    for (int i = 0; i < 3; i++)
+    {
+        crossing[i] = start[i] + t * (end[i] - start[i]);
+    }
+    double distance = std::sqrt(crossing[0] * crossing[0] + crossing[1] * crossing[1] + crossing[2] * crossing[2]);
+
+    GateEvent event;
+    if (distance <= gate.radius)
+    {
+        event.type = GATE_PASSED;
+        passed++;
+    }
+    else if (distance <= gate.radius * GATE_MISS_RANGE)
+    {
+        event.type = GATE_MISSED;
+        missed++;
+    }
+    else
+    {
+        return;
+    }
+
+    event.id = id;
+    event.timestamp = fromTimestamp + static_cast<uint64_t>(std::llround(t * static_cast<double>(toTimestamp - fromTimestamp)));
+    event.missDistance = distance;
+    events.push_back(event);
+}
+
+GateStatistics GateDetector::getStatistics() const
+{
+    GateStatistics statistics;
+    statistics.gates = grid.size();
+    statistics.segments = segments;
+    statistics.candidates = testedCandidates;
+    statistics.passed = passed;
+    statistics.missed = missed;
+    statistics.averageTestTime = 0;
+    return statistics;
+}
\ No newline at end of file
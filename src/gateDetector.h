@@ -0,0 +1,206 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "worldPosition.h"
+#include "aircraftState.h"
+#include "indicatorGrid.h"
+
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstdint>
+
+/// Radius of the opening of the small ring model VFP_Circle_S (in m)
+#define GATE_RADIUS_SMALL 12.5
+
+/// Radius of the opening of the medium ring model VFP_Circle_M (in m)
+#define GATE_RADIUS_MEDIUM 25.0
+
+/// Radius of the opening of the large ring model VFP_Circle_L (in m)
+#define GATE_RADIUS_LARGE 50.0
+
+/// A crossing of the ring plane outside of the ring is reported as miss up to this multiple of the radius from its center
+#define GATE_MISS_RANGE 3.0
+
+/// Motion segments which are longer are not tested, e.g. after a pause or when the aircraft was moved by the user (in m)
+#define GATE_MAX_SEGMENT_LENGTH 1000.0
+
+/// <summary>
+/// Outcome of a passage of the ring plane.
+/// GATE_PASSED: the aircraft flew through the ring
+/// GATE_MISSED: the aircraft crossed the ring plane outside of the ring but within GATE_MISS_RANGE
+/// </summary>
+enum GateEventType { GATE_PASSED = 1, GATE_MISSED = 2 };
+
+/// <summary>
+/// A passage of the aircraft through the plane of a ring.
+/// </summary>
+struct GateEvent {
+    ushort id;             // external indicator id of the ring
+    GateEventType type;
+    uint64_t timestamp;    // monotonic time of the passage in microseconds, interpolated between the aircraft states
+    double missDistance;   // distance of the passage from the center of the ring in m
+};
+
+/// <summary>
+/// Snapshot of the counters of the gate detection.
+/// </summary>
+struct GateStatistics {
+    size_t gates;                       // rings which are tested
+    unsigned long long segments;        // tested motion segments between two aircraft states
+    unsigned long long candidates;      // rings near the segments which were tested
+    unsigned long long passed;          // GATE_PASSED events
+    unsigned long long missed;          // GATE_MISSED events
+    unsigned long long averageTestTime; // average time to test a segment in ns
+};
+
+/// <summary>
+/// Returns the radius of the opening of a ring model.
+/// </summary>
+/// <param name="modelName">Model name, e.g. VFP_Circle_M_blue</param>
+/// <returns>Radius in m or 0 if the model is not a ring</returns>
+double getGateRadius(const char* modelName);
+
+/// <summary>
+/// Detects when the aircraft flies through a ring indicator.
+///
+/// The rings are kept in their own grid. For each motion segment between two consecutive aircraft states, only the rings near the
+/// segment are looked up, so the cost does not depend on the total number of rings. The segment is tested against the plane of each
+/// ring, which is perpendicular to the longitudinal axis given by its heading and pitch. If the segment crosses the plane, the
+/// distance of the crossing point from the center decides whether the ring was passed or missed. The positions are converted into
+/// the local east-north-up frame of the ring, which is exact enough for the length of a segment.
+///
+/// The detector is not thread-safe.
+/// </summary>
+class GateDetector
+{
+public:
+    /// <summary>
+    /// Creates a detector without rings.
+    /// </summary>
+    GateDetector();
+
+    /// <summary>
+    /// Inserts or moves a ring. A radius of 0 removes the indicator, e.g. if it was replaced by another model.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="position">Position and orientation of the ring</param>
+    /// <param name="radius">Radius of the opening in m</param>
+    void update(ushort id, const WorldPositionStruct& position, double radius);
+
+    /// <summary>
+    /// Removes a ring.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    void remove(ushort id);
+
+    /// <summary>
+    /// Tests the segment from the previous aircraft state to the given one against the nearby rings. The first state and states after
+    /// a jump longer than GATE_MAX_SEGMENT_LENGTH only start a new segment.
+    /// </summary>
+    /// <param name="state">Current aircraft state</param>
+    /// <param name="timestamp">Monotonic time of the state in microseconds</param>
+    /// <returns>The passages in the order of the segment, valid until the next call</returns>
+    std::span<const GateEvent> addAircraftState(const AircraftStateStruct& state, uint64_t timestamp);
+
+    /// <summary>
+    /// Returns the current counters. The average test time is measured by the caller.
+    /// </summary>
+    /// <returns>Statistics of the gate detection</returns>
+    GateStatistics getStatistics() const;
+
+private:
+    /// <summary>
+    /// Plane and opening of a ring.
+    /// </summary>
+    struct Gate {
+        double latitude;
+        double longitude;
+        double altitude;  // in m
+        double normal[3]; // unit vector along the longitudinal axis in east-north-up
+        double radius;    // 0 if the indicator is not a ring
+    };
+
+    /// <summary>
+    /// Rings indexed by external indicator id.
+    /// </summary>
+    std::unique_ptr<Gate[]> gates;
+
+    /// <summary>
+    /// Positions of the rings.
+    /// </summary>
+    IndicatorGrid grid;
+
+    /// <summary>
+    /// Largest radius of all inserted rings, used to widen the query around a segment.
+    /// </summary>
+    double maxRadius = 0;
+
+    /// <summary>
+    /// Previous aircraft state, the start of the next segment.
+    /// </summary>
+    AircraftStateStruct previousState{};
+
+    /// <summary>
+    /// Time of the previous aircraft state in microseconds.
+    /// </summary>
+    uint64_t previousTimestamp = 0;
+
+    /// <summary>
+    /// False until the first aircraft state.
+    /// </summary>
+    bool hasPreviousState = false;
+
+    /// <summary>
+    /// Rings found by the query of the current segment, kept to avoid allocations.
+    /// </summary>
+    std::vector<IndicatorDistance> candidates;
+
+    /// <summary>
+    /// Passages of the current segment.
+    /// </summary>
+    std::vector<GateEvent> events;
+
+    /// <summary>
+    /// Number of tested segments.
+    /// </summary>
+    unsigned long long segments = 0;
+
+    /// <summary>
+    /// Number of tested rings.
+    /// </summary>
+    unsigned long long testedCandidates = 0;
+
+    /// <summary>
+    /// Number of GATE_PASSED events.
+    /// </summary>
+    unsigned long long passed = 0;
+
+    /// <summary>
+    /// Number of GATE_MISSED events.
+    /// </summary>
+    unsigned long long missed = 0;
+
+    /// <summary>
+    /// Tests the segment between the two states against one ring and appends the passage.
+    /// </summary>
+    void testGate(ushort id, const AircraftStateStruct& from, const AircraftStateStruct& to, uint64_t fromTimestamp, uint64_t toTimestamp);
+};
\ No newline at end of file
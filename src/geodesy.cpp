@@ -0,0 +1,110 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "geodesy.h"
+
+#include <cmath>
+#include <algorithm>
+
+double getGreatCircleDistance(double latitude1, double longitude1, double latitude2, double longitude2)
+{
+    double phi1 = latitude1 * DEGREES_TO_RADIANS;
+    double phi2 = latitude2 * DEGREES_TO_RADIANS;
+    double sinHalfLatitude = std::sin((phi2 - phi1) / 2);
+    double sinHalfLongitude = std::sin(getLongitudeDifference(longitude1, longitude2) * DEGREES_TO_RADIANS / 2);
+
+    double a = sinHalfLatitude * sinHalfLatitude + std::cos(phi1) * std::cos(phi2) * sinHalfLongitude * sinHalfLongitude;
+    return 2 * EARTH_MEAN_RADIUS * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+double getLongitudeDifference(double from, double to)
+{
+    double difference = std::fmod(to - from, 360.0);
+    if (difference > 180.0)
+    {
+        difference -= 360.0;
+    }
+    else if (difference < -180.0)
+    {
+        difference += 360.0;
+    }
+    return difference;
+}
+
+GeodeticPosition offsetGeodeticPosition(const GeodeticPosition& origin, double east, double north, double up)
+{
+    const double eccentricitySquared = WGS84_FLATTENING * (2 - WGS84_FLATTENING);
+    double phi = origin.latitude * DEGREES_TO_RADIANS;
+    double lambda = origin.longitude * DEGREES_TO_RADIANS;
+    double sinPhi = std::sin(phi);
+    double cosPhi = std::cos(phi);
+    double sinLambda = std::sin(lambda);
+    double cosLambda = std::cos(lambda);
+
+    // origin in earth-centered earth-fixed coordinates
+    double primeVerticalRadius = WGS84_SEMI_MAJOR_AXIS / std::sqrt(1 - eccentricitySquared * sinPhi * sinPhi);
+    double x = (primeVerticalRadius + origin.height) * cosPhi * cosLambda;
+    double y = (primeVerticalRadius + origin.height) * cosPhi * sinLambda;
+    double z = (primeVerticalRadius * (1 - eccentricitySquared) + origin.height) * sinPhi;
+
+    // plus the offset rotated from east-north-up
+    x += -sinLambda * east - sinPhi * cosLambda * north + cosPhi * cosLambda * up;
+    y += cosLambda * east - sinPhi * sinLambda * north + cosPhi * sinLambda * up;
+    z += cosPhi * north + sinPhi * up;
+
+    // back to geodetic coordinates, the iteration converges to below a millimeter within three steps near the surface
+    GeodeticPosition position;
+    double p = std::sqrt(x * x + y * y);
+    position.longitude = std::atan2(y, x) / DEGREES_TO_RADIANS;
+    phi = std::atan2(z, p * (1 - eccentricitySquared));
+    for (int i = 0; i < 3; i++)
+    {
+        sinPhi = std::sin(phi);
+        primeVerticalRadius = WGS84_SEMI_MAJOR_AXIS / std::sqrt(1 - eccentricitySquared * sinPhi * sinPhi);
+        phi = std::atan2(z + eccentricitySquared * primeVerticalRadius * sinPhi, p);
+    }
+    sinPhi = std::sin(phi);
+    cosPhi = std::cos(phi);
+    primeVerticalRadius = WGS84_SEMI_MAJOR_AXIS / std::sqrt(1 - eccentricitySquared * sinPhi * sinPhi);
+
+    // the height is taken along the axis which is better conditioned
+    position.height = std::fabs(cosPhi) > 0.5 ? p / cosPhi - primeVerticalRadius : z / sinPhi - primeVerticalRadius * (1 - eccentricitySquared);
+    position.latitude = phi / DEGREES_TO_RADIANS;
+    return position;
+}
+
+void rotateBodyToEnu(double heading, double pitch, double bank, double forward, double right, double up, double enu[3])
+{
+    // yaw, pitch (nose up positive) and roll (right wing down positive) of the aerospace convention
+    double psi = heading * DEGREES_TO_RADIANS;
+    double theta = -pitch * DEGREES_TO_RADIANS;
+    double phi = -bank * DEGREES_TO_RADIANS;
+    double sinPsi = std::sin(psi), cosPsi = std::cos(psi);
+    double sinTheta = std::sin(theta), cosTheta = std::cos(theta);
+    double sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+
+    // forward-right-down body frame to north-east-down
+    double down = -up;
+    double north = cosTheta * cosPsi * forward + (sinPhi * sinTheta * cosPsi - cosPhi * sinPsi) * right + (cosPhi * sinTheta * cosPsi + sinPhi * sinPsi) * down;
+    double east = cosTheta * sinPsi * forward + (sinPhi * sinTheta * sinPsi + cosPhi * cosPsi) * right + (cosPhi * sinTheta * sinPsi - sinPhi * cosPsi) * down;
+    double nedDown = -sinTheta * forward + sinPhi * cosTheta * right + cosPhi * cosTheta * down;
+
+    enu[0] = east;
+    enu[1] = north;
+    enu[2] = -nedDown;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/// Mean radius of the earth (in m)
+#define EARTH_MEAN_RADIUS 6371008.8
+
+/// Conversion factor from degrees to radians
+#define DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+
+/// Length of one foot (in m)
+#define METERS_PER_FOOT 0.3048
+
+/// Semi-major axis of the WGS84 ellipsoid (in m)
+#define WGS84_SEMI_MAJOR_AXIS 6378137.0
+
+/// Flattening of the WGS84 ellipsoid
+#define WGS84_FLATTENING (1.0 / 298.257223563)
+
+/// <summary>
+/// Position on the WGS84 ellipsoid.
+/// </summary>
+struct GeodeticPosition {
+    double latitude;  // in degrees
+    double longitude; // in degrees
+    double height;    // above the ellipsoid in m
+};
+
+/// <summary>
+/// Returns the great-circle distance between two positions (haversine formula).
+/// </summary>
+/// <param name="latitude1">Latitude of the first position in degrees</param>
+/// <param name="longitude1">Longitude of the first position in degrees</param>
+/// <param name="latitude2">Latitude of the second position in degrees</param>
+/// <param name="longitude2">Longitude of the second position in degrees</param>
+/// <returns>Distance in m</returns>
+double getGreatCircleDistance(double latitude1, double longitude1, double latitude2, double longitude2);
+
+/// <summary>
+/// Returns the difference between two longitudes in the range [-180, 180], taking the antimeridian into account.
+/// </summary>
+/// <param name="from">First longitude in degrees</param>
+/// <param name="to">Second longitude in degrees</param>
+/// <returns>to - from in degrees</returns>
+double getLongitudeDifference(double from, double to);
+
+/// <summary>
+/// Returns the position at the given offset in the local east-north-up frame of the origin. The offset is applied in earth-centered
+/// earth-fixed coordinates, so it is exact for any distance.
+/// </summary>
+/// <param name="origin">Origin of the local frame</param>
+/// <param name="east">Offset towards east in m</param>
+/// <param name="north">Offset towards north in m</param>
+/// <param name="up">Offset along the ellipsoid normal in m</param>
+/// <returns>Position at the offset</returns>
+GeodeticPosition offsetGeodeticPosition(const GeodeticPosition& origin, double east, double north, double up);
+
+/// <summary>
+/// Rotates an offset from the body frame of an aircraft into its local east-north-up frame. The angles follow SimConnect:
+/// the pitch is positive when the nose is down and the bank is positive when the left wing is down.
+/// </summary>
+/// <param name="heading">True heading in degrees</param>
+/// <param name="pitch">Pitch in degrees</param>
+/// <param name="bank">Bank in degrees</param>
+/// <param name="forward">Offset along the longitudinal axis in m</param>
+/// <param name="right">Offset along the lateral axis towards the right wing in m</param>
+/// <param name="up">Offset along the vertical axis towards the roof in m</param>
+/// <param name="enu">Receives the offset towards east, north and up in m</param>
+void rotateBodyToEnu(double heading, double pitch, double bank, double forward, double right, double up, double enu[3]);
\ No newline at end of file
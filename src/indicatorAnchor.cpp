@@ -0,0 +1,66 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorAnchor.h"
+#include "geodesy.h"
+
+#include <cmath>
+
+const char* getAnchorFrameName(AnchorFrame frame)
+{
+    switch (frame)
+    {
+    case ANCHOR_FRAME_BODY: return "body";
+    case ANCHOR_FRAME_ENU: return "enu";
+    }
+    return "unknown";
+}
+
+WorldPositionStruct resolveAnchor(const WorldPositionStruct& aircraft, AnchorFrame frame, const AnchorOffset& offset)
+{
+    double enu[3] = { offset.x, offset.y, offset.z };
+    if (frame == ANCHOR_FRAME_BODY)
+    {
+        rotateBodyToEnu(aircraft.heading, aircraft.pitch, aircraft.bank, offset.x, offset.y, offset.z, enu);
+    }
+
+    GeodeticPosition origin{ aircraft.latitude, aircraft.longitude, aircraft.altitude * METERS_PER_FOOT };
+    GeodeticPosition position = offsetGeodeticPosition(origin, enu[0], enu[1], enu[2]);
+
+    WorldPositionStruct result;
+    result.latitude = position.latitude;
+    result.longitude = position.longitude;
+    result.altitude = position.height / METERS_PER_FOOT;
+    if (frame == ANCHOR_FRAME_BODY)
+    {
+        result.heading = std::fmod(aircraft.heading + offset.heading, 360.0);
+        if (result.heading < 0)
+        {
+            result.heading += 360.0;
+        }
+        result.bank = aircraft.bank + offset.bank;
+        result.pitch = aircraft.pitch + offset.pitch;
+    }
+    else
+    {
+        result.heading = offset.heading;
+        result.bank = offset.bank;
+        result.pitch = offset.pitch;
+    }
+    return result;
+}
\ No newline at end of file
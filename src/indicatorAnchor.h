@@ -0,0 +1,59 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "worldPosition.h"
+
+/// <summary>
+/// Frame of the offset of an anchored indicator.
+/// </summary>
+enum AnchorFrame : ushort {
+    ANCHOR_FRAME_BODY = 0, // forward, right and up along the axes of the aircraft, the orientation is added to the one of the aircraft
+    ANCHOR_FRAME_ENU = 1,  // east, north and up at the aircraft position, the orientation is absolute
+};
+
+/// <summary>
+/// Position and orientation of an anchored indicator relative to the aircraft.
+/// </summary>
+struct AnchorOffset {
+    double x;       // forward (body) or east (ENU) in m
+    double y;       // right (body) or north (ENU) in m
+    double z;       // up in m
+    double heading; // in degrees
+    double bank;    // in degrees
+    double pitch;   // in degrees
+};
+
+/// <summary>
+/// Returns a short, stable name of the frame (e.g. "body").
+/// </summary>
+/// <param name="frame">The frame</param>
+/// <returns>Name of the frame</returns>
+const char* getAnchorFrameName(AnchorFrame frame);
+
+/// <summary>
+/// Calculates the world position of an indicator which is anchored to the aircraft. The offset is applied on the WGS84
+/// ellipsoid, the altitude of the aircraft is used as ellipsoidal height, which does not matter for the offset.
+/// </summary>
+/// <param name="aircraft">Position and orientation of the aircraft</param>
+/// <param name="frame">Frame of the offset</param>
+/// <param name="offset">Offset of the indicator</param>
+/// <returns>Position and orientation of the indicator</returns>
+WorldPositionStruct resolveAnchor(const WorldPositionStruct& aircraft, AnchorFrame frame, const AnchorOffset& offset);
\ No newline at end of file
@@ -0,0 +1,189 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorGrid.h"
+#include "geodesy.h"
+
+#include <cmath>
+#include <algorithm>
+
+/// Number of cells in longitude direction
+#define GRID_COLUMNS static_cast<long long>(360.0 / INDICATOR_GRID_CELL_SIZE)
+
+/// Number of cells in latitude direction
+#define GRID_ROWS static_cast<long long>(180.0 / INDICATOR_GRID_CELL_SIZE)
+
+/// Length of one degree latitude (in m)
+#define METERS_PER_DEGREE (EARTH_MEAN_RADIUS * DEGREES_TO_RADIANS)
+
+static long long getRow(double latitude)
+{
+    return std::clamp(static_cast<long long>(std::floor((latitude + 90.0) / INDICATOR_GRID_CELL_SIZE)), 0ll, GRID_ROWS - 1);
+}
+
+static long long getColumn(double longitude)
+{
+    long long column = static_cast<long long>(std::floor((longitude + 180.0) / INDICATOR_GRID_CELL_SIZE)) % GRID_COLUMNS;
+    return column < 0 ? column + GRID_COLUMNS : column;
+}
+
+static unsigned long long getCell(long long row, long long column)
+{
+    return static_cast<unsigned long long>(row * GRID_COLUMNS + column);
+}
+
+IndicatorGrid::IndicatorGrid()
+    : entries(new Entry[INDICATOR_REGISTRY_SIZE]())
+{
+}
+
+void IndicatorGrid::update(ushort id, double latitude, double longitude)
+{
+    Entry& entry = entries[id];
+    unsigned long long cell = getCell(getRow(latitude), getColumn(longitude));
+
+    entry.latitude = latitude;
+    entry.longitude = longitude;
+    if (entry.isUsed && entry.cell == cell)
+    {
+        return;
+    }
+
+    if (entry.isUsed)
+    {
+        removeFromCell(id);
+    }
+    else
+    {
+        entry.isUsed = true;
+        count++;
+    }
+
+    std::vector<ushort>& ids = cells[cell];
+    entry.cell = cell;
+    entry.index = static_cast<uint>(ids.size());
+    ids.push_back(id);
+}
+
+bool IndicatorGrid::remove(ushort id)
+{
+    if (!entries[id].isUsed)
+    {
+        return false;
+    }
+
+    removeFromCell(id);
+    entries[id].isUsed = false;
+    count--;
+    return true;
+}
+
+void IndicatorGrid::clear()
+{
+    for (std::pair<const unsigned long long, std::vector<ushort>>& cell : cells)
+    {
+        for (ushort id : cell.second)
+        {
+            entries[id].isUsed = false;
+        }
+    }
+    cells.clear();
+    count = 0;
+}
+
+bool IndicatorGrid::contains(ushort id) const
+{
+    return entries[id].isUsed;
+}
+
+size_t IndicatorGrid::size() const
+{
+    return count;
+}
+
+size_t IndicatorGrid::query(double latitude, double longitude, double radius, std::vector<IndicatorDistance>& result) const
+{
+    double latitudeRange = radius / METERS_PER_DEGREE;
+    long long firstRow = getRow(latitude - latitudeRange);
+    long long lastRow = getRow(latitude + latitudeRange);
+
+    // the columns become narrower towards the poles, the widest row of the box determines the range
+    double maxLatitude = std::min(89.0, std::max(std::fabs(latitude - latitudeRange), std::fabs(latitude + latitudeRange)));
+    double longitudeRange = latitudeRange / std::cos(maxLatitude * DEGREES_TO_RADIANS);
+    long long firstColumn = 0;
+    long long columnCount = GRID_COLUMNS;
+    if (longitudeRange < 180.0 && std::fabs(latitude) + latitudeRange < 89.0)
+    {
+        firstColumn = getColumn(longitude - longitudeRange);
+        columnCount = (getColumn(longitude + longitudeRange) - firstColumn + GRID_COLUMNS) % GRID_COLUMNS + 1;
+    }
+
+    size_t examined = 0;
+    if (static_cast<unsigned long long>((lastRow - firstRow + 1) * columnCount) > cells.size())
+    {
+        for (const std::pair<const unsigned long long, std::vector<ushort>>& cell : cells)
+        {
+            examined += queryCell(cell.second, latitude, longitude, radius, result);
+        }
+        return examined;
+    }
+
+    for (long long row = firstRow; row <= lastRow; row++)
+    {
+        for (long long i = 0; i < columnCount; i++)
+        {
+            std::unordered_map<unsigned long long, std::vector<ushort>>::const_iterator it = cells.find(getCell(row, (firstColumn + i) % GRID_COLUMNS));
+            if (it != cells.end())
+            {
+                examined += queryCell(it->second, latitude, longitude, radius, result);
+            }
+        }
+    }
+    return examined;
+}
+
+void IndicatorGrid::removeFromCell(ushort id)
+{
+    Entry& entry = entries[id];
+    std::unordered_map<unsigned long long, std::vector<ushort>>::iterator it = cells.find(entry.cell);
+    std::vector<ushort>& ids = it->second;
+
+    // the last indicator of the cell takes the place of the removed one
+    ushort last = ids.back();
+    ids[entry.index] = last;
+    entries[last].index = entry.index;
+    ids.pop_back();
+
+    if (ids.empty())
+    {
+        cells.erase(it);
+    }
+}
+
+size_t IndicatorGrid::queryCell(const std::vector<ushort>& ids, double latitude, double longitude, double radius, std::vector<IndicatorDistance>& result) const
+{
+    for (ushort id : ids)
+    {
+        double distance = getGreatCircleDistance(latitude, longitude, entries[id].latitude, entries[id].longitude);
+        if (distance <= radius)
+        {
+            result.push_back(IndicatorDistance{ id, distance });
+        }
+    }
+    return ids.size();
+}
\ No newline at end of file
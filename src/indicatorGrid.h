@@ -0,0 +1,136 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "indicatorRegistry.h"
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+/// Edge length of a grid cell (in degrees latitude and longitude)
+#define INDICATOR_GRID_CELL_SIZE 0.05
+
+/// <summary>
+/// Indicator found by a query of the grid.
+/// </summary>
+struct IndicatorDistance {
+    ushort id;
+    double distance; // great-circle distance to the query position in m
+};
+
+/// <summary>
+/// Spatial index of the indicator positions over latitude and longitude.
+///
+/// The globe is divided into cells of INDICATOR_GRID_CELL_SIZE degrees. Only cells which contain indicators are stored in a hash
+/// map, each with the ids of its indicators. Every indicator id owns a preallocated entry which remembers its cell and its index
+/// within the cell, so inserting, moving and removing an indicator is O(1). A radius query visits only the cells which overlap the
+/// bounding box of the circle, or all occupied cells if these are fewer.
+///
+/// The grid is not thread-safe.
+/// </summary>
+class IndicatorGrid
+{
+public:
+    /// <summary>
+    /// Creates an empty grid.
+    /// </summary>
+    IndicatorGrid();
+
+    /// <summary>
+    /// Inserts the indicator or moves it to the new position.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="latitude">Latitude in degrees</param>
+    /// <param name="longitude">Longitude in degrees</param>
+    void update(ushort id, double latitude, double longitude);
+
+    /// <summary>
+    /// Removes the indicator.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <returns>False if the indicator is not in the grid</returns>
+    bool remove(ushort id);
+
+    /// <summary>
+    /// Removes all indicators.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Returns true if the indicator is in the grid.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <returns>True if the indicator is in the grid</returns>
+    bool contains(ushort id) const;
+
+    /// <summary>
+    /// Returns the number of indicators in the grid.
+    /// </summary>
+    /// <returns>Number of indicators</returns>
+    size_t size() const;
+
+    /// <summary>
+    /// Appends all indicators within the radius around the position to the result, in no particular order.
+    /// </summary>
+    /// <param name="latitude">Latitude of the center in degrees</param>
+    /// <param name="longitude">Longitude of the center in degrees</param>
+    /// <param name="radius">Radius in m</param>
+    /// <param name="result">Receives the indicators and their distances</param>
+    /// <returns>Number of indicators whose distance was calculated, a measure for the cost of the query</returns>
+    size_t query(double latitude, double longitude, double radius, std::vector<IndicatorDistance>& result) const;
+
+private:
+    /// <summary>
+    /// Position of an indicator in the grid.
+    /// </summary>
+    struct Entry {
+        unsigned long long cell;
+        uint index; // index within the cell
+        bool isUsed;
+        double latitude;
+        double longitude;
+    };
+
+    /// <summary>
+    /// Entries indexed by external indicator id.
+    /// </summary>
+    std::unique_ptr<Entry[]> entries;
+
+    /// <summary>
+    /// Ids of the indicators in each occupied cell.
+    /// </summary>
+    std::unordered_map<unsigned long long, std::vector<ushort>> cells;
+
+    /// <summary>
+    /// Number of indicators in the grid.
+    /// </summary>
+    size_t count = 0;
+
+    /// <summary>
+    /// Removes the indicator from its cell.
+    /// </summary>
+    void removeFromCell(ushort id);
+
+    /// <summary>
+    /// Calculates the distance of all indicators of the cell and appends those within the radius.
+    /// </summary>
+    size_t queryCell(const std::vector<ushort>& ids, double latitude, double longitude, double radius, std::vector<IndicatorDistance>& result) const;
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorLod.h"
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+uint IndicatorLodGroup::selectLevel(double distance) const
+{
+    uint level = 0;
+    while (level + 1 < levels.size() && distance > levels[level].maxDistance)
+    {
+        level++;
+    }
+    return level;
+}
+
+uint IndicatorLodGroup::selectLevel(double distance, uint currentLevel) const
+{
+    // a farther level must be beyond its lower boundary plus the hysteresis, a nearer one below its upper boundary minus it
+    uint fartherLevel = selectLevel(distance / (1 + INDICATOR_LOD_HYSTERESIS));
+    if (fartherLevel > currentLevel)
+    {
+        return fartherLevel;
+    }
+
+    uint nearerLevel = selectLevel(distance / (1 - INDICATOR_LOD_HYSTERESIS));
+    if (nearerLevel < currentLevel)
+    {
+        return nearerLevel;
+    }
+
+    return std::min<uint>(currentLevel, static_cast<uint>(levels.size() - 1));
+}
+
+bool parseIndicatorLodGroup(const std::string& specification, IndicatorLodGroup* group)
+{
+    group->levels.clear();
+    size_t start = 0;
+
+    while (true)
+    {
+        size_t end = specification.find('|', start);
+        std::string level = specification.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        bool isLast = end == std::string::npos;
+
+        size_t distanceSeparator = level.find('@');
+        if (level.empty() || distanceSeparator == 0 || (distanceSeparator == std::string::npos) != isLast)
+        {
+            return false;
+        }
+
+        double maxDistance = std::numeric_limits<double>::infinity();
+        if (!isLast)
+        {
+            std::from_chars_result res = std::from_chars(level.data() + distanceSeparator + 1, level.data() + level.size(), maxDistance);
+            maxDistance *= 1000;
+            if (res.ec != std::errc() || res.ptr != level.data() + level.size() || maxDistance <= 0 ||
+                (!group->levels.empty() && maxDistance <= group->levels.back().maxDistance))
+            {
+                return false;
+            }
+            level.resize(distanceSeparator);
+        }
+
+        group->levels.push_back(IndicatorLodLevel{ level, maxDistance });
+        if (isLast)
+        {
+            break;
+        }
+        start = end + 1;
+    }
+
+    // a single model is no group
+    return group->levels.size() > 1;
+}
+
+size_t limitIndicatorLodSwaps(std::vector<IndicatorLodSwap>& swaps, size_t budget)
+{
+    auto isNearer = [](const IndicatorLodSwap& a, const IndicatorLodSwap& b) { return a.distance < b.distance; };
+    if (swaps.size() <= budget)
+    {
+        std::sort(swaps.begin(), swaps.end(), isNearer);
+        return 0;
+    }
+
+    std::partial_sort(swaps.begin(), swaps.begin() + budget, swaps.end(), isNearer);
+    size_t dropped = swaps.size() - budget;
+    swaps.resize(budget);
+    return dropped;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+
+#include <string>
+#include <vector>
+
+/// Minimum time between two updates of the levels of detail (in ms)
+#define INDICATOR_LOD_INTERVAL 250
+
+/// Relative distance beyond a level boundary which is needed to switch the level, so indicators at the boundary do not flicker
+/// between two models
+#define INDICATOR_LOD_HYSTERESIS 0.1
+
+/// Maximum number of indicators whose model is swapped in one update
+#define INDICATOR_LOD_SWAP_BUDGET 32
+
+/// <summary>
+/// One model of a level of detail group.
+/// </summary>
+struct IndicatorLodLevel {
+    /// <summary>
+    /// Model name of the level
+    /// </summary>
+    std::string modelName;
+
+    /// <summary>
+    /// Maximum distance to the aircraft in m up to which the level is used, infinity for the last level
+    /// </summary>
+    double maxDistance;
+};
+
+/// <summary>
+/// Models of a logical indicator ordered from near to far, e.g. a blue ring as small, medium and large torus.
+/// </summary>
+struct IndicatorLodGroup {
+    /// <summary>
+    /// Levels ordered by ascending maximum distance
+    /// </summary>
+    std::vector<IndicatorLodLevel> levels;
+
+    /// <summary>
+    /// Returns the level for the given distance.
+    /// </summary>
+    /// <param name="distance">Distance to the aircraft in m</param>
+    /// <returns>Index of the level</returns>
+    uint selectLevel(double distance) const;
+
+    /// <summary>
+    /// Returns the level for the given distance, starting from the current level. The level only changes if the distance is more
+    /// than INDICATOR_LOD_HYSTERESIS beyond the boundary.
+    /// </summary>
+    /// <param name="distance">Distance to the aircraft in m</param>
+    /// <param name="currentLevel">Index of the current level</param>
+    /// <returns>Index of the level</returns>
+    uint selectLevel(double distance, uint currentLevel) const;
+};
+
+/// <summary>
+/// Pending change of the level of an indicator.
+/// </summary>
+struct IndicatorLodSwap {
+    ushort id;
+    uint level;
+    double distance;
+};
+
+/// <summary>
+/// Snapshot of the counters of the level of detail switching.
+/// </summary>
+struct IndicatorLodStatistics {
+    size_t indicators;                 // placed indicators with a level of detail group
+    unsigned long long swaps;          // model swaps of resident indicators
+    unsigned long long deferredSwaps;  // swaps which exceeded the budget of an update and were postponed
+    unsigned long long updates;        // updates of the levels
+};
+
+/// <summary>
+/// Parses a level of detail group in the format "model@km|model@km|...|model", e.g.
+/// VFP_Circle_S_blue@2|VFP_Circle_M_blue@10|VFP_Circle_L_blue. The distances have to ascend, the last model has no distance.
+/// </summary>
+/// <param name="specification">Text to parse</param>
+/// <param name="group">Receives the parsed group</param>
+/// <returns>False if the text is invalid</returns>
+bool parseIndicatorLodGroup(const std::string& specification, IndicatorLodGroup* group);
+
+/// <summary>
+/// Keeps the nearest swaps up to the budget, ordered by distance.
+/// </summary>
+/// <param name="swaps">Pending swaps, shortened to the budget</param>
+/// <param name="budget">Maximum number of swaps</param>
+/// <returns>Number of swaps which were dropped</returns>
+size_t limitIndicatorLodSwaps(std::vector<IndicatorLodSwap>& swaps, size_t budget);
\ No newline at end of file
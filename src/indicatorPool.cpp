@@ -0,0 +1,211 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorPool.h"
+
+void IndicatorPool::configure(std::span<const IndicatorPoolSize> sizes)
+{
+    std::scoped_lock lk(mutex);
+
+    for (std::unique_ptr<Pool>& pool : pools)
+    {
+        pool->size = 0;
+    }
+
+    for (const IndicatorPoolSize& size : sizes)
+    {
+        Pool* pool = findPool(size.modelName);
+        if (pool == nullptr)
+        {
+            if (pools.size() > 0xFFFF)
+            {
+                continue; // the pool index has to fit into the request id
+            }
+
+            pools.push_back(std::make_unique<Pool>());
+            pool = pools.back().get();
+            pool->modelName = size.modelName;
+            poolIndices.insert({ pool->modelName, static_cast<uint>(pools.size() - 1) });
+        }
+        pool->size = size.size;
+    }
+}
+
+void IndicatorPool::setParkingPosition(double latitude, double longitude)
+{
+    std::scoped_lock lk(mutex);
+    parkingPosition.latitude = latitude;
+    parkingPosition.longitude = longitude;
+    hasParkingPosition = true;
+}
+
+WorldPositionStruct IndicatorPool::getParkingPosition() const
+{
+    std::scoped_lock lk(mutex);
+    return parkingPosition;
+}
+
+uint IndicatorPool::claim(const char* modelName)
+{
+    std::scoped_lock lk(mutex);
+
+    Pool* pool = findPool(modelName);
+    if (pool == nullptr || (pool->size == 0 && pool->parkedObjects.empty()))
+    {
+        return 0;
+    }
+
+    if (pool->parkedObjects.empty())
+    {
+        pool->misses++;
+        return 0;
+    }
+
+    uint simObjectID = pool->parkedObjects.back();
+    pool->parkedObjects.pop_back();
+    pool->hits++;
+    return simObjectID;
+}
+
+bool IndicatorPool::release(const char* modelName, uint simObjectID)
+{
+    std::scoped_lock lk(mutex);
+
+    Pool* pool = findPool(modelName);
+    if (pool == nullptr || pool->parkedObjects.size() >= static_cast<size_t>(pool->size) * INDICATOR_POOL_CAPACITY_FACTOR)
+    {
+        return false;
+    }
+
+    pool->parkedObjects.push_back(simObjectID);
+    pool->returned++;
+    return true;
+}
+
+size_t IndicatorPool::getRefills(std::chrono::steady_clock::time_point now, std::span<IndicatorPoolRefill> refills)
+{
+    std::scoped_lock lk(mutex);
+
+    if (!hasParkingPosition || pools.empty())
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < pools.size() && count < refills.size(); i++)
+    {
+        size_t index = (nextRefillPool + i) % pools.size();
+        Pool& pool = *pools[index];
+
+        // the simulation does not report failed create requests with their request id
+        if (pool.pending > 0 && now - pool.lastRequest > std::chrono::milliseconds(INDICATOR_POOL_CREATE_TIMEOUT))
+        {
+            pool.pending = 0;
+        }
+
+        while (pool.parkedObjects.size() + pool.pending < pool.size && count < refills.size())
+        {
+            refills[count++] = IndicatorPoolRefill{ INDICATOR_POOL_REQUEST_FLAG | static_cast<uint>(index), pool.modelName.c_str() };
+            pool.pending++;
+            pool.lastRequest = now;
+        }
+
+        if (count == refills.size())
+        {
+            nextRefillPool = index + 1;
+        }
+    }
+
+    return count;
+}
+
+bool IndicatorPool::addCreated(uint requestID, uint simObjectID)
+{
+    std::scoped_lock lk(mutex);
+
+    uint index = requestID & 0xFFFF;
+    if ((requestID & INDICATOR_POOL_REQUEST_FLAG) == 0 || index >= pools.size())
+    {
+        return false;
+    }
+
+    Pool& pool = *pools[index];
+    if (pool.pending > 0)
+    {
+        pool.pending--;
+    }
+
+    // the size may have been reduced in the meantime
+    if (pool.parkedObjects.size() >= pool.size)
+    {
+        return false;
+    }
+
+    pool.parkedObjects.push_back(simObjectID);
+    return true;
+}
+
+size_t IndicatorPool::takeSurplus(std::span<uint> simObjectIDs)
+{
+    std::scoped_lock lk(mutex);
+
+    size_t count = 0;
+    for (std::unique_ptr<Pool>& pool : pools)
+    {
+        size_t capacity = static_cast<size_t>(pool->size) * INDICATOR_POOL_CAPACITY_FACTOR;
+        while (pool->parkedObjects.size() > capacity && count < simObjectIDs.size())
+        {
+            simObjectIDs[count++] = pool->parkedObjects.back();
+            pool->parkedObjects.pop_back();
+        }
+    }
+    return count;
+}
+
+void IndicatorPool::clear()
+{
+    std::scoped_lock lk(mutex);
+
+    for (std::unique_ptr<Pool>& pool : pools)
+    {
+        pool->parkedObjects.clear();
+        pool->pending = 0;
+    }
+}
+
+std::vector<IndicatorPoolStatistics> IndicatorPool::getStatistics() const
+{
+    std::scoped_lock lk(mutex);
+
+    std::vector<IndicatorPoolStatistics> statistics;
+    for (const std::unique_ptr<Pool>& pool : pools)
+    {
+        if (pool->size != 0 || !pool->parkedObjects.empty())
+        {
+            statistics.push_back(IndicatorPoolStatistics{ pool->modelName, pool->size, pool->parkedObjects.size(), pool->pending,
+                pool->hits, pool->misses, pool->returned });
+        }
+    }
+    return statistics;
+}
+
+IndicatorPool::Pool* IndicatorPool::findPool(std::string_view modelName)
+{
+    std::unordered_map<std::string_view, uint>::iterator it = poolIndices.find(modelName);
+    return it == poolIndices.end() ? nullptr : pools[it->second].get();
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "worldPosition.h"
+#include "indicatorTypeTable.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+
+/// Marks the SimConnect request ids which create pooled SimObjects, the lower 16 bits contain the index of the pool.
+/// Other request ids stay below this value.
+#define INDICATOR_POOL_REQUEST_FLAG 0x40000000u
+
+/// Maximum number of SimObjects which are requested for all pools in one refill
+#define INDICATOR_POOL_REFILL_BATCH 16
+
+/// A pool keeps returned SimObjects up to this multiple of its size, further SimObjects are removed
+#define INDICATOR_POOL_CAPACITY_FACTOR 2
+
+/// Time after which a create request without assigned SimObject is considered as failed (in ms)
+#define INDICATOR_POOL_CREATE_TIMEOUT 5000
+
+/// Altitude of the parked SimObjects, below the terrain (in feet)
+#define INDICATOR_POOL_PARKING_ALTITUDE -1000.0
+
+/// <summary>
+/// Request to create a SimObject for a pool.
+/// </summary>
+struct IndicatorPoolRefill {
+    uint requestID;
+    const char* modelName; // valid as long as the IndicatorPool exists
+};
+
+/// <summary>
+/// Snapshot of the counters of a pool.
+/// </summary>
+struct IndicatorPoolStatistics {
+    std::string modelName;
+    uint size;                   // low-water mark
+    size_t parked;               // SimObjects which are ready to be claimed
+    uint pending;                // SimObjects which are being created
+    unsigned long long hits;     // SETs which claimed a parked SimObject
+    unsigned long long misses;   // SETs which found the pool empty and created a SimObject
+    unsigned long long returned; // removed indicators whose SimObject was parked again
+};
+
+/// <summary>
+/// Pools of parked SimObjects, one for each model with a configured pool size.
+///
+/// A new indicator claims a parked SimObject of its model and only has to move it, instead of waiting until the simulation has
+/// created a SimObject. Removed indicators return their SimObject to the pool. The pools are refilled up to their size by
+/// create requests with INDICATOR_POOL_REQUEST_FLAG, whose SimObjects are added when they are assigned.
+///
+/// Pools are never deleted, a model which is no longer configured keeps its pool with size 0, so the pool index in the request
+/// ids stays valid across reloads of the mapping. All methods are thread-safe.
+/// </summary>
+class IndicatorPool
+{
+public:
+    /// <summary>
+    /// Sets the sizes of the pools. Pools of models which are not in the list get the size 0.
+    /// </summary>
+    /// <param name="sizes">Size of each pooled model</param>
+    void configure(std::span<const IndicatorPoolSize> sizes);
+
+    /// <summary>
+    /// Sets the position near which the SimObjects are parked, e.g. the position of the user aircraft. Pools are not refilled
+    /// before a parking position is known.
+    /// </summary>
+    /// <param name="latitude">Latitude in degrees</param>
+    /// <param name="longitude">Longitude in degrees</param>
+    void setParkingPosition(double latitude, double longitude);
+
+    /// <summary>
+    /// Returns the position at which SimObjects are parked.
+    /// </summary>
+    /// <returns>Parking position</returns>
+    WorldPositionStruct getParkingPosition() const;
+
+    /// <summary>
+    /// Takes a parked SimObject of the given model.
+    /// </summary>
+    /// <param name="modelName">Name of the model</param>
+    /// <returns>Id of the SimObject or 0 if the model is not pooled or its pool is empty</returns>
+    uint claim(const char* modelName);
+
+    /// <summary>
+    /// Returns the SimObject of a removed indicator to the pool of its model.
+    /// </summary>
+    /// <param name="modelName">Name of the model</param>
+    /// <param name="simObjectID">Id of the SimObject</param>
+    /// <returns>True if the SimObject has to be parked, false if it has to be removed</returns>
+    bool release(const char* modelName, uint simObjectID);
+
+    /// <summary>
+    /// Determines the SimObjects which have to be created to fill the pools up to their size and marks them as pending.
+    /// </summary>
+    /// <param name="now">Current time, used to detect lost create requests</param>
+    /// <param name="refills">Receives the create requests</param>
+    /// <returns>Number of create requests, at most refills.size()</returns>
+    size_t getRefills(std::chrono::steady_clock::time_point now, std::span<IndicatorPoolRefill> refills);
+
+    /// <summary>
+    /// Adds a created SimObject to the pool of the request.
+    /// </summary>
+    /// <param name="requestID">Request id of the create request, see INDICATOR_POOL_REQUEST_FLAG</param>
+    /// <param name="simObjectID">Id of the created SimObject</param>
+    /// <returns>False if the SimObject is not needed anymore and has to be removed</returns>
+    bool addCreated(uint requestID, uint simObjectID);
+
+    /// <summary>
+    /// Takes the parked SimObjects which exceed the capacity of their pool, e.g. after the size of a pool was reduced.
+    /// </summary>
+    /// <param name="simObjectIDs">Receives the ids of the SimObjects which have to be removed</param>
+    /// <returns>Number of SimObjects, at most simObjectIDs.size()</returns>
+    size_t takeSurplus(std::span<uint> simObjectIDs);
+
+    /// <summary>
+    /// Forgets all parked and pending SimObjects, e.g. after the connection to the simulation was lost.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Returns the counters of all pools with a size or parked SimObjects.
+    /// </summary>
+    /// <returns>Statistics of the pools</returns>
+    std::vector<IndicatorPoolStatistics> getStatistics() const;
+
+private:
+    /// <summary>
+    /// Parked SimObjects of one model.
+    /// </summary>
+    struct Pool {
+        std::string modelName;
+        uint size = 0;
+        std::vector<uint> parkedObjects;
+        uint pending = 0;
+        std::chrono::steady_clock::time_point lastRequest;
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long returned = 0;
+    };
+
+    /// <summary>
+    /// Mutex for all members.
+    /// </summary>
+    mutable std::mutex mutex;
+
+    /// <summary>
+    /// Pools indexed by the pool index of the request ids. The pools are never moved, so the model names stay valid.
+    /// </summary>
+    std::vector<std::unique_ptr<Pool>> pools;
+
+    /// <summary>
+    /// Mapping model name -> pool index, the keys point to the model names of the pools.
+    /// </summary>
+    std::unordered_map<std::string_view, uint> poolIndices;
+
+    /// <summary>
+    /// Position at which the SimObjects are parked.
+    /// </summary>
+    WorldPositionStruct parkingPosition{ 0, 0, INDICATOR_POOL_PARKING_ALTITUDE, 0, 0, 0 };
+
+    /// <summary>
+    /// False until the parking position is set.
+    /// </summary>
+    bool hasParkingPosition = false;
+
+    /// <summary>
+    /// Pool which is refilled first next time, so a large pool does not starve the others.
+    /// </summary>
+    size_t nextRefillPool = 0;
+
+    /// <summary>
+    /// Returns the pool of the model.
+    /// </summary>
+    /// <param name="modelName">Name of the model</param>
+    /// <returns>The pool or nullptr if the model has none</returns>
+    Pool* findPool(std::string_view modelName);
+};
\ No newline at end of file
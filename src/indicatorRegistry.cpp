@@ -0,0 +1,167 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorRegistry.h"
+
+#define GENERATION_MASK ((1u << INDICATOR_GENERATION_BITS) - 1)
+
+static unsigned long long packSlot(IndicatorSlotState state, uint generation, uint simObjectID)
+{
+    return (static_cast<unsigned long long>(state) << 56) |
+        (static_cast<unsigned long long>(generation & GENERATION_MASK) << 32) |
+        simObjectID;
+}
+
+static IndicatorSlotState getSlotState(unsigned long long slot)
+{
+    return static_cast<IndicatorSlotState>(slot >> 56);
+}
+
+static uint getSlotGeneration(unsigned long long slot)
+{
+    return static_cast<uint>(slot >> 32) & GENERATION_MASK;
+}
+
+static uint getSlotSimObject(unsigned long long slot)
+{
+    return static_cast<uint>(slot);
+}
+
+IndicatorRegistry::IndicatorRegistry()
+    : slots(new std::atomic<unsigned long long>[INDICATOR_REGISTRY_SIZE])
+{
+    for (size_t i = 0; i < INDICATOR_REGISTRY_SIZE; i++)
+    {
+        slots[i].store(packSlot(INDICATOR_SLOT_FREE, 0, 0), std::memory_order_relaxed);
+    }
+}
+
+IndicatorCreateRequest IndicatorRegistry::beginCreate(ushort indicatorID)
+{
+    std::atomic<unsigned long long>& slot = slots[indicatorID];
+    unsigned long long current = slot.load(std::memory_order_acquire);
+    unsigned long long next;
+
+    do
+    {
+        next = packSlot(INDICATOR_SLOT_PENDING, getSlotGeneration(current) + 1, 0);
+    } while (!slot.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    IndicatorCreateRequest request;
+    request.requestID = INDICATOR_CREATE_REQUEST_FLAG | (getSlotGeneration(next) << 16) | indicatorID;
+    request.previousSimObjectID = getSlotState(current) == INDICATOR_SLOT_ACTIVE ? getSlotSimObject(current) : 0;
+    return request;
+}
+
+IndicatorAssignResult IndicatorRegistry::assignSimObject(uint requestID, uint simObjectID)
+{
+    if ((requestID & INDICATOR_CREATE_REQUEST_FLAG) == 0)
+    {
+        return INDICATOR_ASSIGN_UNKNOWN;
+    }
+
+    ushort indicatorID = static_cast<ushort>(requestID);
+    uint generation = (requestID >> 16) & GENERATION_MASK;
+
+    std::atomic<unsigned long long>& slot = slots[indicatorID];
+    unsigned long long expected = packSlot(INDICATOR_SLOT_PENDING, generation, 0);
+
+    // fails if the indicator was placed again or removed after the request was sent
+    if (!slot.compare_exchange_strong(expected, packSlot(INDICATOR_SLOT_ACTIVE, generation, simObjectID), std::memory_order_acq_rel))
+    {
+        staleAssignments.fetch_add(1, std::memory_order_relaxed);
+        return INDICATOR_ASSIGN_STALE;
+    }
+
+    return INDICATOR_ASSIGN_OK;
+}
+
+bool IndicatorRegistry::remove(ushort indicatorID, uint& simObjectID)
+{
+    std::atomic<unsigned long long>& slot = slots[indicatorID];
+    unsigned long long current = slot.load(std::memory_order_acquire);
+
+    do
+    {
+        if (getSlotState(current) == INDICATOR_SLOT_FREE)
+        {
+            simObjectID = 0;
+            return false;
+        }
+    } while (!slot.compare_exchange_weak(current, packSlot(INDICATOR_SLOT_FREE, getSlotGeneration(current) + 1, 0),
+        std::memory_order_acq_rel, std::memory_order_acquire));
+
+    simObjectID = getSlotState(current) == INDICATOR_SLOT_ACTIVE ? getSlotSimObject(current) : 0;
+    return true;
+}
+
+void IndicatorRegistry::clear()
+{
+    for (size_t i = 0; i < INDICATOR_REGISTRY_SIZE; i++)
+    {
+        uint simObjectID;
+        remove(static_cast<ushort>(i), simObjectID);
+    }
+}
+
+uint IndicatorRegistry::getSimObject(ushort indicatorID) const
+{
+    unsigned long long slot = slots[indicatorID].load(std::memory_order_acquire);
+    return getSlotState(slot) == INDICATOR_SLOT_ACTIVE ? getSlotSimObject(slot) : 0;
+}
+
+IndicatorSlotState IndicatorRegistry::getState(ushort indicatorID) const
+{
+    return getSlotState(slots[indicatorID].load(std::memory_order_acquire));
+}
+
+std::vector<ushort> IndicatorRegistry::getUsedIndicatorIDs() const
+{
+    std::vector<ushort> ids;
+
+    for (size_t i = 0; i < INDICATOR_REGISTRY_SIZE; i++)
+    {
+        if (getSlotState(slots[i].load(std::memory_order_relaxed)) != INDICATOR_SLOT_FREE)
+        {
+            ids.push_back(static_cast<ushort>(i));
+        }
+    }
+
+    return ids;
+}
+
+IndicatorRegistryStatistics IndicatorRegistry::getStatistics() const
+{
+    IndicatorRegistryStatistics statistics{};
+
+    for (size_t i = 0; i < INDICATOR_REGISTRY_SIZE; i++)
+    {
+        IndicatorSlotState state = getSlotState(slots[i].load(std::memory_order_relaxed));
+        if (state == INDICATOR_SLOT_PENDING)
+        {
+            statistics.pending++;
+        }
+        else if (state == INDICATOR_SLOT_ACTIVE)
+        {
+            statistics.active++;
+        }
+    }
+    statistics.staleAssignments = staleAssignments.load(std::memory_order_relaxed);
+
+    return statistics;
+}
\ No newline at end of file
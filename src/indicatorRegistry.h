@@ -0,0 +1,157 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// Number of slots of the registry, one for each possible external indicator id
+#define INDICATOR_REGISTRY_SIZE 65536
+
+/// Marks the SimConnect request ids which create indicators, other request ids stay below this value
+#define INDICATOR_CREATE_REQUEST_FLAG 0x80000000u
+
+/// Number of generation bits which are encoded in a create request id
+#define INDICATOR_GENERATION_BITS 15
+
+/// <summary>
+/// State of an indicator slot.
+/// </summary>
+enum IndicatorSlotState : uchar {
+    INDICATOR_SLOT_FREE,
+    INDICATOR_SLOT_PENDING, // SimObject requested, id not assigned yet
+    INDICATOR_SLOT_ACTIVE,  // SimObject exists
+};
+
+/// <summary>
+/// Result of assigning a SimObject to a create request.
+/// </summary>
+enum IndicatorAssignResult {
+    INDICATOR_ASSIGN_OK,
+    INDICATOR_ASSIGN_STALE,   // the indicator was replaced or removed in the meantime, the SimObject has to be removed
+    INDICATOR_ASSIGN_UNKNOWN, // the request id does not belong to a create request
+};
+
+/// <summary>
+/// Create request for an indicator.
+/// </summary>
+struct IndicatorCreateRequest {
+    /// <summary>
+    /// Request id which has to be used to create the SimObject.
+    /// </summary>
+    uint requestID;
+
+    /// <summary>
+    /// SimObject which represented the indicator before and has to be removed, 0 if there is none.
+    /// </summary>
+    uint previousSimObjectID;
+};
+
+/// <summary>
+/// Snapshot of the registry counters.
+/// </summary>
+struct IndicatorRegistryStatistics {
+    size_t pending;
+    size_t active;
+    unsigned long long staleAssignments;
+};
+
+/// <summary>
+/// Mapping external indicator id -> SimObject for all 65536 indicator ids.
+///
+/// Each id owns a preallocated slot of 8 bytes which packs the SimObject id, a generation and the state, so every transition
+/// is a single compare-and-swap and lookups need neither locks nor hashing. The generation is increased whenever an indicator is
+/// placed or removed and is encoded together with the indicator id in the request id of the create request. Thereby the SimObject
+/// id delivered for an outdated request is detected and can be removed instead of being lost.
+/// </summary>
+class IndicatorRegistry
+{
+public:
+    /// <summary>
+    /// Creates a registry with all slots free.
+    /// </summary>
+    IndicatorRegistry();
+
+    /// <summary>
+    /// Marks the indicator as pending and returns the request id for creating its SimObject.
+    /// </summary>
+    /// <param name="indicatorID">External indicator id</param>
+    /// <returns>Request id and the SimObject which is replaced</returns>
+    IndicatorCreateRequest beginCreate(ushort indicatorID);
+
+    /// <summary>
+    /// Assigns the created SimObject to the indicator of the create request.
+    /// </summary>
+    /// <param name="requestID">Request id which was used to create the SimObject</param>
+    /// <param name="simObjectID">Id of the created SimObject</param>
+    /// <returns>INDICATOR_ASSIGN_OK if the indicator is active now</returns>
+    IndicatorAssignResult assignSimObject(uint requestID, uint simObjectID);
+
+    /// <summary>
+    /// Frees the slot of the indicator.
+    /// </summary>
+    /// <param name="indicatorID">External indicator id</param>
+    /// <param name="simObjectID">Receives the SimObject which has to be removed, 0 if it was not created yet</param>
+    /// <returns>False if the indicator is unknown</returns>
+    bool remove(ushort indicatorID, uint& simObjectID);
+
+    /// <summary>
+    /// Frees all slots without returning the SimObjects, e.g. after the connection to the simulation was lost.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Returns the SimObject of the indicator.
+    /// </summary>
+    /// <param name="indicatorID">External indicator id</param>
+    /// <returns>SimObject id or 0 if the indicator is not active</returns>
+    uint getSimObject(ushort indicatorID) const;
+
+    /// <summary>
+    /// Returns the state of the indicator.
+    /// </summary>
+    /// <param name="indicatorID">External indicator id</param>
+    /// <returns>State of the slot</returns>
+    IndicatorSlotState getState(ushort indicatorID) const;
+
+    /// <summary>
+    /// Returns the ids of all pending and active indicators.
+    /// </summary>
+    /// <returns>List with external indicator ids</returns>
+    std::vector<ushort> getUsedIndicatorIDs() const;
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <returns>Statistics of the registry</returns>
+    IndicatorRegistryStatistics getStatistics() const;
+
+private:
+    /// <summary>
+    /// Slots indexed by external indicator id. Layout: bits 0-31 SimObject id, bits 32-47 generation, bits 56-63 state.
+    /// </summary>
+    std::unique_ptr<std::atomic<unsigned long long>[]> slots;
+
+    /// <summary>
+    /// Number of SimObjects which were assigned to outdated requests.
+    /// </summary>
+    std::atomic<unsigned long long> staleAssignments{ 0 };
+};
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorTypeTable.h"
+
+#include <string>
+#include <charconv>
+#include <algorithm>
+
+std::shared_ptr<const IndicatorTypeTable> IndicatorTypeTable::parse(std::istream& input, std::vector<std::string>* invalidLines)
+{
+    std::shared_ptr<IndicatorTypeTable> table = std::make_shared<IndicatorTypeTable>();
+    std::string row;
+
+    while (std::getline(input, row))
+    {
+        // files with Windows line endings
+        if (!row.empty() && row.back() == '\r')
+        {
+            row.pop_back();
+        }
+
+        if (row.empty())
+        {
+            continue;
+        }
+
+        size_t separator = row.find('=');
+        uint indicatorTypeID = 0;
+        std::from_chars_result res = std::from_chars(row.data(), row.data() + std::min(separator, row.size()), indicatorTypeID);
+
+        if (separator == std::string::npos || separator == 0 || separator + 1 == row.size() ||
+            res.ec != std::errc() || res.ptr != row.data() + separator ||
+            row.find('=', separator + 1) != std::string::npos)
+        {
+            if (invalidLines != nullptr)
+            {
+                invalidLines->push_back(row);
+            }
+            continue;
+        }
+
+        // optional pool size after the model name
+        std::string name = row.substr(separator + 1);
+        uint poolSize = 0;
+        size_t poolSeparator = name.find(',');
+        if (poolSeparator != std::string::npos)
+        {
+            res = std::from_chars(name.data() + poolSeparator + 1, name.data() + name.size(), poolSize);
+            if (poolSeparator == 0 || poolSeparator + 1 == name.size() || res.ec != std::errc() || res.ptr != name.data() + name.size())
+            {
+                if (invalidLines != nullptr)
+                {
+                    invalidLines->push_back(row);
+                }
+                continue;
+            }
+            name.resize(poolSeparator);
+        }
+
+        if (name.find('|') != std::string::npos)
+        {
+            std::shared_ptr<IndicatorLodGroup> group = std::make_shared<IndicatorLodGroup>();
+            if (!parseIndicatorLodGroup(name, group.get()))
+            {
+                if (invalidLines != nullptr)
+                {
+                    invalidLines->push_back(row);
+                }
+                continue;
+            }
+            table->addLodGroup(indicatorTypeID, std::move(group), poolSize);
+            continue;
+        }
+
+        table->add(indicatorTypeID, name, poolSize);
+    }
+
+    return table;
+}
+
+bool IndicatorTypeTable::add(uint indicatorTypeID, const std::string& name, uint poolSize)
+{
+    const char* internedName = internedNames.insert(name).first->c_str();
+    bool isAdded = false;
+
+    if (indicatorTypeID < INDICATOR_TYPE_DENSE_LIMIT)
+    {
+        if (denseNames[indicatorTypeID] == nullptr)
+        {
+            denseNames[indicatorTypeID] = internedName;
+            isAdded = true;
+        }
+    }
+    else
+    {
+        isAdded = sparseNames.insert({ indicatorTypeID, internedName }).second;
+    }
+
+    if (!isAdded)
+    {
+        return false;
+    }
+
+    mappingCount++;
+    addPoolSize(internedName, poolSize);
+    return true;
+}
+
+void IndicatorTypeTable::addLodGroup(uint indicatorTypeID, std::shared_ptr<const IndicatorLodGroup> group, uint poolSize)
+{
+    // the nearest model is the mapping of the id, so indicators can be placed before the aircraft position is known
+    if (!add(indicatorTypeID, group->levels.front().modelName, poolSize))
+    {
+        return;
+    }
+
+    for (size_t i = 1; i < group->levels.size(); i++)
+    {
+        addPoolSize(internedNames.insert(group->levels[i].modelName).first->c_str(), poolSize);
+    }
+    lodGroups.insert({ indicatorTypeID, std::move(group) });
+}
+
+void IndicatorTypeTable::addPoolSize(const char* internedName, uint poolSize)
+{
+    if (poolSize > 0)
+    {
+        uint& size = poolSizes[internedName];
+        size = std::max(size, poolSize);
+    }
+}
+
+size_t IndicatorTypeTable::size() const
+{
+    return mappingCount;
+}
+
+std::vector<uint> IndicatorTypeTable::getIndicatorTypeIDs() const
+{
+    std::vector<uint> ids;
+    ids.reserve(mappingCount);
+
+    for (uint i = 0; i < INDICATOR_TYPE_DENSE_LIMIT; i++)
+    {
+        if (denseNames[i] != nullptr)
+        {
+            ids.push_back(i);
+        }
+    }
+
+    for (const std::pair<const uint, const char*>& entry : sparseNames)
+    {
+        ids.push_back(entry.first);
+    }
+
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<IndicatorPoolSize> IndicatorTypeTable::getPoolSizes() const
+{
+    std::vector<IndicatorPoolSize> sizes;
+    sizes.reserve(poolSizes.size());
+
+    for (const std::pair<const char* const, uint>& entry : poolSizes)
+    {
+        sizes.push_back(IndicatorPoolSize{ entry.first, entry.second });
+    }
+
+    std::sort(sizes.begin(), sizes.end(), [](const IndicatorPoolSize& a, const IndicatorPoolSize& b) { return a.modelName < b.modelName; });
+    return sizes;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "indicatorLod.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <unordered_map>
+#include <unordered_set>
+
+/// Indicator type ids below this limit are stored in a directly indexed array, larger ids in a hash map
+#define INDICATOR_TYPE_DENSE_LIMIT 256
+
+/// <summary>
+/// Configured number of pre-created SimObjects of a model.
+/// </summary>
+struct IndicatorPoolSize {
+    std::string modelName;
+    uint size;
+};
+
+/// <summary>
+/// Immutable mapping indicator type id -> model name.
+///
+/// Each line has the format "id=model name" or "id=model name,pool size". The pool size is the number of SimObjects of the
+/// model which are created in advance, see IndicatorPool. Instead of a single model name a level of detail group
+/// "model@km|model@km|...|model" can be given, its pool size applies to each of its models.
+///
+/// Each model name is stored once (interned) and the lookup returns a pointer to it, so no string is copied.
+/// The pointers stay valid as long as the table exists. A table is shared as std::shared_ptr snapshot, so a new
+/// table can be published while other threads still use the old one.
+/// </summary>
+class IndicatorTypeTable
+{
+public:
+    /// <summary>
+    /// Parses the mapping in the format of indicators.properties ("id=model name[,pool size]" or "id=level of detail group[,pool size]"
+    /// per line).
+    /// </summary>
+    /// <param name="input">The content of the mapping file</param>
+    /// <param name="invalidLines">Receives the lines which could not be parsed, may be nullptr</param>
+    /// <returns>The parsed table</returns>
+    static std::shared_ptr<const IndicatorTypeTable> parse(std::istream& input, std::vector<std::string>* invalidLines);
+
+    /// <summary>
+    /// Returns the model name for the given indicator type id.
+    /// </summary>
+    /// <param name="indicatorTypeID">Requested indicator type id</param>
+    /// <returns>Model name or nullptr if the indicator type id is not mapped</returns>
+    const char* getName(uint indicatorTypeID) const
+    {
+        if (indicatorTypeID < INDICATOR_TYPE_DENSE_LIMIT)
+        {
+            return denseNames[indicatorTypeID];
+        }
+
+        std::unordered_map<uint, const char*>::const_iterator it = sparseNames.find(indicatorTypeID);
+        return it == sparseNames.end() ? nullptr : it->second;
+    }
+
+    /// <summary>
+    /// Returns the level of detail group of the given indicator type id. The group stays valid after the table is replaced.
+    /// </summary>
+    /// <param name="indicatorTypeID">Requested indicator type id</param>
+    /// <returns>The group or nullptr if the indicator type id is mapped to a single model or not mapped</returns>
+    std::shared_ptr<const IndicatorLodGroup> getLodGroup(uint indicatorTypeID) const
+    {
+        if (lodGroups.empty())
+        {
+            return nullptr;
+        }
+
+        std::unordered_map<uint, std::shared_ptr<const IndicatorLodGroup>>::const_iterator it = lodGroups.find(indicatorTypeID);
+        return it == lodGroups.end() ? nullptr : it->second;
+    }
+
+    /// <summary>
+    /// Returns the number of mapped indicator type ids.
+    /// </summary>
+    /// <returns>Number of mappings</returns>
+    size_t size() const;
+
+    /// <summary>
+    /// Returns all mapped indicator type ids in ascending order.
+    /// </summary>
+    /// <returns>List of indicator type ids</returns>
+    std::vector<uint> getIndicatorTypeIDs() const;
+
+    /// <summary>
+    /// Returns the pool sizes of all models with a pool size greater than 0, sorted by model name. If a model is used by several
+    /// indicator types, the largest size is taken.
+    /// </summary>
+    /// <returns>List of pool sizes</returns>
+    std::vector<IndicatorPoolSize> getPoolSizes() const;
+
+private:
+    /// <summary>
+    /// Model names of the ids below INDICATOR_TYPE_DENSE_LIMIT, nullptr if not mapped.
+    /// </summary>
+    const char* denseNames[INDICATOR_TYPE_DENSE_LIMIT] = {};
+
+    /// <summary>
+    /// Model names of the ids above INDICATOR_TYPE_DENSE_LIMIT.
+    /// </summary>
+    std::unordered_map<uint, const char*> sparseNames;
+
+    /// <summary>
+    /// Storage of the model names. The elements are never moved, so the pointers into them stay valid.
+    /// </summary>
+    std::unordered_set<std::string> internedNames;
+
+    /// <summary>
+    /// Pool sizes by model name, the keys point into internedNames.
+    /// </summary>
+    std::unordered_map<const char*, uint> poolSizes;
+
+    /// <summary>
+    /// Level of detail groups by indicator type id. getName returns the nearest model of a group.
+    /// </summary>
+    std::unordered_map<uint, std::shared_ptr<const IndicatorLodGroup>> lodGroups;
+
+    /// <summary>
+    /// Number of mappings.
+    /// </summary>
+    size_t mappingCount = 0;
+
+    /// <summary>
+    /// Adds the mapping for the given id. If the id is already mapped, the first mapping is kept.
+    /// </summary>
+    /// <returns>False if the id was already mapped</returns>
+    bool add(uint indicatorTypeID, const std::string& name, uint poolSize);
+
+    /// <summary>
+    /// Adds the level of detail group for the given id. If the id is already mapped, the first mapping is kept.
+    /// </summary>
+    void addLodGroup(uint indicatorTypeID, std::shared_ptr<const IndicatorLodGroup> group, uint poolSize);
+
+    /// <summary>
+    /// Raises the pool size of the given model to at least the given size.
+    /// </summary>
+    void addPoolSize(const char* internedName, uint poolSize);
+};
\ No newline at end of file
@@ -0,0 +1,272 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorTypeTableWatcher.h"
+#include "log.h"
+
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#include "windows.h"
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+void IndicatorTypeTableWatcher::start(const std::string& path, PublishCallback publish)
+{
+    this->path = path;
+    this->publish = publish;
+
+    // the first table is loaded synchronously, so it is available before the first command arrives
+    loadedStamp = readFileStamp();
+    publish(load(path));
+
+    isRunning = true;
+    watcherThread = std::thread(&IndicatorTypeTableWatcher::run, this);
+}
+
+void IndicatorTypeTableWatcher::stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(wakeUpMutex);
+        isRunning = false;
+    }
+    wakeUp.notify_all();
+
+    if (watcherThread.joinable())
+    {
+        watcherThread.join();
+    }
+}
+
+void IndicatorTypeTableWatcher::requestReload()
+{
+    {
+        std::lock_guard<std::mutex> lk(wakeUpMutex);
+        reloadRequested = true;
+    }
+    wakeUp.notify_all();
+}
+
+unsigned long long IndicatorTypeTableWatcher::getReloadCount() const
+{
+    return reloadCount.load(std::memory_order_relaxed);
+}
+
+unsigned long long IndicatorTypeTableWatcher::getRejectedReloadCount() const
+{
+    return rejectedReloadCount.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<const IndicatorTypeTable> IndicatorTypeTableWatcher::load(const std::string& path)
+{
+    std::ifstream indicatorMappingFile(path);
+
+    if (!indicatorMappingFile.good())
+    {
+        Logger::logError("Indicator mappings could not be loaded.");
+        return nullptr;
+    }
+
+    std::vector<std::string> invalidLines;
+    std::shared_ptr<const IndicatorTypeTable> table = IndicatorTypeTable::parse(indicatorMappingFile, &invalidLines);
+
+    for (const std::string& row : invalidLines)
+    {
+        Logger::logWarning("Invalid indicator mapping: " + row);
+    }
+
+    return table;
+}
+
+void IndicatorTypeTableWatcher::run()
+{
+    if (!runNotificationLoop())
+    {
+        Logger::logWarning("File change notifications are not available, " + path + " is polled for changes.");
+        runPollingLoop();
+    }
+}
+
+void IndicatorTypeTableWatcher::runPollingLoop()
+{
+    while (isRunning)
+    {
+        reloadIfChanged();
+        waitFor(std::chrono::milliseconds(INDICATOR_MAPPING_POLL_INTERVAL));
+    }
+}
+
+void IndicatorTypeTableWatcher::waitFor(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lk(wakeUpMutex);
+    wakeUp.wait_for(lk, timeout, [this] { return !isRunning || reloadRequested; });
+}
+
+void IndicatorTypeTableWatcher::reloadIfChanged()
+{
+    bool forced = reloadRequested.exchange(false);
+    FileStamp stamp = readFileStamp();
+
+    if (!forced && stamp == loadedStamp)
+    {
+        return;
+    }
+    loadedStamp = stamp;
+
+    // the old table stays published until the new one is completely parsed and validated
+    std::shared_ptr<const IndicatorTypeTable> table = load(path);
+    if (table == nullptr || table->size() == 0)
+    {
+        rejectedReloadCount.fetch_add(1, std::memory_order_relaxed);
+        Logger::logWarning("Indicator mappings were not reloaded, the previous mappings are still used.");
+        return;
+    }
+
+    publish(table);
+    reloadCount.fetch_add(1, std::memory_order_relaxed);
+    Logger::logInfo("Indicator mappings reloaded: " + std::to_string(table->size()) + " indicator types.");
+}
+
+IndicatorTypeTableWatcher::FileStamp IndicatorTypeTableWatcher::readFileStamp() const
+{
+    FileStamp stamp;
+    std::error_code error;
+
+    stamp.lastWriteTime = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        return FileStamp();
+    }
+    stamp.size = std::filesystem::file_size(path, error);
+    stamp.exists = !error;
+
+    return stamp;
+}
+
+#ifdef _WIN32
+
+bool IndicatorTypeTableWatcher::runNotificationLoop()
+{
+    std::filesystem::path directory = std::filesystem::absolute(path).parent_path();
+
+    // notifications are delivered for the whole directory, the file stamp filters out changes of other files
+    HANDLE changeHandle = FindFirstChangeNotificationW(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (changeHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    while (isRunning)
+    {
+        DWORD res = WaitForSingleObject(changeHandle, INDICATOR_MAPPING_WATCH_TIMEOUT);
+
+        if (res == WAIT_OBJECT_0)
+        {
+            waitFor(std::chrono::milliseconds(INDICATOR_MAPPING_SETTLE_TIME));
+            if (!FindNextChangeNotification(changeHandle))
+            {
+                FindCloseChangeNotification(changeHandle);
+                return false;
+            }
+            reloadIfChanged();
+        }
+        else if (res == WAIT_TIMEOUT)
+        {
+            if (reloadRequested)
+            {
+                reloadIfChanged();
+            }
+        }
+        else
+        {
+            FindCloseChangeNotification(changeHandle);
+            return false;
+        }
+    }
+
+    FindCloseChangeNotification(changeHandle);
+    return true;
+}
+
+#elif defined(__linux__)
+
+bool IndicatorTypeTableWatcher::runNotificationLoop()
+{
+    std::filesystem::path directory = std::filesystem::absolute(path).parent_path();
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // the directory is watched, because editors often replace the file instead of writing to it
+    if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    alignas(struct inotify_event) char events[4096];
+    struct pollfd pfd { fd, POLLIN, 0 };
+
+    while (isRunning)
+    {
+        int res = poll(&pfd, 1, INDICATOR_MAPPING_WATCH_TIMEOUT);
+
+        if (res > 0)
+        {
+            waitFor(std::chrono::milliseconds(INDICATOR_MAPPING_SETTLE_TIME));
+            while (read(fd, events, sizeof(events)) > 0)
+            {
+                // drain all pending events, they are handled by one reload
+            }
+            reloadIfChanged();
+        }
+        else if (res == 0)
+        {
+            if (reloadRequested)
+            {
+                reloadIfChanged();
+            }
+        }
+        else if (errno != EINTR)
+        {
+            close(fd);
+            return false;
+        }
+    }
+
+    close(fd);
+    return true;
+}
+
+#else
+
+bool IndicatorTypeTableWatcher::runNotificationLoop()
+{
+    return false;
+}
+
+#endif
\ No newline at end of file
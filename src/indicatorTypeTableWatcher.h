@@ -0,0 +1,195 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "indicatorTypeTable.h"
+
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+#include <atomic>
+#include <chrono>
+
+/// Name of the file with the mapping indicator type id -> model name
+#define INDICATOR_MAPPING_FILE "indicators.properties"
+
+/// Time a change notification is waited for before the stop and reload requests are checked again (in ms)
+#define INDICATOR_MAPPING_WATCH_TIMEOUT 250
+
+/// Time to wait after a change notification until the file is read, so that a save in progress can finish (in ms)
+#define INDICATOR_MAPPING_SETTLE_TIME 100
+
+/// Interval in which the file is checked for changes if change notifications are not available (in ms)
+#define INDICATOR_MAPPING_POLL_INTERVAL 1000
+
+/// <summary>
+/// Watches the indicator mapping file and reloads it in the background when it changes.
+///
+/// The file is parsed and validated on the watcher thread. Only complete tables are handed over to the publish callback,
+/// so the thread executing commands never reads the file and never sees a partly loaded mapping. If the changed file
+/// cannot be read or contains no valid mapping, the previous table stays in use.
+///
+/// Changes are detected by FindFirstChangeNotification on Windows and inotify on Linux. If neither is available, the
+/// modification time of the file is polled.
+/// </summary>
+class IndicatorTypeTableWatcher
+{
+public:
+    /// <summary>
+    /// Callback which publishes a newly loaded table.
+    /// </summary>
+    typedef std::function<void(std::shared_ptr<const IndicatorTypeTable>)> PublishCallback;
+
+    /// <summary>
+    /// Loads the mapping once, publishes it and starts the watcher thread.
+    /// </summary>
+    /// <param name="path">Path of the mapping file</param>
+    /// <param name="publish">Callback which receives each loaded table</param>
+    void start(const std::string& path, PublishCallback publish);
+
+    /// <summary>
+    /// Stops the watcher thread and waits for it to finish.
+    /// </summary>
+    void stop();
+
+    /// <summary>
+    /// Requests the mapping to be reloaded by the watcher thread even if the file did not change.
+    /// </summary>
+    void requestReload();
+
+    /// <summary>
+    /// Returns the number of tables which have been published after the initial load.
+    /// </summary>
+    /// <returns>Number of reloads</returns>
+    unsigned long long getReloadCount() const;
+
+    /// <summary>
+    /// Returns the number of reloads which have been rejected because the file could not be read or was invalid.
+    /// </summary>
+    /// <returns>Number of rejected reloads</returns>
+    unsigned long long getRejectedReloadCount() const;
+
+    /// <summary>
+    /// Loads the mapping from the given file and reports invalid lines as warning.
+    /// </summary>
+    /// <param name="path">Path of the mapping file</param>
+    /// <returns>The loaded table or nullptr if the file could not be read</returns>
+    static std::shared_ptr<const IndicatorTypeTable> load(const std::string& path);
+
+private:
+    /// <summary>
+    /// Modification time and size of the file, used to ignore notifications for other files in the same directory.
+    /// </summary>
+    struct FileStamp
+    {
+        bool exists = false;
+        std::filesystem::file_time_type lastWriteTime{};
+        uintmax_t size = 0;
+
+        bool operator==(const FileStamp& other) const = default;
+    };
+
+    /// <summary>
+    /// Path of the mapping file.
+    /// </summary>
+    std::string path;
+
+    /// <summary>
+    /// Callback which receives each loaded table.
+    /// </summary>
+    PublishCallback publish;
+
+    /// <summary>
+    /// Stamp of the file when it was loaded last.
+    /// </summary>
+    FileStamp loadedStamp;
+
+    /// <summary>
+    /// Thread which waits for changes of the file.
+    /// </summary>
+    std::thread watcherThread;
+
+    /// <summary>
+    /// Indicates the status of the thread.
+    /// </summary>
+    std::atomic_bool isRunning{ false };
+
+    /// <summary>
+    /// Set if the mapping has to be reloaded regardless of the file stamp.
+    /// </summary>
+    std::atomic_bool reloadRequested{ false };
+
+    /// <summary>
+    /// Mutex for the wake up of the polling thread.
+    /// </summary>
+    std::mutex wakeUpMutex;
+
+    /// <summary>
+    /// Wakes up the polling thread on stop and reload requests.
+    /// </summary>
+    std::condition_variable wakeUp;
+
+    /// <summary>
+    /// Number of published reloads.
+    /// </summary>
+    std::atomic<unsigned long long> reloadCount{ 0 };
+
+    /// <summary>
+    /// Number of rejected reloads.
+    /// </summary>
+    std::atomic<unsigned long long> rejectedReloadCount{ 0 };
+
+    /// <summary>
+    /// Main loop of the watcher thread.
+    /// </summary>
+    void run();
+
+    /// <summary>
+    /// Waits for change notifications of the operating system until the watcher is stopped.
+    /// </summary>
+    /// <returns>False if change notifications are not available</returns>
+    bool runNotificationLoop();
+
+    /// <summary>
+    /// Polls the file stamp until the watcher is stopped.
+    /// </summary>
+    void runPollingLoop();
+
+    /// <summary>
+    /// Waits until the given time passed or the watcher is stopped.
+    /// </summary>
+    /// <param name="timeout">Time to wait</param>
+    void waitFor(std::chrono::milliseconds timeout);
+
+    /// <summary>
+    /// Reloads the mapping if the file changed since the last load or a reload was requested.
+    /// </summary>
+    void reloadIfChanged();
+
+    /// <summary>
+    /// Reads the current stamp of the mapping file.
+    /// </summary>
+    /// <returns>Stamp of the file</returns>
+    FileStamp readFileStamp() const;
+};
\ No newline at end of file
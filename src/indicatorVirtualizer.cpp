@@ -0,0 +1,189 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indicatorVirtualizer.h"
+#include "geodesy.h"
+
+#include <charconv>
+#include <algorithm>
+
+/// Marks an indicator which is not resident
+#define NOT_RESIDENT 0xFFFFFFFFu
+
+bool parseVirtualizationConfiguration(const std::string& specification, VirtualizationConfiguration* configuration)
+{
+    VirtualizationConfiguration parsed;
+    size_t separator = specification.find(':');
+    const char* first = specification.data();
+    const char* last = specification.data() + std::min(separator, specification.size());
+
+    double radius = 0;
+    std::from_chars_result res = std::from_chars(first, last, radius);
+    if (res.ec != std::errc() || res.ptr != last || !(radius > 0))
+    {
+        return false;
+    }
+    parsed.radius = radius * 1000.0;
+
+    if (separator != std::string::npos)
+    {
+        first = specification.data() + separator + 1;
+        last = specification.data() + specification.size();
+        res = std::from_chars(first, last, parsed.maxCount);
+        if (res.ec != std::errc() || res.ptr != last || parsed.maxCount == 0)
+        {
+            return false;
+        }
+    }
+
+    *configuration = parsed;
+    return true;
+}
+
+IndicatorVirtualizer::IndicatorVirtualizer()
+    : residentIndices(INDICATOR_REGISTRY_SIZE, NOT_RESIDENT), selectedInUpdate(INDICATOR_REGISTRY_SIZE, 0)
+{
+}
+
+void IndicatorVirtualizer::configure(const VirtualizationConfiguration& configuration)
+{
+    this->configuration = configuration;
+}
+
+bool IndicatorVirtualizer::isEnabled() const
+{
+    return configuration.radius > 0;
+}
+
+bool IndicatorVirtualizer::isInRange(double latitude, double longitude) const
+{
+    if (!isEnabled())
+    {
+        return true;
+    }
+
+    return hasCenter && (configuration.maxCount == 0 || residents.size() < configuration.maxCount) &&
+        getGreatCircleDistance(centerLatitude, centerLongitude, latitude, longitude) <= configuration.radius;
+}
+
+void IndicatorVirtualizer::update(const IndicatorGrid& grid, double latitude, double longitude, std::vector<ushort>& materialize, std::vector<ushort>& retire)
+{
+    centerLatitude = latitude;
+    centerLongitude = longitude;
+    hasCenter = true;
+
+    if (++updateNumber == 0)
+    {
+        // the numbers of the previous round could be taken as selected
+        std::fill(selectedInUpdate.begin(), selectedInUpdate.end(), 0);
+        updateNumber = 1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    candidates.clear();
+    size_t examined = grid.query(latitude, longitude, configuration.radius * INDICATOR_VIRTUALIZATION_HYSTERESIS, candidates);
+    unsigned long long queryTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    statistics.updates++;
+    queryTimeSum += queryTime;
+    statistics.maxQueryTime = std::max(statistics.maxQueryTime, queryTime);
+    examinedSum += examined;
+
+    // only the nearest indicators up to the maximum count are kept
+    size_t selectedCount = candidates.size();
+    if (configuration.maxCount != 0 && selectedCount > configuration.maxCount)
+    {
+        selectedCount = configuration.maxCount;
+        std::nth_element(candidates.begin(), candidates.begin() + selectedCount, candidates.end(),
+            [](const IndicatorDistance& a, const IndicatorDistance& b) { return a.distance < b.distance; });
+    }
+    std::sort(candidates.begin(), candidates.begin() + selectedCount,
+        [](const IndicatorDistance& a, const IndicatorDistance& b) { return a.distance < b.distance; });
+
+    for (size_t i = 0; i < selectedCount; i++)
+    {
+        const IndicatorDistance& candidate = candidates[i];
+        selectedInUpdate[candidate.id] = updateNumber;
+
+        // indicators in the hysteresis band stay resident but are not materialized
+        if (!isResident(candidate.id) && candidate.distance <= configuration.radius && materialize.size() < INDICATOR_VIRTUALIZATION_BUDGET)
+        {
+            materialize.push_back(candidate.id);
+        }
+    }
+
+    for (ushort id : residents)
+    {
+        if (selectedInUpdate[id] != updateNumber)
+        {
+            retire.push_back(id);
+        }
+    }
+
+    statistics.materialized += materialize.size();
+    statistics.retired += retire.size();
+}
+
+void IndicatorVirtualizer::markResident(ushort id)
+{
+    if (residentIndices[id] == NOT_RESIDENT)
+    {
+        residentIndices[id] = static_cast<uint>(residents.size());
+        residents.push_back(id);
+    }
+}
+
+void IndicatorVirtualizer::markVirtual(ushort id)
+{
+    uint index = residentIndices[id];
+    if (index == NOT_RESIDENT)
+    {
+        return;
+    }
+
+    // the last resident indicator takes the place of the removed one
+    ushort last = residents.back();
+    residents[index] = last;
+    residentIndices[last] = index;
+    residents.pop_back();
+    residentIndices[id] = NOT_RESIDENT;
+}
+
+void IndicatorVirtualizer::clearResidents()
+{
+    for (ushort id : residents)
+    {
+        residentIndices[id] = NOT_RESIDENT;
+    }
+    residents.clear();
+}
+
+bool IndicatorVirtualizer::isResident(ushort id) const
+{
+    return residentIndices[id] != NOT_RESIDENT;
+}
+
+VirtualizationStatistics IndicatorVirtualizer::getStatistics(const IndicatorGrid& grid) const
+{
+    VirtualizationStatistics result = statistics;
+    result.resident = residents.size();
+    result.total = grid.size();
+    result.averageQueryTime = statistics.updates == 0 ? 0 : queryTimeSum / statistics.updates;
+    result.averageExamined = statistics.updates == 0 ? 0 : examinedSum / statistics.updates;
+    return result;
+}
\ No newline at end of file
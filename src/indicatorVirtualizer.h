@@ -0,0 +1,215 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "indicatorGrid.h"
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+/// Minimum time between two updates of the resident indicators (in ms)
+#define INDICATOR_VIRTUALIZATION_INTERVAL 250
+
+/// Resident indicators are retired when they are farther away than this multiple of the radius, so indicators at the border
+/// of the radius are not created and removed again and again
+#define INDICATOR_VIRTUALIZATION_HYSTERESIS 1.2
+
+/// Maximum number of indicators which are materialized in one update
+#define INDICATOR_VIRTUALIZATION_BUDGET 64
+
+/// <summary>
+/// Configuration of the indicator virtualization.
+/// </summary>
+struct VirtualizationConfiguration {
+    /// <summary>
+    /// Radius around the aircraft in which indicators are materialized in m, 0 to materialize all indicators
+    /// </summary>
+    double radius = 0;
+
+    /// <summary>
+    /// Maximum number of materialized indicators, 0 for no limit
+    /// </summary>
+    uint maxCount = 0;
+};
+
+/// <summary>
+/// Snapshot of the counters of the indicator virtualization.
+/// </summary>
+struct VirtualizationStatistics {
+    size_t resident;                     // indicators with a SimObject
+    size_t total;                        // all placed indicators, resident and virtual
+    unsigned long long materialized;     // indicators which got a SimObject by an update
+    unsigned long long retired;          // indicators whose SimObject was removed by an update
+    unsigned long long updates;          // updates of the resident indicators
+    unsigned long long averageQueryTime; // average time of the grid query in ns
+    unsigned long long maxQueryTime;     // maximum time of the grid query in ns
+    unsigned long long averageExamined;  // average number of indicators whose distance was calculated per query
+};
+
+/// <summary>
+/// Parses a virtualization configuration in the format "radius km[:max count]", e.g. 20:500.
+/// </summary>
+/// <param name="specification">Text to parse</param>
+/// <param name="configuration">Receives the parsed configuration</param>
+/// <returns>False if the text is invalid</returns>
+bool parseVirtualizationConfiguration(const std::string& specification, VirtualizationConfiguration* configuration);
+
+/// <summary>
+/// Decides which of the placed indicators get a SimObject (resident) and which are only kept in the grid (virtual).
+///
+/// Each update queries the grid around the aircraft. The nearest indicators within the radius, up to the maximum count, are
+/// materialized, at most INDICATOR_VIRTUALIZATION_BUDGET per update and the nearest first. Resident indicators which left the
+/// radius including the hysteresis or were pushed out of the maximum count by nearer ones are retired.
+///
+/// The virtualizer only tracks which indicators are resident, the caller creates and removes the SimObjects and reports each
+/// change with markResident and markVirtual. It is not thread-safe.
+/// </summary>
+class IndicatorVirtualizer
+{
+public:
+    /// <summary>
+    /// Creates a disabled virtualizer.
+    /// </summary>
+    IndicatorVirtualizer();
+
+    /// <summary>
+    /// Changes the configuration.
+    /// </summary>
+    /// <param name="configuration">New configuration</param>
+    void configure(const VirtualizationConfiguration& configuration);
+
+    /// <summary>
+    /// Returns true if indicators are only materialized near the aircraft.
+    /// </summary>
+    /// <returns>False if all indicators are materialized</returns>
+    bool isEnabled() const;
+
+    /// <summary>
+    /// Returns true if an indicator at the given position may be materialized immediately, i.e. the aircraft position is known,
+    /// the position is within the radius and the maximum count is not reached.
+    /// </summary>
+    /// <param name="latitude">Latitude of the indicator in degrees</param>
+    /// <param name="longitude">Longitude of the indicator in degrees</param>
+    /// <returns>True if the indicator may be materialized</returns>
+    bool isInRange(double latitude, double longitude) const;
+
+    /// <summary>
+    /// Determines the indicators which have to be materialized and retired for the new aircraft position.
+    /// </summary>
+    /// <param name="grid">Positions of all placed indicators</param>
+    /// <param name="latitude">Latitude of the aircraft in degrees</param>
+    /// <param name="longitude">Longitude of the aircraft in degrees</param>
+    /// <param name="materialize">Receives the virtual indicators which have to be materialized, the nearest first</param>
+    /// <param name="retire">Receives the resident indicators which have to be retired</param>
+    void update(const IndicatorGrid& grid, double latitude, double longitude, std::vector<ushort>& materialize, std::vector<ushort>& retire);
+
+    /// <summary>
+    /// Records that the indicator got a SimObject.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    void markResident(ushort id);
+
+    /// <summary>
+    /// Records that the SimObject of the indicator was removed or lost.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    void markVirtual(ushort id);
+
+    /// <summary>
+    /// Records that all SimObjects were lost, e.g. with the connection to the simulation.
+    /// </summary>
+    void clearResidents();
+
+    /// <summary>
+    /// Returns true if the indicator has a SimObject.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <returns>True if the indicator is resident</returns>
+    bool isResident(ushort id) const;
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <param name="grid">Positions of all placed indicators</param>
+    /// <returns>Statistics of the virtualization</returns>
+    VirtualizationStatistics getStatistics(const IndicatorGrid& grid) const;
+
+private:
+    /// <summary>
+    /// Current configuration.
+    /// </summary>
+    VirtualizationConfiguration configuration;
+
+    /// <summary>
+    /// Latitude of the aircraft at the last update.
+    /// </summary>
+    double centerLatitude = 0;
+
+    /// <summary>
+    /// Longitude of the aircraft at the last update.
+    /// </summary>
+    double centerLongitude = 0;
+
+    /// <summary>
+    /// False until the first update.
+    /// </summary>
+    bool hasCenter = false;
+
+    /// <summary>
+    /// Ids of the resident indicators.
+    /// </summary>
+    std::vector<ushort> residents;
+
+    /// <summary>
+    /// Index of each indicator in residents, indexed by external indicator id, NOT_RESIDENT if it is virtual.
+    /// </summary>
+    std::vector<uint> residentIndices;
+
+    /// <summary>
+    /// Number of the update in which each indicator was selected, indexed by external indicator id.
+    /// </summary>
+    std::vector<uint> selectedInUpdate;
+
+    /// <summary>
+    /// Indicators found by the query of the current update, kept to avoid allocations.
+    /// </summary>
+    std::vector<IndicatorDistance> candidates;
+
+    /// <summary>
+    /// Number of the current update, 0 is never used.
+    /// </summary>
+    uint updateNumber = 0;
+
+    /// <summary>
+    /// Counters of the virtualization, see VirtualizationStatistics.
+    /// </summary>
+    VirtualizationStatistics statistics{};
+
+    /// <summary>
+    /// Sum of the query times in ns.
+    /// </summary>
+    unsigned long long queryTimeSum = 0;
+
+    /// <summary>
+    /// Sum of the examined indicators of all queries.
+    /// </summary>
+    unsigned long long examinedSum = 0;
+};
\ No newline at end of file
@@ -0,0 +1,499 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "log.h"
+#include "logRecord.h"
+#include "binaryLog.h"
+#include "console.h"
+#include "ringBuffer.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <cstring>
+
+/// <summary>
+/// Fixed-size log record which is passed from the logging thread to the writer thread.
+/// </summary>
+struct LogRecord {
+    /// <summary>
+    /// Creation time in microseconds since 1970-01-01 UTC, also used to merge the records of all threads in order.
+    /// </summary>
+    long long timestamp;
+
+    /// <summary>
+    /// Log level of the record.
+    /// </summary>
+    LogLevel level;
+
+    /// <summary>
+    /// Type of the payload.
+    /// </summary>
+    LogRecordType type;
+
+    /// <summary>
+    /// Number of valid bytes of the payload.
+    /// </summary>
+    unsigned int length;
+
+    /// <summary>
+    /// The message or the raw values of an event.
+    /// </summary>
+    LogRecordPayload payload;
+};
+
+/// <summary>
+/// Log records taken by the writer thread. Only the used part of each payload is copied into a shared buffer.
+/// </summary>
+struct CollectedRecords {
+    struct Entry {
+        long long timestamp;
+        LogLevel level;
+        LogRecordType type;
+        size_t offset;
+        unsigned int length;
+    };
+
+    std::vector<Entry> entries;
+    std::string payloads;
+
+    void clear()
+    {
+        entries.clear();
+        payloads.clear();
+    }
+};
+
+/// <summary>
+/// Log records of a single thread. The thread is the only producer, the writer thread the only consumer.
+/// </summary>
+struct ThreadLogBuffer {
+    RingBuffer<LogRecord> records{ LOG_THREAD_BUFFER_CAPACITY, DROP_NEWEST };
+
+    /// <summary>
+    /// Set when the thread exits, the buffer is removed after its last records have been printed.
+    /// </summary>
+    std::atomic_bool isThreadFinished{ false };
+};
+
+/// <summary>
+/// Registers the buffer of a thread on first use and marks it as finished when the thread exits.
+/// </summary>
+struct ThreadLogBufferOwner {
+    std::shared_ptr<ThreadLogBuffer> buffer;
+
+    ThreadLogBufferOwner();
+    ~ThreadLogBufferOwner();
+};
+
+/// <summary>
+/// True while the writer thread is running.
+/// </summary>
+static std::atomic_bool isWriterRunning{ false };
+
+/// <summary>
+/// Buffers of all threads which have logged since start.
+/// </summary>
+static std::vector<std::shared_ptr<ThreadLogBuffer>> threadBuffers;
+static std::mutex threadBuffersMutex;
+
+/// <summary>
+/// Dropped records of buffers which have already been removed.
+/// </summary>
+static std::atomic<unsigned long long> droppedRecordsOfFinishedThreads{ 0 };
+
+/// <summary>
+/// Thread which prints the log records.
+/// </summary>
+static std::thread writerThread;
+
+/// <summary>
+/// Flags and primitives to put the writer thread to sleep while no records are pending. isWriterWaiting is cleared by the
+/// first producer which wakes the writer, so the following producers neither lock the mutex nor notify.
+/// </summary>
+static std::atomic_bool isWriterWaiting{ false };
+static std::mutex writerMutex;
+static std::condition_variable writerWakeUp;
+
+/// <summary>
+/// Binary log file, only written by the writer thread.
+/// </summary>
+static std::ofstream binaryLogFile;
+
+/// <summary>
+/// Synchronization for printing without the writer thread (before start and after stop).
+/// </summary>
+static std::mutex synchronousPrintMutex;
+
+ThreadLogBufferOwner::ThreadLogBufferOwner() : buffer(std::make_shared<ThreadLogBuffer>())
+{
+    std::scoped_lock lk(threadBuffersMutex);
+    threadBuffers.push_back(buffer);
+}
+
+ThreadLogBufferOwner::~ThreadLogBufferOwner()
+{
+    buffer->isThreadFinished.store(true, std::memory_order_release);
+}
+
+/// <summary>
+/// Returns the log buffer of the calling thread.
+/// </summary>
+static ThreadLogBuffer& getThreadLogBuffer()
+{
+    thread_local ThreadLogBufferOwner owner;
+    return *owner.buffer;
+}
+
+/// <summary>
+/// Prints a single message directly.
+/// </summary>
+static void printSynchronously(LogLevel level, const std::string& message)
+{
+    std::scoped_lock lk(synchronousPrintMutex);
+
+    switch (level)
+    {
+    case LOG_LEVEL_INFO:
+        printInfo(message);
+        break;
+    case LOG_LEVEL_WARNING:
+        printWarning(message);
+        break;
+    case LOG_LEVEL_ERROR:
+        printError(message);
+        break;
+    default:
+        printMessage(message);
+        break;
+    }
+}
+
+/// <summary>
+/// Returns the number of records which were dropped by all threads so far.
+/// </summary>
+static unsigned long long countDroppedRecords()
+{
+    unsigned long long dropped = droppedRecordsOfFinishedThreads.load(std::memory_order_relaxed);
+
+    std::scoped_lock lk(threadBuffersMutex);
+    for (const std::shared_ptr<ThreadLogBuffer>& buffer : threadBuffers)
+    {
+        dropped += buffer->records.getStatistics().dropped;
+    }
+
+    return dropped;
+}
+
+/// <summary>
+/// Takes the pending records of all threads and removes the buffers of finished threads.
+/// </summary>
+static void collectRecords(CollectedRecords& batch)
+{
+    std::scoped_lock lk(threadBuffersMutex);
+
+    for (size_t i = 0; i < threadBuffers.size();)
+    {
+        ThreadLogBuffer& buffer = *threadBuffers[i];
+
+        // read the flag first, so no record written before the thread finished is lost
+        bool isThreadFinished = buffer.isThreadFinished.load(std::memory_order_acquire);
+
+        while (buffer.records.consume([&batch](LogRecord& record) {
+            batch.entries.push_back({ record.timestamp, record.level, record.type, batch.payloads.size(), record.length });
+            batch.payloads.append(reinterpret_cast<const char*>(&record.payload), record.length);
+        }))
+        {
+        }
+
+        if (isThreadFinished)
+        {
+            droppedRecordsOfFinishedThreads.fetch_add(buffer.records.getStatistics().dropped, std::memory_order_relaxed);
+            threadBuffers.erase(threadBuffers.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/// <summary>
+/// Returns true if at least one thread has pending records.
+/// </summary>
+static bool hasPendingRecords()
+{
+    std::scoped_lock lk(threadBuffersMutex);
+
+    for (const std::shared_ptr<ThreadLogBuffer>& buffer : threadBuffers)
+    {
+        if (buffer->records.getStatistics().size > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Prints the records in the order they were created. If the binary log is open, the records are written to it and only
+/// warnings, errors and "normal" messages are printed.
+/// </summary>
+static void printRecords(CollectedRecords& batch, std::string& output)
+{
+    std::stable_sort(batch.entries.begin(), batch.entries.end(),
+        [](const CollectedRecords::Entry& a, const CollectedRecords::Entry& b) { return a.timestamp < b.timestamp; });
+
+    bool isBinaryLogOpen = binaryLogFile.is_open();
+
+    output.clear();
+    for (const CollectedRecords::Entry& entry : batch.entries)
+    {
+        const char* payload = batch.payloads.data() + entry.offset;
+
+        if (isBinaryLogOpen)
+        {
+            writeBinaryLogRecord(binaryLogFile, entry.timestamp, entry.level, entry.type, payload, entry.length);
+
+            if (entry.level < LOG_LEVEL_WARNING)
+            {
+                continue;
+            }
+        }
+
+        bool isColored = entry.level != LOG_LEVEL_MESSAGE;
+
+        if (isColored) output += getLogLevelColor(entry.level);
+        formatLogPayload(entry.type, payload, entry.length, output);
+        if (isColored) output += getLogLevelColor(LOG_LEVEL_MESSAGE);
+        output += '\n';
+    }
+
+    if (isBinaryLogOpen)
+    {
+        binaryLogFile.flush();
+    }
+
+    if (!output.empty())
+    {
+        printRaw(output);
+    }
+}
+
+/// <summary>
+/// Main loop of the writer thread. Runs until stop is called and all pending records are printed.
+/// </summary>
+static void runLogWriter()
+{
+    CollectedRecords batch;
+    std::string output;
+    unsigned long long reportedDroppedRecords = 0;
+
+    while (true)
+    {
+        bool isStopping = !isWriterRunning.load(std::memory_order_acquire);
+
+        batch.clear();
+        collectRecords(batch);
+
+        if (!batch.entries.empty())
+        {
+            printRecords(batch, output);
+            continue;
+        }
+
+        unsigned long long droppedRecords = countDroppedRecords();
+        if (droppedRecords != reportedDroppedRecords)
+        {
+            printWarning("Log buffer full, " + std::to_string(droppedRecords - reportedDroppedRecords) + " messages dropped");
+            reportedDroppedRecords = droppedRecords;
+        }
+
+        if (isStopping)
+        {
+            return;
+        }
+
+        isWriterWaiting.store(true, std::memory_order_seq_cst);
+        if (!hasPendingRecords())
+        {
+            std::unique_lock<std::mutex> lk(writerMutex);
+            writerWakeUp.wait_for(lk, std::chrono::milliseconds(100), [] {
+                return !isWriterRunning.load(std::memory_order_acquire) || hasPendingRecords();
+            });
+        }
+        isWriterWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::log(LogLevel level, LogRecordType type, const void* payload, size_t length)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    if (!isWriterRunning.load(std::memory_order_acquire))
+    {
+        std::string message;
+        formatLogPayload(type, static_cast<const char*>(payload), static_cast<unsigned int>(length), message);
+        printSynchronously(level, message);
+        return;
+    }
+
+    long long timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    getThreadLogBuffer().records.emplace([&](LogRecord& record) {
+        record.timestamp = timestamp;
+        record.level = level;
+        record.type = type;
+        record.length = static_cast<unsigned int>(std::min<size_t>(length, sizeof(LogRecordPayload)));
+        std::memcpy(&record.payload, payload, record.length);
+
+        if (type == LOG_RECORD_TEXT && length > LOG_RECORD_TEXT_LENGTH)
+        {
+            std::memcpy(record.payload.text + LOG_RECORD_TEXT_LENGTH - 3, "...", 3);
+        }
+        return true;
+    });
+
+    // the load keeps the cache line shared while the writer is awake, only a producer which finds it waiting tries the exchange
+    if (isWriterWaiting.load(std::memory_order_seq_cst) && isWriterWaiting.exchange(false, std::memory_order_seq_cst))
+    {
+        std::lock_guard<std::mutex> lk(writerMutex);
+        writerWakeUp.notify_one();
+    }
+}
+
+void Logger::logMessage(const std::string& message)
+{
+    log(LOG_LEVEL_MESSAGE, LOG_RECORD_TEXT, message.data(), message.size());
+}
+
+void Logger::logInfo(const std::string& message)
+{
+    log(LOG_LEVEL_INFO, LOG_RECORD_TEXT, message.data(), message.size());
+}
+
+void Logger::logWarning(const std::string& message)
+{
+    log(LOG_LEVEL_WARNING, LOG_RECORD_TEXT, message.data(), message.size());
+}
+
+void Logger::logError(const std::string& message)
+{
+    log(LOG_LEVEL_ERROR, LOG_RECORD_TEXT, message.data(), message.size());
+}
+
+void Logger::logEvent(LogLevel level, const SetIndicatorLogEvent& event)
+{
+    log(level, LOG_RECORD_SET_INDICATOR, &event, sizeof(event));
+}
+
+void Logger::logEvent(LogLevel level, const SetIndicatorBatchLogEvent& event)
+{
+    log(level, LOG_RECORD_SET_INDICATOR_BATCH, &event, sizeof(event));
+}
+
+void Logger::logEvent(LogLevel level, const RemoveIndicatorsLogEvent& event)
+{
+    log(level, LOG_RECORD_REMOVE_INDICATORS, &event, getRemoveIndicatorsLogEventLength(event));
+}
+
+void Logger::logEvent(LogLevel level, const AircraftStateLogEvent& event)
+{
+    log(level, LOG_RECORD_AIRCRAFT_STATE, &event, sizeof(event));
+}
+
+void Logger::logEvent(LogLevel level, const GateLogEvent& event)
+{
+    log(level, LOG_RECORD_GATE, &event, sizeof(event));
+}
+
+void Logger::setLogLevel(LogLevel level)
+{
+    minimumLogLevel.store(level, std::memory_order_relaxed);
+}
+
+bool Logger::openBinaryLog(const std::string& path)
+{
+    if (isWriterRunning.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    binaryLogFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!binaryLogFile.is_open())
+    {
+        return false;
+    }
+
+    writeBinaryLogHeader(binaryLogFile);
+    return true;
+}
+
+void Logger::start()
+{
+    if (isWriterRunning.exchange(true))
+    {
+        return;
+    }
+
+    writerThread = std::thread(runLogWriter);
+}
+
+void Logger::stop()
+{
+    if (!isWriterRunning.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(writerMutex);
+        writerWakeUp.notify_one();
+    }
+    writerThread.join();
+
+    // records of threads which were still logging while the writer stopped
+    CollectedRecords batch;
+    collectRecords(batch);
+    if (!batch.entries.empty())
+    {
+        std::string output;
+        printRecords(batch, output);
+    }
+
+    if (binaryLogFile.is_open())
+    {
+        binaryLogFile.close();
+    }
+}
+
+unsigned long long Logger::getDroppedRecordCount()
+{
+    return countDroppedRecords();
+}
\ No newline at end of file
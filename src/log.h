@@ -18,9 +18,32 @@
  */
 #pragma once
 
+#include "logRecord.h"
 #include <string>
+#include <atomic>
+
+/// Number of log records each thread can buffer before new records are dropped
+#define LOG_THREAD_BUFFER_CAPACITY 1024
+
+/// <summary>
+/// Log levels in ascending order. Messages below the configured minimum level are discarded before they are formatted.
+/// </summary>
+enum LogLevel {
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_ERROR,
+    /// "Normal" messages (e.g. answers to console commands) are never filtered.
+    LOG_LEVEL_MESSAGE,
+};
+
 /// <summary>
 /// Contains static methods to log messages.
+///
+/// As long as the logger is not started, messages are printed synchronously. After start, every thread writes its
+/// messages as fixed-size records into its own lock-free ring buffer and a background thread prints them,
+/// so the calling thread never waits for the console.
+/// Events (logEvent) only capture the raw values, they are formatted by the background thread when they are printed
+/// or not at all if they are written to the binary log file.
 /// </summary>
 class Logger {
 public:
@@ -28,23 +51,114 @@ public:
     /// Logs messages in "normal" style.
     /// </summary>
     /// <param name="message">The message to be logged</param>
-    static void logMessage(std::string message);
+    static void logMessage(const std::string& message);
 
     /// <summary>
     /// Logs messages with log level info.
     /// </summary>
     /// <param name="message">The message to be logged</param>
-    static void logInfo(std::string message);
+    static void logInfo(const std::string& message);
 
     /// <summary>
     /// Logs messages with log level warning.
     /// </summary>
     /// <param name="message">The message to be logged</param>
-    static void logWarning(std::string message);
+    static void logWarning(const std::string& message);
 
     /// <summary>
     /// Logs messages with log level error.
     /// </summary>
     /// <param name="message">The message to be logged</param>
-    static void logError(std::string message);
-};
+    static void logError(const std::string& message);
+
+    /// <summary>
+    /// Logs an executed SET command.
+    /// </summary>
+    /// <param name="level">Log level of the event</param>
+    /// <param name="event">The raw values of the event</param>
+    static void logEvent(LogLevel level, const SetIndicatorLogEvent& event);
+
+    /// <summary>
+    /// Logs an executed SET_BATCH command.
+    /// </summary>
+    /// <param name="level">Log level of the event</param>
+    /// <param name="event">The raw values of the event</param>
+    static void logEvent(LogLevel level, const SetIndicatorBatchLogEvent& event);
+
+    /// <summary>
+    /// Logs an executed REMOVE command.
+    /// </summary>
+    /// <param name="level">Log level of the event</param>
+    /// <param name="event">The raw values of the event</param>
+    static void logEvent(LogLevel level, const RemoveIndicatorsLogEvent& event);
+
+    /// <summary>
+    /// Logs a received aircraft state.
+    /// </summary>
+    /// <param name="level">Log level of the event</param>
+    /// <param name="event">The raw values of the event</param>
+    static void logEvent(LogLevel level, const AircraftStateLogEvent& event);
+
+    /// <summary>
+    /// Logs a detected ring passage.
+    /// </summary>
+    /// <param name="level">Log level of the event</param>
+    /// <param name="event">The raw values of the event</param>
+    static void logEvent(LogLevel level, const GateLogEvent& event);
+
+    /// <summary>
+    /// Returns true if messages of the given log level are logged. Callers should check this before they
+    /// build expensive messages.
+    /// </summary>
+    /// <param name="level">Log level of the message</param>
+    /// <returns>true if the message would be logged</returns>
+    static bool isEnabled(LogLevel level)
+    {
+        return level >= minimumLogLevel.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Sets the minimum log level. Can be called from any thread.
+    /// </summary>
+    /// <param name="level">Minimum log level</param>
+    static void setLogLevel(LogLevel level);
+
+    /// <summary>
+    /// Writes all log records to the given binary log file instead of the console, except warnings, errors and "normal"
+    /// messages which are also printed. The file can be rendered with renderBinaryLog. Must be called before start.
+    /// </summary>
+    /// <param name="path">Path of the binary log file, an existing file is overwritten</param>
+    /// <returns>false if the file could not be opened</returns>
+    static bool openBinaryLog(const std::string& path);
+
+    /// <summary>
+    /// Starts the background thread which prints the log records.
+    /// </summary>
+    static void start();
+
+    /// <summary>
+    /// Prints all pending log records and stops the background thread. Afterwards messages are printed synchronously again.
+    /// </summary>
+    static void stop();
+
+    /// <summary>
+    /// Returns the number of log records which were dropped because the buffer of the logging thread was full.
+    /// </summary>
+    /// <returns>Number of dropped log records</returns>
+    static unsigned long long getDroppedRecordCount();
+
+private:
+    /// <summary>
+    /// Messages below this level are discarded.
+    /// </summary>
+    static inline std::atomic<LogLevel> minimumLogLevel{ LOG_LEVEL_INFO };
+
+    /// <summary>
+    /// Logs a record with the given level, either asynchronously or synchronously if the logger is not started.
+    /// </summary>
+    /// <param name="level">Log level of the record</param>
+    /// <param name="type">Type of the payload</param>
+    /// <param name="payload">Payload of the record</param>
+    /// <param name="length">Length of the payload, text longer than LOG_RECORD_TEXT_LENGTH is truncated</param>
+    static void log(LogLevel level, LogRecordType type, const void* payload, size_t length);
+};
\ No newline at end of file
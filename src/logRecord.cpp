@@ -0,0 +1,129 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logRecord.h"
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+
+unsigned int getRemoveIndicatorsLogEventLength(const RemoveIndicatorsLogEvent& event)
+{
+    size_t storedIDs = std::min<size_t>(event.count, LOG_EVENT_MAX_IDS);
+    return static_cast<unsigned int>(offsetof(RemoveIndicatorsLogEvent, ids) + storedIDs * sizeof(ushort));
+}
+
+static void formatSetIndicator(const SetIndicatorLogEvent& event, std::string& output)
+{
+    output += "Set Indicator: Indicator " + std::to_string(event.id);
+    output += " of type " + std::to_string(event.indicatorTypeID);
+    output += " Lat: " + std::to_string(event.position[0]);
+    output += ", Long: " + std::to_string(event.position[1]);
+    output += ", Height: " + std::to_string(event.position[2]);
+    output += ", Roll: " + std::to_string(event.position[3]);
+    output += ", Pitch: " + std::to_string(event.position[4]);
+    output += ", Yaw: " + std::to_string(event.position[5]);
+}
+
+static void formatSetIndicatorBatch(const SetIndicatorBatchLogEvent& event, std::string& output)
+{
+    output += "Set Indicator Batch: " + std::to_string(event.count);
+    output += " indicators (IDs " + std::to_string(event.firstID);
+    output += " - " + std::to_string(event.lastID) + ")";
+}
+
+static void formatRemoveIndicators(const RemoveIndicatorsLogEvent& event, std::string& output)
+{
+    if (event.count == 0)
+    {
+        output += "Delete all indicators.";
+        return;
+    }
+
+    output += "Delete indicators: ";
+
+    ushort storedIDs = std::min<ushort>(event.count, LOG_EVENT_MAX_IDS);
+    for (ushort i = 0; i < storedIDs; i++)
+    {
+        output += std::to_string(event.ids[i]);
+        if (i + 1 != storedIDs) {
+            output += ", ";
+        }
+    }
+
+    if (storedIDs < event.count)
+    {
+        output += " (and " + std::to_string(event.count - storedIDs) + " more)";
+    }
+}
+
+static void formatAircraftState(const AircraftStateLogEvent& event, std::string& output)
+{
+    output += "Aircraft state received: Latitude: " + std::to_string(event.values[0]);
+    output += " Longitude: " + std::to_string(event.values[1]);
+    output += " Altitude: " + std::to_string(event.values[2]);
+    output += " Heading: " + std::to_string(event.values[3]);
+    output += " Bank: " + std::to_string(event.values[4]);
+    output += " Pitch: " + std::to_string(event.values[5]);
+    output += " Speed: " + std::to_string(event.values[6]);
+}
+
+static void formatGate(const GateLogEvent& event, std::string& output)
+{
+    char distance[32];
+    std::snprintf(distance, sizeof(distance), "%.1f", event.missDistance);
+    output += "Indicator " + std::to_string(event.id) + (event.passed ? " passed" : " missed");
+    output += ", " + std::string(distance) + " m from the center";
+}
+
+void formatLogPayload(LogRecordType type, const char* payload, unsigned int length, std::string& output)
+{
+    if (type == LOG_RECORD_TEXT)
+    {
+        output.append(payload, length);
+        return;
+    }
+
+    // copy into an aligned and zero initialized payload, so short or truncated records are read safely
+    LogRecordPayload event{};
+    std::memcpy(&event, payload, std::min<size_t>(length, sizeof(event)));
+
+    switch (type)
+    {
+    case LOG_RECORD_SET_INDICATOR:
+        formatSetIndicator(event.setIndicator, output);
+        break;
+    case LOG_RECORD_SET_INDICATOR_BATCH:
+        formatSetIndicatorBatch(event.setIndicatorBatch, output);
+        break;
+    case LOG_RECORD_REMOVE_INDICATORS:
+        formatRemoveIndicators(event.removeIndicators, output);
+        break;
+    case LOG_RECORD_AIRCRAFT_STATE:
+        formatAircraftState(event.aircraftState, output);
+        break;
+    case LOG_RECORD_GATE:
+        formatGate(event.gate, output);
+        break;
+    default:
+        output += "Unknown log record type " + std::to_string(type);
+        break;
+    }
+}
\ No newline at end of file
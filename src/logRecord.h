@@ -0,0 +1,116 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include <string>
+
+/// Maximum number of characters of a log message, longer messages are truncated
+#define LOG_RECORD_TEXT_LENGTH 480
+
+/// Maximum number of indicator ids which are stored in a REMOVE log event
+#define LOG_EVENT_MAX_IDS (LOG_RECORD_TEXT_LENGTH / 2 - 2)
+
+/// <summary>
+/// Kind of the payload of a log record. Except for text, the payload holds the raw values which are only
+/// formatted when the record is printed.
+/// </summary>
+enum LogRecordType : uchar {
+    LOG_RECORD_TEXT,
+    LOG_RECORD_SET_INDICATOR,
+    LOG_RECORD_SET_INDICATOR_BATCH,
+    LOG_RECORD_REMOVE_INDICATORS,
+    LOG_RECORD_AIRCRAFT_STATE,
+    LOG_RECORD_GATE,
+};
+
+/// <summary>
+/// Executed SET command.
+/// </summary>
+struct SetIndicatorLogEvent {
+    ushort id;
+    uint indicatorTypeID;
+    /// Latitude, longitude, altitude, heading, bank and pitch
+    double position[6];
+};
+
+/// <summary>
+/// Executed SET_BATCH command.
+/// </summary>
+struct SetIndicatorBatchLogEvent {
+    ushort count;
+    ushort firstID;
+    ushort lastID;
+};
+
+/// <summary>
+/// Executed REMOVE command. Only the first LOG_EVENT_MAX_IDS ids are stored.
+/// </summary>
+struct RemoveIndicatorsLogEvent {
+    /// Number of ids of the command, 0 means all indicators
+    ushort count;
+    ushort ids[LOG_EVENT_MAX_IDS];
+};
+
+/// <summary>
+/// Received aircraft state.
+/// </summary>
+struct AircraftStateLogEvent {
+    /// Latitude, longitude, altitude, heading, bank, pitch and speed
+    double values[7];
+};
+
+/// <summary>
+/// Detected ring passage.
+/// </summary>
+struct GateLogEvent {
+    ushort id;
+    /// true if the aircraft passed through the ring, false if it missed it
+    bool passed;
+    /// Distance from the center of the ring in m
+    double missDistance;
+};
+
+/// <summary>
+/// Payload of a log record, the type is stored next to it.
+/// </summary>
+union LogRecordPayload {
+    char text[LOG_RECORD_TEXT_LENGTH];
+    SetIndicatorLogEvent setIndicator;
+    SetIndicatorBatchLogEvent setIndicatorBatch;
+    RemoveIndicatorsLogEvent removeIndicators;
+    AircraftStateLogEvent aircraftState;
+    GateLogEvent gate;
+};
+
+/// <summary>
+/// Returns the number of payload bytes which have to be stored for the given REMOVE event.
+/// </summary>
+/// <param name="event">The REMOVE event</param>
+/// <returns>Used bytes of the event</returns>
+unsigned int getRemoveIndicatorsLogEventLength(const RemoveIndicatorsLogEvent& event);
+
+/// <summary>
+/// Formats the payload of a log record and appends the message to output.
+/// </summary>
+/// <param name="type">Type of the payload</param>
+/// <param name="payload">Raw payload, does not need to be aligned</param>
+/// <param name="length">Number of valid bytes of the payload</param>
+/// <param name="output">Receives the message</param>
+void formatLogPayload(LogRecordType type, const char* payload, unsigned int length, std::string& output);
\ No newline at end of file
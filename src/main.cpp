@@ -20,16 +20,27 @@
 #include "console.h"
 #include "stringHelper.h"
 #include "log.h"
+#include "binaryLog.h"
+#include "fakeSimBackend.h"
+#include "simConnectBackend.h"
+#include "telemetry.h"
+#include "telemetryFormat.h"
+#include "indicatorVirtualizer.h"
+#include "objectScheduler.h"
 
 #include <string>
 #include <vector>
 #include <iostream>
+#include <cstring>
 
 #define DEFAULT_SEND_IP_ADDR "127.0.0.1"
 #define DEFAULT_SEND_UDP_PORT 10988
 
 #define DEFAULT_RECV_UDP_PORT 10388
 
+#define DEFAULT_COMMAND_QUEUE_CAPACITY 4096
+#define DEFAULT_COMMAND_QUEUE_POLICY DROP_OLDEST
+
 bool isIPAddressValid(std::string ipAddress)
 {
     std::vector<std::string> ipAddressParts = splitString(ipAddress, '.');
@@ -57,11 +68,102 @@ bool isIPAddressValid(std::string ipAddress)
     return true;
 }
 
+bool parseOverflowPolicy(std::string policyName, OverflowPolicy* policy)
+{
+    if (policyName == "drop-oldest")
+    {
+        *policy = DROP_OLDEST;
+    }
+    else if (policyName == "drop-newest")
+    {
+        *policy = DROP_NEWEST;
+    }
+    else if (policyName == "block")
+    {
+        *policy = BLOCK;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool parseLogLevel(std::string levelName, LogLevel* level)
+{
+    if (levelName == "info")
+    {
+        *level = LOG_LEVEL_INFO;
+    }
+    else if (levelName == "warning")
+    {
+        *level = LOG_LEVEL_WARNING;
+    }
+    else if (levelName == "error")
+    {
+        *level = LOG_LEVEL_ERROR;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool parseFakeSimConfiguration(std::string specification, FakeSimBackendConfiguration* configuration)
+{
+    // latency:jitter:failure rate:object cap
+    std::vector<std::string> parts = splitString(specification, ':');
+    if (parts.size() != 4)
+    {
+        return false;
+    }
+
+    try {
+        int latency = std::stoi(parts[0]);
+        int jitter = std::stoi(parts[1]);
+        double failureRate = std::stod(parts[2]);
+        int objectCap = std::stoi(parts[3]);
+
+        if (latency < 0 || jitter < 0 || failureRate < 0 || failureRate > 1 || objectCap < 0)
+        {
+            return false;
+        }
+
+        configuration->latency = static_cast<uint>(latency);
+        configuration->jitter = static_cast<uint>(jitter);
+        configuration->failureRate = failureRate;
+        configuration->objectCap = static_cast<uint>(objectCap);
+    }
+    catch (std::invalid_argument)
+    {
+        return false;
+    }
+
+    return true;
+}
+
 int main(int argc, char* argv[])
 {
     ushort serverPort = DEFAULT_RECV_UDP_PORT;
     std::string targetIP = DEFAULT_SEND_IP_ADDR;
     ushort targetPort = DEFAULT_SEND_UDP_PORT;
+    uint commandQueueCapacity = DEFAULT_COMMAND_QUEUE_CAPACITY;
+    OverflowPolicy commandQueuePolicy = DEFAULT_COMMAND_QUEUE_POLICY;
+    LogLevel logLevel = LOG_LEVEL_INFO;
+    std::string binaryLogPath;
+#ifdef _WIN32
+    bool useFakeSim = false;
+#else
+    bool useFakeSim = true; // SimConnect is only available on Windows
+#endif
+    FakeSimBackendConfiguration fakeSimConfiguration;
+    TelemetryConfiguration telemetryConfiguration;
+    TelemetryFormat telemetryFormat = TELEMETRY_FORMAT_V1;
+    VirtualizationConfiguration virtualizationConfiguration;
+    ObjectSchedulerConfiguration objectSchedulerConfiguration;
     FlightPathVisualizer fpv;
 
     Logger::logMessage("Flight Path Visualizer - MSFS Extension");
@@ -73,7 +175,7 @@ int main(int argc, char* argv[])
     {
         if (strcmp(argv[i], "-h") == 0)
         {
-            printHelp(DEFAULT_RECV_UDP_PORT, DEFAULT_SEND_IP_ADDR, DEFAULT_SEND_UDP_PORT);
+            printHelp(DEFAULT_RECV_UDP_PORT, DEFAULT_SEND_IP_ADDR, DEFAULT_SEND_UDP_PORT, DEFAULT_COMMAND_QUEUE_CAPACITY);
             return 0;
         }
         else if (strcmp(argv[i], "-p") == 0)
@@ -136,21 +238,161 @@ int main(int argc, char* argv[])
                 break;
             }
         }
+        else if (strcmp(argv[i], "-qs") == 0)
+        {
+            if (argc <= ++i)
+            {
+                cmdParamsValid = false;
+                break;
+            }
+            try {
+                int capacityRaw = std::stoi(argv[i]);
+                if (capacityRaw < 1)
+                {
+                    cmdParamsValid = false;
+                    break;
+                }
+                commandQueueCapacity = static_cast<uint>(capacityRaw);
+            }
+            catch (std::invalid_argument)
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-qp") == 0)
+        {
+            if (argc <= ++i || !parseOverflowPolicy(argv[i], &commandQueuePolicy))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-ll") == 0)
+        {
+            if (argc <= ++i || !parseLogLevel(argv[i], &logLevel))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-lf") == 0)
+        {
+            if (argc <= ++i)
+            {
+                cmdParamsValid = false;
+                break;
+            }
+
+            binaryLogPath = argv[i];
+        }
+        else if (strcmp(argv[i], "-fs") == 0)
+        {
+            if (argc <= ++i || !parseFakeSimConfiguration(argv[i], &fakeSimConfiguration))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+
+            useFakeSim = true;
+        }
+        else if (strcmp(argv[i], "-tr") == 0)
+        {
+            if (argc <= ++i || !parseTelemetryConfiguration(argv[i], &telemetryConfiguration))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-tf") == 0)
+        {
+            if (argc <= ++i || !parseTelemetryFormat(argv[i], &telemetryFormat))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-vr") == 0)
+        {
+            if (argc <= ++i || !parseVirtualizationConfiguration(argv[i], &virtualizationConfiguration))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-or") == 0)
+        {
+            if (argc <= ++i || !parseObjectSchedulerConfiguration(argv[i], &objectSchedulerConfiguration))
+            {
+                cmdParamsValid = false;
+                break;
+            }
+        }
+        else if (strcmp(argv[i], "-rl") == 0)
+        {
+            if (argc <= ++i)
+            {
+                cmdParamsValid = false;
+                break;
+            }
+
+            return renderBinaryLog(argv[i]) ? 0 : -1;
+        }
     }
 
     if (!cmdParamsValid)
     {
         Logger::logMessage("Invalid syntax");
-        printHelp(DEFAULT_RECV_UDP_PORT, DEFAULT_SEND_IP_ADDR, DEFAULT_SEND_UDP_PORT);
+        printHelp(DEFAULT_RECV_UDP_PORT, DEFAULT_SEND_IP_ADDR, DEFAULT_SEND_UDP_PORT, DEFAULT_COMMAND_QUEUE_CAPACITY);
         return -1;
     }
 
     Logger::logMessage("Using ingoing port " + std::to_string(serverPort) + 
         ", target ip address " + targetIP + 
-     ", target port " + std::to_string(targetPort));
+     ", target port " + std::to_string(targetPort) +
+        ", command queue capacity " + std::to_string(commandQueueCapacity));
+
+    Logger::setLogLevel(logLevel);
+    if (!binaryLogPath.empty())
+    {
+        if (!Logger::openBinaryLog(binaryLogPath))
+        {
+            Logger::logError("Binary log " + binaryLogPath + " could not be opened.");
+            return -1;
+        }
+        Logger::logMessage("Writing log to " + binaryLogPath);
+    }
+    Logger::start();
+
+    std::unique_ptr<SimBackend> simBackend;
+    if (useFakeSim)
+    {
+        Logger::logMessage("Using fake simulation: latency " + std::to_string(fakeSimConfiguration.latency) + " ms, jitter " +
+            std::to_string(fakeSimConfiguration.jitter) + " ms, failure rate " + std::to_string(fakeSimConfiguration.failureRate) +
+            ", object cap " + std::to_string(fakeSimConfiguration.objectCap));
+        simBackend = std::make_unique<FakeSimBackend>(fakeSimConfiguration);
+    }
+#ifdef _WIN32
+    else
+    {
+        simBackend = std::make_unique<SimConnectBackend>();
+    }
+#endif
+
+    if (virtualizationConfiguration.radius > 0)
+    {
+        Logger::logMessage("Materializing indicators within " + std::to_string(virtualizationConfiguration.radius / 1000.0) + " km" +
+            (virtualizationConfiguration.maxCount != 0 ? ", at most " + std::to_string(virtualizationConfiguration.maxCount) : std::string()));
+    }
+
+    if (objectSchedulerConfiguration.rate > 0)
+    {
+        Logger::logMessage("Pacing SimObject creations and removals to " + std::to_string(objectSchedulerConfiguration.rate) + " per second, bursts of " +
+            std::to_string(objectSchedulerConfiguration.burst));
+    }
 
-    fpv = FlightPathVisualizer();
-    fpv.start(serverPort, targetIP, targetPort);
+    fpv.start(serverPort, targetIP, targetPort, commandQueueCapacity, commandQueuePolicy, std::move(simBackend), telemetryConfiguration, telemetryFormat,
+        virtualizationConfiguration, objectSchedulerConfiguration);
 
     bool appRunning = true;
     std::string command;
@@ -162,6 +404,7 @@ int main(int argc, char* argv[])
         {
             appRunning = false;
             fpv.shutdown();
+            Logger::stop();
         }
         else if (command == "resetMappings")
         {
@@ -171,5 +414,24 @@ int main(int argc, char* argv[])
         {
             fpv.removeAllIndicators();
         }
+        else if (command == "stats")
+        {
+            fpv.logStatistics();
+        }
+        else if (command == "telemetry")
+        {
+            std::string specification;
+            std::cin >> specification;
+
+            TelemetryConfiguration configuration;
+            if (parseTelemetryConfiguration(specification, &configuration))
+            {
+                fpv.setTelemetryConfiguration(configuration);
+            }
+            else
+            {
+                Logger::logError("Invalid telemetry period: " + specification);
+            }
+        }
     }
 }
\ No newline at end of file
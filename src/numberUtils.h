@@ -19,11 +19,29 @@
 #pragma once
 
 #include <math.h>
+#include <cstring>
+#include <cstdint>
+#include <utility>
 #include "datatypes.h"
 
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
 /// The precision threshold for double values
 #define DOUBLE_PRECISION 0.0000000001
 
+/// Byte swap of a single value, compiled to one bswap instruction (the network byte order differs from the little endian host)
+#ifdef _MSC_VER
+#define BYTESWAP_16(x) _byteswap_ushort(x)
+#define BYTESWAP_32(x) _byteswap_ulong(x)
+#define BYTESWAP_64(x) _byteswap_uint64(x)
+#else
+#define BYTESWAP_16(x) __builtin_bswap16(x)
+#define BYTESWAP_32(x) __builtin_bswap32(x)
+#define BYTESWAP_64(x) __builtin_bswap64(x)
+#endif
+
 /// <summary>
 /// Compares two double values if they are equals according to the used double precision.
 /// </summary>
@@ -50,62 +68,74 @@ inline bool isDoubleInRange(double value, double min, double max)
 
 inline void writeDoubleInNetworkByteOrder(double value, char* dst)
 {
-    char tmp[8];
-    std::memcpy(tmp, &value, 8);
-    for (int i = 0; i < 8; ++i)
-    {
-        dst[i] = tmp[7 - i];
-    }
+    uint64_t tmp;
+    std::memcpy(&tmp, &value, sizeof(tmp));
+    tmp = BYTESWAP_64(tmp);
+    std::memcpy(dst, &tmp, sizeof(tmp));
 }
 
 inline void writeUshortInNetworkByteOrder(ushort value, char* dst)
 {
-    char tmp[2];
-    std::memcpy(tmp, &value, 2);
-    for (int i = 0; i < 2; ++i)
-    {
-        dst[i] = tmp[1 - i];
-    }
+    ushort tmp = BYTESWAP_16(value);
+    std::memcpy(dst, &tmp, sizeof(tmp));
 }
 
-inline ushort readUShortNetworkByteOrder(const char* src)
+inline void writeUintInNetworkByteOrder(uint value, char* dst)
 {
-    char tmp[2];
+    uint tmp = BYTESWAP_32(value);
+    std::memcpy(dst, &tmp, sizeof(tmp));
+}
 
-    for (int i = 0; i < 2; ++i)
-    {
-        tmp[i] = src[1 - i];
-    }
+inline void writeUint64InNetworkByteOrder(uint64_t value, char* dst)
+{
+    uint64_t tmp = BYTESWAP_64(value);
+    std::memcpy(dst, &tmp, sizeof(tmp));
+}
 
+inline void writeFloatInNetworkByteOrder(float value, char* dst)
+{
+    uint tmp;
+    std::memcpy(&tmp, &value, sizeof(tmp));
+    writeUintInNetworkByteOrder(tmp, dst);
+}
+
+inline ushort readUShortNetworkByteOrder(const char* src)
+{
     ushort value;
-    std::memcpy(&value, tmp, sizeof(value));
-    return value;
+    std::memcpy(&value, src, sizeof(value));
+    return BYTESWAP_16(value);
 }
 
 inline uint readUintNetworkByteOrder(const char* src)
 {
-    char tmp[4];
+    uint value;
+    std::memcpy(&value, src, sizeof(value));
+    return BYTESWAP_32(value);
+}
 
-    for (int i = 0; i < 4; ++i)
-    {
-        tmp[i] = src[3 - i];
-    }
+inline double readDoubleinNetworkByteOrder(const char* src)
+{
+    uint64_t tmp;
+    std::memcpy(&tmp, src, sizeof(tmp));
+    tmp = BYTESWAP_64(tmp);
 
-    uint value;
-    std::memcpy(&value, tmp, sizeof(value));
+    double value;
+    std::memcpy(&value, &tmp, sizeof(value));
     return value;
 }
 
-inline double readDoubleinNetworkByteOrder(const char* src)
+inline uint64_t readUint64NetworkByteOrder(const char* src)
 {
-    char tmp[8];
+    uint64_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return BYTESWAP_64(value);
+}
 
-    for (int i = 0; i < 8; ++i)
-    {
-        tmp[i] = src[7 - i];
-    }
+inline float readFloatNetworkByteOrder(const char* src)
+{
+    uint tmp = readUintNetworkByteOrder(src);
 
-    double value;
-    std::memcpy(&value, tmp, sizeof(value));
+    float value;
+    std::memcpy(&value, &tmp, sizeof(value));
     return value;
 }
\ No newline at end of file
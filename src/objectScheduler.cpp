@@ -0,0 +1,350 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "objectScheduler.h"
+#include "indicatorRegistry.h"
+#include "geodesy.h"
+
+#include <cmath>
+#include <charconv>
+#include <algorithm>
+
+/// Marks an indicator without waiting creation in createIndices
+#define NOT_QUEUED 0xFFFFFFFFu
+
+/// Taken removals are erased from the front of the queue when there are more than this number
+#define REMOVE_COMPACTION_THRESHOLD 1024
+
+bool parseObjectSchedulerConfiguration(const std::string& specification, ObjectSchedulerConfiguration* configuration)
+{
+    ObjectSchedulerConfiguration parsed;
+    size_t separator = specification.find(':');
+    const char* first = specification.data();
+    const char* last = specification.data() + std::min(separator, specification.size());
+
+    std::from_chars_result res = std::from_chars(first, last, parsed.rate);
+    if (res.ec != std::errc() || res.ptr != last || !(parsed.rate >= 0))
+    {
+        return false;
+    }
+
+    if (separator != std::string::npos)
+    {
+        first = specification.data() + separator + 1;
+        last = specification.data() + specification.size();
+        res = std::from_chars(first, last, parsed.burst);
+        if (res.ec != std::errc() || res.ptr != last || parsed.burst == 0)
+        {
+            return false;
+        }
+    }
+
+    *configuration = parsed;
+    return true;
+}
+
+ObjectScheduler::ObjectScheduler()
+    : tokens(OBJECT_SCHEDULER_DEFAULT_BURST), lastRefill(std::chrono::steady_clock::now()), createIndices(INDICATOR_REGISTRY_SIZE, NOT_QUEUED)
+{
+}
+
+void ObjectScheduler::configure(const ObjectSchedulerConfiguration& configuration)
+{
+    std::scoped_lock lk(mutex);
+    this->configuration = configuration;
+    tokens = std::min(tokens, static_cast<double>(configuration.burst));
+}
+
+bool ObjectScheduler::isEnabled() const
+{
+    std::scoped_lock lk(mutex);
+    return configuration.rate > 0;
+}
+
+bool ObjectScheduler::scheduleCreate(ushort id, uint requestID, double latitude, double longitude, std::chrono::steady_clock::time_point time)
+{
+    std::scoped_lock lk(mutex);
+    bool wasEmpty = getQueueDepth() == 0;
+
+    // a replaced request keeps the waiting time of the first one
+    uint index = createIndices[id];
+    if (index != NOT_QUEUED)
+    {
+        PendingCreate& create = creates[index];
+        create.requestID = requestID;
+        create.latitude = latitude;
+        create.longitude = longitude;
+        return wasEmpty;
+    }
+
+    createIndices[id] = static_cast<uint>(creates.size());
+    creates.push_back(PendingCreate{ id, requestID, latitude, longitude, nextSequence++, time });
+    maxQueueDepth = std::max(maxQueueDepth, getQueueDepth());
+    return wasEmpty;
+}
+
+void ObjectScheduler::updateCreate(ushort id, double latitude, double longitude)
+{
+    std::scoped_lock lk(mutex);
+
+    uint index = createIndices[id];
+    if (index != NOT_QUEUED)
+    {
+        creates[index].latitude = latitude;
+        creates[index].longitude = longitude;
+    }
+}
+
+bool ObjectScheduler::cancelCreate(ushort id)
+{
+    std::scoped_lock lk(mutex);
+
+    uint index = createIndices[id];
+    if (index == NOT_QUEUED)
+    {
+        return false;
+    }
+
+    removeCreate(index);
+    canceled++;
+    return true;
+}
+
+bool ObjectScheduler::scheduleRemove(uint simObjectID, std::chrono::steady_clock::time_point time)
+{
+    std::scoped_lock lk(mutex);
+    bool wasEmpty = getQueueDepth() == 0;
+
+    removes.push_back(PendingRemove{ simObjectID, time });
+    maxQueueDepth = std::max(maxQueueDepth, getQueueDepth());
+    return wasEmpty;
+}
+
+void ObjectScheduler::takeDue(std::chrono::steady_clock::time_point time, double latitude, double longitude, bool hasPosition,
+    std::vector<uint>& dueRemoves, std::vector<ScheduledCreate>& dueCreates)
+{
+    std::scoped_lock lk(mutex);
+
+    if (getQueueDepth() == 0)
+    {
+        return;
+    }
+
+    // without pacing, e.g. after it was disabled, everything which is waiting is taken
+    size_t available = getQueueDepth();
+    if (configuration.rate > 0)
+    {
+        refill(time);
+        available = static_cast<size_t>(tokens);
+    }
+
+    size_t removeCount = std::min(available, removes.size() - removeOffset);
+    for (size_t i = removeOffset; i < removeOffset + removeCount; i++)
+    {
+        dueRemoves.push_back(removes[i].simObjectID);
+        recordWait(removes[i].queued, time);
+    }
+    removeOffset += removeCount;
+    if (removeOffset == removes.size())
+    {
+        removes.clear();
+        removeOffset = 0;
+    }
+    else if (removeOffset > REMOVE_COMPACTION_THRESHOLD && removeOffset * 2 > removes.size())
+    {
+        removes.erase(removes.begin(), removes.begin() + removeOffset);
+        removeOffset = 0;
+    }
+
+    size_t createCount = std::min(available - removeCount, creates.size());
+    if (createCount > 0)
+    {
+        // only the order matters, so the distance is approximated in the plane around the aircraft
+        double longitudeScale = std::cos(latitude * DEGREES_TO_RADIANS);
+        order.clear();
+        for (uint i = 0; i < creates.size(); i++)
+        {
+            const PendingCreate& create = creates[i];
+            double key = static_cast<double>(create.sequence);
+            if (hasPosition)
+            {
+                double north = create.latitude - latitude;
+                double east = getLongitudeDifference(longitude, create.longitude) * longitudeScale;
+                key = north * north + east * east;
+            }
+            order.emplace_back(key, i);
+        }
+
+        if (createCount < order.size())
+        {
+            std::nth_element(order.begin(), order.begin() + createCount, order.end());
+        }
+        std::sort(order.begin(), order.begin() + createCount);
+
+        size_t first = dueCreates.size();
+        for (size_t i = 0; i < createCount; i++)
+        {
+            const PendingCreate& create = creates[order[i].second];
+            dueCreates.push_back(ScheduledCreate{ create.id, create.requestID });
+            recordWait(create.queued, time);
+        }
+
+        // removing shifts the indices, so the taken creations are looked up by their id
+        for (size_t i = first; i < dueCreates.size(); i++)
+        {
+            removeCreate(createIndices[dueCreates[i].id]);
+        }
+    }
+
+    takenRemoves += removeCount;
+    takenCreates += createCount;
+    if (configuration.rate > 0)
+    {
+        tokens -= static_cast<double>(removeCount + createCount);
+    }
+}
+
+void ObjectScheduler::takeAllRemoves(std::vector<uint>& dueRemoves)
+{
+    std::scoped_lock lk(mutex);
+
+    for (size_t i = removeOffset; i < removes.size(); i++)
+    {
+        dueRemoves.push_back(removes[i].simObjectID);
+    }
+    takenRemoves += removes.size() - removeOffset;
+    removes.clear();
+    removeOffset = 0;
+}
+
+size_t ObjectScheduler::acquire(size_t count, std::chrono::steady_clock::time_point time)
+{
+    std::scoped_lock lk(mutex);
+
+    if (configuration.rate <= 0)
+    {
+        return count;
+    }
+    if (getQueueDepth() > 0)
+    {
+        return 0;
+    }
+
+    refill(time);
+    size_t granted = std::min(count, static_cast<size_t>(tokens));
+    tokens -= static_cast<double>(granted);
+    return granted;
+}
+
+void ObjectScheduler::release(size_t count)
+{
+    std::scoped_lock lk(mutex);
+
+    if (configuration.rate > 0)
+    {
+        tokens = std::min(tokens + static_cast<double>(count), static_cast<double>(configuration.burst));
+    }
+}
+
+uint ObjectScheduler::getWaitTimeout(std::chrono::steady_clock::time_point time, uint maxTimeout)
+{
+    std::scoped_lock lk(mutex);
+
+    if (getQueueDepth() == 0)
+    {
+        return maxTimeout;
+    }
+    if (configuration.rate <= 0)
+    {
+        return 0;
+    }
+
+    refill(time);
+    if (tokens >= 1)
+    {
+        return 0;
+    }
+
+    double timeout = std::ceil((1 - tokens) * 1000.0 / configuration.rate);
+    return static_cast<uint>(std::clamp(timeout, 1.0, static_cast<double>(maxTimeout)));
+}
+
+void ObjectScheduler::clear()
+{
+    std::scoped_lock lk(mutex);
+
+    for (const PendingCreate& create : creates)
+    {
+        createIndices[create.id] = NOT_QUEUED;
+    }
+    creates.clear();
+    removes.clear();
+    removeOffset = 0;
+}
+
+ObjectSchedulerStatistics ObjectScheduler::getStatistics() const
+{
+    std::scoped_lock lk(mutex);
+
+    ObjectSchedulerStatistics statistics;
+    statistics.queuedCreates = creates.size();
+    statistics.queuedRemoves = removes.size() - removeOffset;
+    statistics.maxQueueDepth = maxQueueDepth;
+    statistics.creates = takenCreates;
+    statistics.removes = takenRemoves;
+    statistics.canceled = canceled;
+    statistics.averageWait = takenCreates + takenRemoves > 0 ? waitSum / (takenCreates + takenRemoves) : 0;
+    statistics.maxWait = waitMax;
+    return statistics;
+}
+
+void ObjectScheduler::refill(std::chrono::steady_clock::time_point time)
+{
+    // the callers run in different threads, a time before the last refill adds nothing
+    if (time <= lastRefill)
+    {
+        return;
+    }
+
+    double elapsed = std::chrono::duration<double>(time - lastRefill).count();
+    tokens = std::min(tokens + elapsed * configuration.rate, static_cast<double>(configuration.burst));
+    lastRefill = time;
+}
+
+size_t ObjectScheduler::getQueueDepth() const
+{
+    return creates.size() + removes.size() - removeOffset;
+}
+
+void ObjectScheduler::recordWait(std::chrono::steady_clock::time_point queued, std::chrono::steady_clock::time_point time)
+{
+    unsigned long long wait = time > queued ? std::chrono::duration_cast<std::chrono::microseconds>(time - queued).count() : 0;
+    waitSum += wait;
+    waitMax = std::max(waitMax, wait);
+}
+
+void ObjectScheduler::removeCreate(uint index)
+{
+    createIndices[creates[index].id] = NOT_QUEUED;
+    if (index != creates.size() - 1)
+    {
+        creates[index] = creates.back();
+        createIndices[creates[index].id] = index;
+    }
+    creates.pop_back();
+}
\ No newline at end of file
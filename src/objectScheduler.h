@@ -0,0 +1,315 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+/// Default rate of SimObject creations and removals (per second)
+#define OBJECT_SCHEDULER_DEFAULT_RATE 100.0
+
+/// Default number of operations which may be executed at once after a quiet period
+#define OBJECT_SCHEDULER_DEFAULT_BURST 20
+
+/// <summary>
+/// Configuration of the token bucket which paces the SimObject creations and removals.
+/// </summary>
+struct ObjectSchedulerConfiguration {
+    /// <summary>
+    /// Operations per second, 0 to execute every operation immediately
+    /// </summary>
+    double rate = OBJECT_SCHEDULER_DEFAULT_RATE;
+
+    /// <summary>
+    /// Capacity of the token bucket, the maximum number of operations executed at once
+    /// </summary>
+    uint burst = OBJECT_SCHEDULER_DEFAULT_BURST;
+};
+
+/// <summary>
+/// Snapshot of the counters of the object scheduler.
+/// </summary>
+struct ObjectSchedulerStatistics {
+    size_t queuedCreates;            // creations waiting for a token
+    size_t queuedRemoves;            // removals waiting for a token
+    size_t maxQueueDepth;            // maximum number of waiting operations
+    unsigned long long creates;      // creations taken from the queue
+    unsigned long long removes;      // removals taken from the queue
+    unsigned long long canceled;     // waiting creations which were canceled, e.g. because the indicator was removed
+    unsigned long long averageWait;  // average time an operation waited in the queue in microseconds
+    unsigned long long maxWait;      // maximum time an operation waited in the queue in microseconds
+};
+
+/// <summary>
+/// Creation of an indicator SimObject which is due.
+/// </summary>
+struct ScheduledCreate {
+    ushort id;      // external indicator id
+    uint requestID; // request id of the create request
+};
+
+/// <summary>
+/// Parses a scheduler configuration in the format "rate[:burst]", e.g. 50:10. A rate of 0 disables the pacing.
+/// </summary>
+/// <param name="specification">Text to parse</param>
+/// <param name="configuration">Receives the parsed configuration</param>
+/// <returns>False if the text is invalid</returns>
+bool parseObjectSchedulerConfiguration(const std::string& specification, ObjectSchedulerConfiguration* configuration);
+
+/// <summary>
+/// Paces the creations and removals of SimObjects with a token bucket, so a bulk upload does not stall the simulation.
+///
+/// Each operation takes one token, the bucket is refilled with the configured rate up to the burst size. Waiting removals are
+/// taken first, because they free resources in the simulation, then the waiting creations nearest to the aircraft. Each indicator
+/// has at most one waiting creation, a new create request of the same indicator replaces it and keeps its place in the queue.
+/// Operations which are not queued, e.g. the refills of the pools, take the remaining tokens with acquire.
+///
+/// The scheduler is thread-safe.
+/// </summary>
+class ObjectScheduler
+{
+public:
+    /// <summary>
+    /// Creates a scheduler with the default configuration.
+    /// </summary>
+    ObjectScheduler();
+
+    /// <summary>
+    /// Changes the configuration. Waiting operations are kept.
+    /// </summary>
+    /// <param name="configuration">New configuration</param>
+    void configure(const ObjectSchedulerConfiguration& configuration);
+
+    /// <summary>
+    /// Returns true if the operations are paced.
+    /// </summary>
+    /// <returns>False if every operation is executed immediately</returns>
+    bool isEnabled() const;
+
+    /// <summary>
+    /// Queues the creation of the SimObject of an indicator.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="requestID">Request id of the create request</param>
+    /// <param name="latitude">Latitude of the indicator in degrees</param>
+    /// <param name="longitude">Longitude of the indicator in degrees</param>
+    /// <param name="time">Current time</param>
+    /// <returns>True if no operation was waiting before, so the caller wakes up the dispatcher</returns>
+    bool scheduleCreate(ushort id, uint requestID, double latitude, double longitude, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Updates the position of a waiting creation, which decides its order.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="latitude">Latitude of the indicator in degrees</param>
+    /// <param name="longitude">Longitude of the indicator in degrees</param>
+    void updateCreate(ushort id, double latitude, double longitude);
+
+    /// <summary>
+    /// Removes the waiting creation of an indicator, e.g. because it was removed before its SimObject was requested.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <returns>False if no creation was waiting</returns>
+    bool cancelCreate(ushort id);
+
+    /// <summary>
+    /// Queues the removal of a SimObject.
+    /// </summary>
+    /// <param name="simObjectID">Id of the SimObject</param>
+    /// <param name="time">Current time</param>
+    /// <returns>True if no operation was waiting before, so the caller wakes up the dispatcher</returns>
+    bool scheduleRemove(uint simObjectID, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Takes the operations for which tokens are available, the removals first and then the creations nearest to the aircraft.
+    /// Without the aircraft position the creations are taken in the order of their requests.
+    /// </summary>
+    /// <param name="time">Current time</param>
+    /// <param name="latitude">Latitude of the aircraft in degrees</param>
+    /// <param name="longitude">Longitude of the aircraft in degrees</param>
+    /// <param name="hasPosition">False if the aircraft position is not known</param>
+    /// <param name="dueRemoves">Receives the SimObjects which have to be removed</param>
+    /// <param name="dueCreates">Receives the indicators whose SimObjects have to be created, the nearest first</param>
+    void takeDue(std::chrono::steady_clock::time_point time, double latitude, double longitude, bool hasPosition, std::vector<uint>& dueRemoves,
+        std::vector<ScheduledCreate>& dueCreates);
+
+    /// <summary>
+    /// Takes all waiting removals regardless of the tokens, e.g. before the connection is closed.
+    /// </summary>
+    /// <param name="dueRemoves">Receives the SimObjects which have to be removed</param>
+    void takeAllRemoves(std::vector<uint>& dueRemoves);
+
+    /// <summary>
+    /// Takes tokens for operations which are not queued. Waiting operations are served first.
+    /// </summary>
+    /// <param name="count">Number of requested tokens</param>
+    /// <param name="time">Current time</param>
+    /// <returns>Number of granted tokens, count if the operations are not paced</returns>
+    size_t acquire(size_t count, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Returns tokens of acquire which were not used.
+    /// </summary>
+    /// <param name="count">Number of unused tokens</param>
+    void release(size_t count);
+
+    /// <summary>
+    /// Returns how long the dispatcher may wait until the next waiting operation gets a token.
+    /// </summary>
+    /// <param name="time">Current time</param>
+    /// <param name="maxTimeout">Timeout if no operation is waiting in ms</param>
+    /// <returns>Timeout in ms</returns>
+    uint getWaitTimeout(std::chrono::steady_clock::time_point time, uint maxTimeout);
+
+    /// <summary>
+    /// Drops all waiting operations, e.g. because the SimObjects were lost with the connection.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <returns>Statistics of the scheduler</returns>
+    ObjectSchedulerStatistics getStatistics() const;
+
+private:
+    /// <summary>
+    /// Waiting creation of an indicator.
+    /// </summary>
+    struct PendingCreate {
+        ushort id;
+        uint requestID;
+        double latitude;
+        double longitude;
+        unsigned long long sequence; // order of the requests
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    /// <summary>
+    /// Waiting removal of a SimObject.
+    /// </summary>
+    struct PendingRemove {
+        uint simObjectID;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    /// <summary>
+    /// Guards all members.
+    /// </summary>
+    mutable std::mutex mutex;
+
+    /// <summary>
+    /// Current configuration.
+    /// </summary>
+    ObjectSchedulerConfiguration configuration;
+
+    /// <summary>
+    /// Tokens in the bucket.
+    /// </summary>
+    double tokens = 0;
+
+    /// <summary>
+    /// Time of the last refill of the bucket.
+    /// </summary>
+    std::chrono::steady_clock::time_point lastRefill;
+
+    /// <summary>
+    /// Waiting creations in no particular order.
+    /// </summary>
+    std::vector<PendingCreate> creates;
+
+    /// <summary>
+    /// Index of each indicator in creates, indexed by external indicator id, NOT_QUEUED if no creation is waiting.
+    /// </summary>
+    std::vector<uint> createIndices;
+
+    /// <summary>
+    /// Waiting removals in the order of their requests.
+    /// </summary>
+    std::vector<PendingRemove> removes;
+
+    /// <summary>
+    /// Number of removals at the front of removes which were already taken.
+    /// </summary>
+    size_t removeOffset = 0;
+
+    /// <summary>
+    /// Sequence number of the next creation.
+    /// </summary>
+    unsigned long long nextSequence = 0;
+
+    /// <summary>
+    /// Order keys of the current takeDue call, kept to avoid allocations.
+    /// </summary>
+    std::vector<std::pair<double, uint>> order;
+
+    /// <summary>
+    /// Maximum number of waiting operations.
+    /// </summary>
+    size_t maxQueueDepth = 0;
+
+    /// <summary>
+    /// Number of creations taken from the queue.
+    /// </summary>
+    unsigned long long takenCreates = 0;
+
+    /// <summary>
+    /// Number of removals taken from the queue.
+    /// </summary>
+    unsigned long long takenRemoves = 0;
+
+    /// <summary>
+    /// Number of canceled creations.
+    /// </summary>
+    unsigned long long canceled = 0;
+
+    /// <summary>
+    /// Sum of the waiting times of all taken operations in microseconds.
+    /// </summary>
+    unsigned long long waitSum = 0;
+
+    /// <summary>
+    /// Maximum waiting time in microseconds.
+    /// </summary>
+    unsigned long long waitMax = 0;
+
+    /// <summary>
+    /// Adds the tokens for the time since the last refill.
+    /// </summary>
+    void refill(std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Returns the number of waiting operations.
+    /// </summary>
+    size_t getQueueDepth() const;
+
+    /// <summary>
+    /// Records the waiting time of a taken operation.
+    /// </summary>
+    void recordWait(std::chrono::steady_clock::time_point queued, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Removes the creation at the given index from creates.
+    /// </summary>
+    void removeCreate(uint index);
+};
\ No newline at end of file
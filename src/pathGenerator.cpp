@@ -0,0 +1,236 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pathGenerator.h"
+#include "geodesy.h"
+
+#include <cmath>
+#include <algorithm>
+
+/// <summary>
+/// Normalizes an angle to [0, 360).
+/// </summary>
+static double normalizeHeading(double heading)
+{
+    heading = std::fmod(heading, 360.0);
+    return heading < 0 ? heading + 360.0 : heading;
+}
+
+/// <summary>
+/// Normalizes a longitude to [-180, 180].
+/// </summary>
+static double normalizeLongitude(double longitude)
+{
+    return getLongitudeDifference(0, longitude);
+}
+
+const char* getPathInterpolationName(PathInterpolation interpolation)
+{
+    switch (interpolation)
+    {
+    case PATH_INTERPOLATION_GREAT_CIRCLE: return "great-circle";
+    case PATH_INTERPOLATION_CATMULL_ROM: return "catmull-rom";
+    }
+    return "unknown";
+}
+
+std::span<const WorldPositionStruct> PathGenerator::generate(std::span<const PathWaypoint> waypoints, double spacing, PathInterpolation interpolation,
+    size_t maxCount)
+{
+    positions.clear();
+    isTruncated = false;
+
+    if (waypoints.size() < 2 || !(spacing > 0) || maxCount == 0)
+    {
+        return positions;
+    }
+
+    if (interpolation == PATH_INTERPOLATION_CATMULL_ROM)
+    {
+        generateCatmullRom(waypoints, spacing, maxCount);
+    }
+    else
+    {
+        generateGreatCircle(waypoints, spacing, maxCount);
+    }
+
+    return positions;
+}
+
+bool PathGenerator::wasTruncated() const
+{
+    return isTruncated;
+}
+
+void PathGenerator::generateGreatCircle(std::span<const PathWaypoint> waypoints, double spacing, size_t maxCount)
+{
+    // distance of the next position from the start of the current segment
+    double distance = 0;
+
+    for (size_t i = 0; i + 1 < waypoints.size(); i++)
+    {
+        const PathWaypoint& from = waypoints[i];
+        const PathWaypoint& to = waypoints[i + 1];
+
+        // the segment is the arc between the unit vectors of both waypoints
+        double phi1 = from.latitude * DEGREES_TO_RADIANS;
+        double lambda1 = from.longitude * DEGREES_TO_RADIANS;
+        double phi2 = to.latitude * DEGREES_TO_RADIANS;
+        double lambda2 = to.longitude * DEGREES_TO_RADIANS;
+        double a[3] = { std::cos(phi1) * std::cos(lambda1), std::cos(phi1) * std::sin(lambda1), std::sin(phi1) };
+        double b[3] = { std::cos(phi2) * std::cos(lambda2), std::cos(phi2) * std::sin(lambda2), std::sin(phi2) };
+        double cross[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+        double sinAngle = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+        double angle = std::atan2(sinAngle, a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+        double length = angle * EARTH_MEAN_RADIUS;
+
+        // repeated waypoints have no direction
+        if (length <= 0 || sinAngle <= 0)
+        {
+            continue;
+        }
+
+        double pitch = -std::atan2((to.altitude - from.altitude) * METERS_PER_FOOT, length) / DEGREES_TO_RADIANS;
+
+        for (; distance <= length; distance += spacing)
+        {
+            if (positions.size() == maxCount)
+            {
+                isTruncated = true;
+                return;
+            }
+
+            // spherical linear interpolation and its derivative
+            double fraction = distance / length;
+            double theta = fraction * angle;
+            double weightA = std::sin(angle - theta) / sinAngle;
+            double weightB = std::sin(theta) / sinAngle;
+            double tangentA = -std::cos(angle - theta) / sinAngle;
+            double tangentB = std::cos(theta) / sinAngle;
+            double p[3] = { weightA * a[0] + weightB * b[0], weightA * a[1] + weightB * b[1], weightA * a[2] + weightB * b[2] };
+            double t[3] = { tangentA * a[0] + tangentB * b[0], tangentA * a[1] + tangentB * b[1], tangentA * a[2] + tangentB * b[2] };
+
+            // the sines and cosines of latitude and longitude are taken from the unit vector itself
+            double cosLatitude = std::sqrt(p[0] * p[0] + p[1] * p[1]);
+            double sinLatitude = p[2];
+            double cosLongitude = cosLatitude > 0 ? p[0] / cosLatitude : 1;
+            double sinLongitude = cosLatitude > 0 ? p[1] / cosLatitude : 0;
+
+            // components of the tangent towards north and east
+            double north = -sinLatitude * (cosLongitude * t[0] + sinLongitude * t[1]) + cosLatitude * t[2];
+            double east = -sinLongitude * t[0] + cosLongitude * t[1];
+
+            positions.push_back(WorldPositionStruct{ std::atan2(sinLatitude, cosLatitude) / DEGREES_TO_RADIANS, std::atan2(p[1], p[0]) / DEGREES_TO_RADIANS,
+                from.altitude + fraction * (to.altitude - from.altitude), normalizeHeading(std::atan2(east, north) / DEGREES_TO_RADIANS), 0, pitch });
+        }
+
+        distance -= length;
+    }
+}
+
+void PathGenerator::generateCatmullRom(std::span<const PathWaypoint> waypoints, double spacing, size_t maxCount)
+{
+    // local plane around the first waypoint, x east and y north
+    const PathWaypoint& origin = waypoints[0];
+    double metersPerLatitude = EARTH_MEAN_RADIUS * DEGREES_TO_RADIANS;
+    double metersPerLongitude = metersPerLatitude * std::max(std::cos(origin.latitude * DEGREES_TO_RADIANS), 1e-6);
+
+    controlPoints.resize(waypoints.size() + 2);
+    for (size_t i = 0; i < waypoints.size(); i++)
+    {
+        controlPoints[i + 1] = LocalPoint{ getLongitudeDifference(origin.longitude, waypoints[i].longitude) * metersPerLongitude,
+            (waypoints[i].latitude - origin.latitude) * metersPerLatitude, waypoints[i].altitude * METERS_PER_FOOT };
+    }
+
+    // the end points are mirrored, so the curve starts and ends in the direction of the first and last segment
+    const LocalPoint& first = controlPoints[1];
+    const LocalPoint& second = controlPoints[2];
+    const LocalPoint& last = controlPoints[waypoints.size()];
+    const LocalPoint& secondLast = controlPoints[waypoints.size() - 1];
+    controlPoints.front() = LocalPoint{ 2 * first.x - second.x, 2 * first.y - second.y, 2 * first.z - second.z };
+    controlPoints.back() = LocalPoint{ 2 * last.x - secondLast.x, 2 * last.y - secondLast.y, 2 * last.z - secondLast.z };
+
+    double distance = 0;
+
+    for (size_t i = 1; i + 2 < controlPoints.size(); i++)
+    {
+        const LocalPoint& p0 = controlPoints[i - 1];
+        const LocalPoint& p1 = controlPoints[i];
+        const LocalPoint& p2 = controlPoints[i + 1];
+        const LocalPoint& p3 = controlPoints[i + 2];
+
+        // q(t) = c0 + c1 t + c2 t^2 + c3 t^3
+        LocalPoint c1{ 0.5 * (p2.x - p0.x), 0.5 * (p2.y - p0.y), 0.5 * (p2.z - p0.z) };
+        LocalPoint c2{ 0.5 * (2 * p0.x - 5 * p1.x + 4 * p2.x - p3.x), 0.5 * (2 * p0.y - 5 * p1.y + 4 * p2.y - p3.y), 0.5 * (2 * p0.z - 5 * p1.z + 4 * p2.z - p3.z) };
+        LocalPoint c3{ 0.5 * (-p0.x + 3 * p1.x - 3 * p2.x + p3.x), 0.5 * (-p0.y + 3 * p1.y - 3 * p2.y + p3.y), 0.5 * (-p0.z + 3 * p1.z - 3 * p2.z + p3.z) };
+        auto point = [&](double t) {
+            return LocalPoint{ p1.x + t * (c1.x + t * (c2.x + t * c3.x)), p1.y + t * (c1.y + t * (c2.y + t * c3.y)), p1.z + t * (c1.z + t * (c2.z + t * c3.z)) };
+        };
+        auto tangent = [&](double t) {
+            return LocalPoint{ c1.x + t * (2 * c2.x + 3 * t * c3.x), c1.y + t * (2 * c2.y + 3 * t * c3.y), c1.z + t * (2 * c2.z + 3 * t * c3.z) };
+        };
+
+        // arc length table along the ground track
+        double chord = std::hypot(p2.x - p1.x, p2.y - p1.y);
+        size_t samples = static_cast<size_t>(std::clamp(std::ceil(chord / spacing) * PATH_SAMPLES_PER_INDICATOR,
+            static_cast<double>(PATH_MIN_SEGMENT_SAMPLES), static_cast<double>(PATH_MAX_SEGMENT_SAMPLES)));
+        segmentLengths.resize(samples + 1);
+        segmentLengths[0] = 0;
+        LocalPoint previous = p1;
+        for (size_t j = 1; j <= samples; j++)
+        {
+            LocalPoint current = point(static_cast<double>(j) / samples);
+            segmentLengths[j] = segmentLengths[j - 1] + std::hypot(current.x - previous.x, current.y - previous.y);
+            previous = current;
+        }
+
+        double length = segmentLengths[samples];
+        if (length <= 0)
+        {
+            continue;
+        }
+
+        size_t sample = 0;
+        for (; distance <= length; distance += spacing)
+        {
+            if (positions.size() == maxCount)
+            {
+                isTruncated = true;
+                return;
+            }
+
+            while (sample + 1 < samples && segmentLengths[sample + 1] < distance)
+            {
+                sample++;
+            }
+            double sampleLength = segmentLengths[sample + 1] - segmentLengths[sample];
+            double t = (sample + (sampleLength > 0 ? std::min((distance - segmentLengths[sample]) / sampleLength, 1.0) : 0)) / samples;
+
+            LocalPoint position = point(t);
+            LocalPoint direction = tangent(t);
+            double latitude = std::clamp(origin.latitude + position.y / metersPerLatitude, -90.0, 90.0);
+            double longitude = normalizeLongitude(origin.longitude + position.x / metersPerLongitude);
+            double heading = normalizeHeading(std::atan2(direction.x, direction.y) / DEGREES_TO_RADIANS);
+            double pitch = -std::atan2(direction.z, std::hypot(direction.x, direction.y)) / DEGREES_TO_RADIANS;
+
+            positions.push_back(WorldPositionStruct{ latitude, longitude, position.z / METERS_PER_FOOT, heading, 0, pitch });
+        }
+
+        distance -= length;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "worldPosition.h"
+
+#include <vector>
+#include <span>
+
+/// Minimum number of samples of the arc length table of a Catmull-Rom segment
+#define PATH_MIN_SEGMENT_SAMPLES 16
+
+/// Maximum number of samples of the arc length table of a Catmull-Rom segment
+#define PATH_MAX_SEGMENT_SAMPLES 4096
+
+/// Number of samples of the arc length table per indicator on a Catmull-Rom segment
+#define PATH_SAMPLES_PER_INDICATOR 4
+
+/// <summary>
+/// Curve through the waypoints of a path.
+/// </summary>
+enum PathInterpolation : ushort {
+    PATH_INTERPOLATION_GREAT_CIRCLE = 0, // great-circle segments between the waypoints, the altitude changes linearly
+    PATH_INTERPOLATION_CATMULL_ROM = 1,  // Catmull-Rom spline through the waypoints
+};
+
+/// <summary>
+/// Waypoint of a path.
+/// </summary>
+struct PathWaypoint {
+    /// <summary>
+    /// Geographic latitude in degrees
+    /// </summary>
+    double latitude;
+
+    /// <summary>
+    /// Geographic longitude in degrees
+    /// </summary>
+    double longitude;
+
+    /// <summary>
+    /// Altitude above MSL (Mean Sea Level) in feet
+    /// </summary>
+    double altitude;
+};
+
+/// <summary>
+/// Returns a short, stable name of the interpolation (e.g. "catmull-rom").
+/// </summary>
+/// <param name="interpolation">The interpolation</param>
+/// <returns>Name of the interpolation</returns>
+const char* getPathInterpolationName(PathInterpolation interpolation);
+
+/// <summary>
+/// Generates the indicator positions along a path through waypoints.
+///
+/// The indicators are placed at equal distances along the ground track, starting at the first waypoint. Each indicator faces
+/// along the tangent of the curve: the heading is the direction of the ground track, the pitch the climb angle (negative when
+/// climbing, like the pitch of SimConnect). The Catmull-Rom spline is calculated in a local plane around the first waypoint and
+/// its arc length is approximated by a sampled table per segment. The buffers are reused, so repeated paths do not allocate.
+/// </summary>
+class PathGenerator
+{
+public:
+    /// <summary>
+    /// Generates the positions along the path.
+    /// </summary>
+    /// <param name="waypoints">Waypoints of the path, at least two</param>
+    /// <param name="spacing">Distance between two indicators in m</param>
+    /// <param name="interpolation">Curve through the waypoints</param>
+    /// <param name="maxCount">Maximum number of positions, the rest of the path is dropped</param>
+    /// <returns>The positions, valid until the next call</returns>
+    std::span<const WorldPositionStruct> generate(std::span<const PathWaypoint> waypoints, double spacing, PathInterpolation interpolation, size_t maxCount);
+
+    /// <summary>
+    /// Returns true if the last generated path was longer than the maximum number of positions.
+    /// </summary>
+    /// <returns>True if positions were dropped</returns>
+    bool wasTruncated() const;
+
+private:
+    /// <summary>
+    /// Point of the Catmull-Rom spline in the local plane (x east, y north, z up, all in m).
+    /// </summary>
+    struct LocalPoint {
+        double x;
+        double y;
+        double z;
+    };
+
+    /// <summary>
+    /// Generated positions.
+    /// </summary>
+    std::vector<WorldPositionStruct> positions;
+
+    /// <summary>
+    /// Waypoints in the local plane including the mirrored control points before the first and after the last waypoint.
+    /// </summary>
+    std::vector<LocalPoint> controlPoints;
+
+    /// <summary>
+    /// Arc length table of the current Catmull-Rom segment: ground distance from the segment start at equidistant parameters.
+    /// </summary>
+    std::vector<double> segmentLengths;
+
+    /// <summary>
+    /// See wasTruncated.
+    /// </summary>
+    bool isTruncated = false;
+
+    /// <summary>
+    /// Places the positions along great-circle segments.
+    /// </summary>
+    void generateGreatCircle(std::span<const PathWaypoint> waypoints, double spacing, size_t maxCount);
+
+    /// <summary>
+    /// Places the positions along a Catmull-Rom spline.
+    /// </summary>
+    void generateCatmullRom(std::span<const PathWaypoint> waypoints, double spacing, size_t maxCount);
+};
\ No newline at end of file
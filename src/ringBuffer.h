@@ -0,0 +1,417 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+/// Minimum number of slots. With a single slot the sequence number of a published element (pos + 1) would equal the one
+/// of a free slot for the next position, so the producer would overwrite unread elements.
+#define RING_BUFFER_MIN_CAPACITY 2
+
+/// <summary>
+/// Behaviour of a ring buffer if an element is pushed while the buffer is full.
+/// </summary>
+enum OverflowPolicy {
+    /// The oldest element is discarded to make room for the new one.
+    DROP_OLDEST,
+    /// The new element is discarded.
+    DROP_NEWEST,
+    /// The producer waits until the consumer has made room.
+    BLOCK,
+};
+
+/// <summary>
+/// Snapshot of the counters of a ring buffer.
+/// </summary>
+struct RingBufferStatistics {
+    /// <summary>
+    /// Number of elements which were accepted by push.
+    /// </summary>
+    unsigned long long enqueued;
+
+    /// <summary>
+    /// Number of elements which were discarded due to the overflow policy.
+    /// </summary>
+    unsigned long long dropped;
+
+    /// <summary>
+    /// Highest number of elements which were waiting in the buffer at the same time.
+    /// </summary>
+    size_t highWaterMark;
+
+    /// <summary>
+    /// Number of elements currently waiting in the buffer.
+    /// </summary>
+    size_t size;
+
+    /// <summary>
+    /// Maximum number of elements the buffer can hold.
+    /// </summary>
+    size_t capacity;
+};
+
+/// <summary>
+/// Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+///
+/// Every slot carries a sequence number (see D. Vyukov's bounded queue), so the producer is able to discard the
+/// oldest element with the same protocol the consumer uses to take it. The mutex and condition variables are only
+/// used to put a waiting thread to sleep, push and pop never lock.
+/// </summary>
+/// <typeparam name="T">Element type, has to be default constructible and move assignable</typeparam>
+template <typename T>
+class RingBuffer {
+public:
+    /// <summary>
+    /// Creates a ring buffer and preallocates all slots.
+    /// </summary>
+    /// <param name="capacity">Maximum number of elements, smaller values are raised to RING_BUFFER_MIN_CAPACITY</param>
+    /// <param name="overflowPolicy">Behaviour if the buffer is full</param>
+    RingBuffer(size_t capacity, OverflowPolicy overflowPolicy)
+        : capacity(capacity < RING_BUFFER_MIN_CAPACITY ? RING_BUFFER_MIN_CAPACITY : capacity), overflowPolicy(overflowPolicy),
+          slots(new Slot[this->capacity])
+    {
+        for (size_t i = 0; i < this->capacity; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// <summary>
+    /// Appends an element. Must only be called by the producer thread.
+    /// </summary>
+    /// <param name="item">The element to append</param>
+    /// <returns>false if the element was discarded (full buffer with DROP_NEWEST or closed buffer)</returns>
+    bool push(T&& item)
+    {
+        return emplace([&item](T& slot) { slot = std::move(item); return true; });
+    }
+
+    /// <summary>
+    /// Appends an element which is written directly into the next free slot, so large elements are not copied.
+    /// Must only be called by the producer thread.
+    ///
+    /// The free slot is made available (according to the overflow policy) before the writer is called, so with
+    /// DROP_OLDEST the oldest element is also discarded if the writer rejects the new element afterwards.
+    /// </summary>
+    /// <param name="writer">Callable bool(T&amp;) which fills the slot, returns false to discard the element</param>
+    /// <returns>false if the element was discarded by the overflow policy, the writer or a closed buffer</returns>
+    template <typename Writer>
+    bool emplace(Writer&& writer)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+
+        while (!closed.load(std::memory_order_acquire) && !isSlotFree(pos))
+        {
+
+            if (overflowPolicy == DROP_NEWEST)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else if (overflowPolicy == DROP_OLDEST)
+            {
+                // only the element stored in the slot of pos is dropped, if the consumer has already claimed it
+                // dropping further elements would not free the slot, so the producer waits for its release
+                size_t oldest = pos - capacity;
+                if (head.compare_exchange_strong(oldest, oldest + 1, std::memory_order_seq_cst))
+                {
+                    release(oldest);
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    waitForFreeSlot(pos);
+                }
+            }
+            else
+            {
+                waitForFreeSlot(pos);
+            }
+        }
+
+        if (closed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        Slot& slot = slots[pos % capacity];
+        if (!writer(slot.value))
+        {
+            // the slot has not been published, so it is simply reused by the next element
+            return false;
+        }
+
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        tail.store(pos + 1, std::memory_order_seq_cst);
+
+        enqueued.fetch_add(1, std::memory_order_relaxed);
+
+        size_t currentSize = pos + 1 - head.load(std::memory_order_relaxed);
+        if (currentSize > highWaterMark.load(std::memory_order_relaxed))
+        {
+            highWaterMark.store(currentSize, std::memory_order_relaxed);
+        }
+
+        if (consumerWaiting.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lk(waitMutex);
+            notEmpty.notify_one();
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Takes the oldest element if there is one. Must only be called by the consumer thread.
+    /// </summary>
+    /// <param name="item">Receives the element</param>
+    /// <returns>true if an element was taken</returns>
+    bool pop(T& item)
+    {
+        return consume([&item](T& slot) { item = std::move(slot); });
+    }
+
+    /// <summary>
+    /// Hands the oldest element to the reader while it is still stored in its slot, so large elements are not copied.
+    /// The slot is released after the reader returns, a producer which needs this slot waits for it meanwhile.
+    /// Must only be called by the consumer thread.
+    /// </summary>
+    /// <param name="reader">Callable void(T&amp;) which processes the element</param>
+    /// <returns>true if an element was processed</returns>
+    template <typename Reader>
+    bool consume(Reader&& reader)
+    {
+        size_t pos;
+        if (!tryClaim(pos))
+        {
+            return false;
+        }
+
+        reader(slots[pos % capacity].value);
+        release(pos);
+
+        if (producerWaiting.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lk(waitMutex);
+            notFull.notify_one();
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Waits until there is at least one element, the timeout is exceeded or the buffer is closed.
+    /// Must only be called by the consumer thread.
+    /// </summary>
+    /// <param name="timeout">Maximum waiting time</param>
+    /// <returns>true if there is an element to pop</returns>
+    bool waitForData(std::chrono::milliseconds timeout)
+    {
+        if (!isEmpty())
+        {
+            return true;
+        }
+
+        consumerWaiting.store(true, std::memory_order_seq_cst);
+        if (isEmpty() && !closed.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lk(waitMutex);
+            notEmpty.wait_for(lk, timeout, [this] { return !isEmpty() || closed.load(std::memory_order_acquire); });
+        }
+        consumerWaiting.store(false, std::memory_order_relaxed);
+
+        return !isEmpty();
+    }
+
+    /// <summary>
+    /// Closes the buffer. Waiting threads return and further elements are rejected.
+    /// </summary>
+    void close()
+    {
+        closed.store(true, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lk(waitMutex);
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    /// <summary>
+    /// Returns true if close was called.
+    /// </summary>
+    /// <returns>Closed state of the buffer</returns>
+    bool isClosed() const
+    {
+        return closed.load(std::memory_order_acquire);
+    }
+
+    /// <summary>
+    /// Returns a snapshot of the counters. Can be called from any thread.
+    /// </summary>
+    /// <returns>Current counters</returns>
+    RingBufferStatistics getStatistics() const
+    {
+        RingBufferStatistics statistics{};
+        statistics.enqueued = enqueued.load(std::memory_order_relaxed);
+        statistics.dropped = dropped.load(std::memory_order_relaxed);
+        statistics.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+        statistics.capacity = capacity;
+
+        size_t curTail = tail.load(std::memory_order_acquire);
+        size_t curHead = head.load(std::memory_order_acquire);
+        statistics.size = curTail > curHead ? curTail - curHead : 0;
+
+        return statistics;
+    }
+
+private:
+    /// <summary>
+    /// A single element of the buffer with its sequence number.
+    /// </summary>
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    /// <summary>
+    /// Maximum number of elements.
+    /// </summary>
+    const size_t capacity;
+
+    /// <summary>
+    /// Behaviour if the buffer is full.
+    /// </summary>
+    const OverflowPolicy overflowPolicy;
+
+    /// <summary>
+    /// Preallocated slots.
+    /// </summary>
+    std::unique_ptr<Slot[]> slots;
+
+    /// <summary>
+    /// Position of the next element to take. Advanced by the consumer and by the producer when it drops the oldest element.
+    /// </summary>
+    alignas(64) std::atomic<size_t> head{ 0 };
+
+    /// <summary>
+    /// Position of the next element to write. Only advanced by the producer.
+    /// </summary>
+    alignas(64) std::atomic<size_t> tail{ 0 };
+
+    /// <summary>
+    /// Counters (only written by the producer).
+    /// </summary>
+    alignas(64) std::atomic<unsigned long long> enqueued{ 0 };
+    std::atomic<unsigned long long> dropped{ 0 };
+    std::atomic<size_t> highWaterMark{ 0 };
+
+    /// <summary>
+    /// Flags and primitives to put waiting threads to sleep.
+    /// </summary>
+    std::atomic_bool closed{ false };
+    std::atomic_bool consumerWaiting{ false };
+    std::atomic_bool producerWaiting{ false };
+    std::mutex waitMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+
+    /// <summary>
+    /// Returns true if no element is waiting.
+    /// </summary>
+    bool isEmpty() const
+    {
+        return head.load(std::memory_order_seq_cst) == tail.load(std::memory_order_seq_cst);
+    }
+
+    /// <summary>
+    /// Returns true if the slot for the given write position has been released by its previous reader.
+    /// </summary>
+    bool isSlotFree(size_t pos) const
+    {
+        return slots[pos % capacity].sequence.load(std::memory_order_seq_cst) == pos;
+    }
+
+    /// <summary>
+    /// Claims the oldest element by advancing the head. The claimed slot stays occupied until release is called.
+    /// </summary>
+    bool tryClaim(size_t& pos)
+    {
+        pos = head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            size_t seq = slots[pos % capacity].sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (dif == 0)
+            {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            else if (dif < 0)
+            {
+                // empty
+                return false;
+            }
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Resets the claimed slot and hands it back to the producer.
+    /// </summary>
+    void release(size_t pos)
+    {
+        Slot& slot = slots[pos % capacity];
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            // release owned resources, plain data is simply overwritten by the next element
+            slot.value = T();
+        }
+        slot.sequence.store(pos + capacity, std::memory_order_seq_cst);
+    }
+
+    /// <summary>
+    /// Puts the producer to sleep until the slot for the given position is released or the buffer is closed.
+    /// </summary>
+    void waitForFreeSlot(size_t pos)
+    {
+        producerWaiting.store(true, std::memory_order_seq_cst);
+        if (!isSlotFree(pos) && !closed.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lk(waitMutex);
+            notFull.wait_for(lk, std::chrono::milliseconds(10), [this, pos] { return isSlotFree(pos) || closed.load(std::memory_order_acquire); });
+        }
+        producerWaiting.store(false, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,169 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "worldPosition.h"
+#include "aircraftState.h"
+#include "telemetry.h"
+
+#include <chrono>
+
+/// <summary>
+/// Type of an event which is reported by the simulation.
+/// </summary>
+enum SimEventType {
+    SIM_EVENT_STARTED,         // simulation started
+    SIM_EVENT_STOPPED,         // simulation stopped
+    SIM_EVENT_RUNNING_STATE,   // answer to the initial query of the simulation state
+    SIM_EVENT_PAUSE,           // simulation paused or resumed
+    SIM_EVENT_OBJECT_ASSIGNED, // SimObject created for a request
+    SIM_EVENT_AIRCRAFT_STATE,  // new state of the user aircraft
+    SIM_EVENT_EXCEPTION,       // a request failed
+    SIM_EVENT_QUIT,            // the simulation closed the connection
+};
+
+/// <summary>
+/// Event which is reported by the simulation. Only the fields belonging to the type are set.
+/// </summary>
+struct SimEvent {
+    /// <summary>
+    /// Type of the event
+    /// </summary>
+    SimEventType type;
+
+    /// <summary>
+    /// Request id of the create request (SIM_EVENT_OBJECT_ASSIGNED)
+    /// </summary>
+    uint requestID;
+
+    /// <summary>
+    /// Id of the created SimObject (SIM_EVENT_OBJECT_ASSIGNED)
+    /// </summary>
+    uint objectID;
+
+    /// <summary>
+    /// True if the simulation is running (SIM_EVENT_RUNNING_STATE)
+    /// </summary>
+    bool isRunning;
+
+    /// <summary>
+    /// True if the simulation is paused (SIM_EVENT_PAUSE)
+    /// </summary>
+    bool isPaused;
+
+    /// <summary>
+    /// Exception code of the simulation (SIM_EVENT_EXCEPTION)
+    /// </summary>
+    uint exception;
+
+    /// <summary>
+    /// State of the user aircraft (SIM_EVENT_AIRCRAFT_STATE)
+    /// </summary>
+    AircraftStateStruct aircraftState;
+
+    /// <summary>
+    /// Time at which the backend knew that the event is available, used to measure the dispatch latency
+    /// </summary>
+    std::chrono::steady_clock::time_point readyTime;
+};
+
+/// <summary>
+/// Connection to a simulation which is able to place SimObjects. SimConnectProxy only uses this interface, so the
+/// indicator logic can run against SimConnect as well as against a simulated backend.
+/// All methods except getNextEvent may be called from another thread than getNextEvent.
+/// </summary>
+class SimBackend {
+public:
+    /// <summary>
+    /// Virtual destructor
+    /// </summary>
+    virtual ~SimBackend() = default;
+
+    /// <summary>
+    /// Returns the name of the backend for log messages.
+    /// </summary>
+    /// <returns>Name of the backend</returns>
+    virtual const char* getName() const = 0;
+
+    /// <summary>
+    /// Tries once to open the connection and subscribes to the events of the simulation.
+    /// </summary>
+    /// <returns>True if the connection is established</returns>
+    virtual bool open() = 0;
+
+    /// <summary>
+    /// Closes the connection.
+    /// </summary>
+    virtual void close() = 0;
+
+    /// <summary>
+    /// Requests the creation of a SimObject. Its id is reported by a SIM_EVENT_OBJECT_ASSIGNED event with the same request id.
+    /// </summary>
+    /// <param name="modelName">Name of the model of the SimObject</param>
+    /// <param name="position">Position and orientation of the SimObject</param>
+    /// <param name="requestID">Request id which identifies the SimObject in the assignment event</param>
+    /// <returns>False if the request could not be sent</returns>
+    virtual bool createObject(const char* modelName, const WorldPositionStruct& position, uint requestID) = 0;
+
+    /// <summary>
+    /// Requests the removal of a SimObject.
+    /// </summary>
+    /// <param name="objectID">Id of the SimObject</param>
+    /// <param name="requestID">Request id of the removal</param>
+    /// <returns>False if the request could not be sent</returns>
+    virtual bool removeObject(uint objectID, uint requestID) = 0;
+
+    /// <summary>
+    /// Moves an existing SimObject to a new position and orientation.
+    /// </summary>
+    /// <param name="objectID">Id of the SimObject</param>
+    /// <param name="position">New position and orientation of the SimObject</param>
+    /// <returns>False if the request could not be sent</returns>
+    virtual bool moveObject(uint objectID, const WorldPositionStruct& position) = 0;
+
+    /// <summary>
+    /// Requests the state of the user aircraft in the given period, replacing the previous request. The states are reported by
+    /// SIM_EVENT_AIRCRAFT_STATE events.
+    /// </summary>
+    /// <param name="period">Period of the updates</param>
+    /// <param name="periodCount">Number of periods between two updates, 1 for every period</param>
+    /// <param name="onlyChanged">True if a state is only reported if it differs from the previous one</param>
+    /// <returns>False if the request could not be sent</returns>
+    virtual bool requestAircraftState(TelemetryPeriod period, uint periodCount, bool onlyChanged) = 0;
+
+    /// <summary>
+    /// Blocks until an event may be available, wakeUp is called or the timeout expires.
+    /// </summary>
+    /// <param name="timeout">Maximum time to wait in ms</param>
+    /// <returns>False if the timeout expired</returns>
+    virtual bool waitForEvents(uint timeout) = 0;
+
+    /// <summary>
+    /// Wakes up a thread which is blocked in waitForEvents, e.g. to stop it.
+    /// </summary>
+    virtual void wakeUp() = 0;
+
+    /// <summary>
+    /// Takes the next event reported by the simulation without waiting.
+    /// </summary>
+    /// <param name="event">Receives the event</param>
+    /// <returns>False if no event is available</returns>
+    virtual bool getNextEvent(SimEvent& event) = 0;
+};
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef _WIN32 // SimConnect is only available on Windows, see fakeSimBackend.cpp for a simulated backend
+
+#include "simConnectBackend.h"
+#include "log.h"
+
+#include <cstring>
+
+SimConnectBackend::SimConnectBackend()
+{
+    // auto reset events, the receiving thread drains all messages after each signal
+    hDispatchEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    hWakeUpEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+SimConnectBackend::~SimConnectBackend()
+{
+    CloseHandle(hDispatchEvent);
+    CloseHandle(hWakeUpEvent);
+}
+
+const char* SimConnectBackend::getName() const
+{
+    return "SimConnect";
+}
+
+bool SimConnectBackend::open()
+{
+    // as of dec 2025 there is a bug in SimConnect >= 1.4.5 (https://devsupport.flightsimulator.com/t/memory-leak-in-simconnect-open-function-sdk-1-4-5/17043)
+    // so this only works with SimConnect SDK 1.2.4
+    if (FAILED(SimConnect_Open(&this->hSimConnect, "Visual Flight Path", NULL, 0, hDispatchEvent, SIMCONNECT_OPEN_CONFIGINDEX_LOCAL)))
+    {
+        return false;
+    }
+
+    subscribeToEvents();
+    return true;
+}
+
+void SimConnectBackend::close()
+{
+    SimConnect_Close(this->hSimConnect);
+}
+
+void SimConnectBackend::subscribeToEvents()
+{
+    if (FAILED(SimConnect_SubscribeToSystemEvent(hSimConnect, SIM_START, "SimStart")))
+    {
+        Logger::logError("Failed to register for SIM_START");
+    }
+    if (FAILED(SimConnect_SubscribeToSystemEvent(hSimConnect, SIM_STOP, "SimStop")))
+    {
+        Logger::logError("Failed to register for SIM_STOP");
+    }
+    if (FAILED(SimConnect_SubscribeToSystemEvent(hSimConnect, SIM_PAUSE, "Pause")))
+    {
+        Logger::logError("Failed to register for SIM_PAUSE");
+    }
+
+    // the simulation might be already running, so we have to poll once for the current state
+    SimConnect_RequestSystemState(hSimConnect, SIM_STATE, "Sim");
+
+    // Aircraft State
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE LATITUDE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE LONGITUDE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE ALTITUDE", "feet");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE HEADING DEGREES TRUE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE BANK DEGREES", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE PITCH DEGREES", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "GROUND VELOCITY", "knots");
+
+    // Indicator position, same layout as WorldPositionStruct
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE LATITUDE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE LONGITUDE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE ALTITUDE", "feet");
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE HEADING DEGREES TRUE", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE BANK DEGREES", "degrees");
+    SimConnect_AddToDataDefinition(hSimConnect, INDICATOR_POSITION_DEFINITION, "PLANE PITCH DEGREES", "degrees");
+}
+
+bool SimConnectBackend::requestAircraftState(TelemetryPeriod period, uint periodCount, bool onlyChanged)
+{
+    SIMCONNECT_PERIOD simConnectPeriod = SIMCONNECT_PERIOD_SECOND;
+    switch (period)
+    {
+    case TELEMETRY_PERIOD_SECOND: simConnectPeriod = SIMCONNECT_PERIOD_SECOND; break;
+    case TELEMETRY_PERIOD_SIM_FRAME: simConnectPeriod = SIMCONNECT_PERIOD_SIM_FRAME; break;
+    case TELEMETRY_PERIOD_VISUAL_FRAME: simConnectPeriod = SIMCONNECT_PERIOD_VISUAL_FRAME; break;
+    }
+
+    // the interval is the number of periods which are skipped between two updates
+    return SUCCEEDED(SimConnect_RequestDataOnSimObject(hSimConnect, AIRCRAFT_STATE, AIRCRAFT_STATE_DEFINITION, SIMCONNECT_OBJECT_ID_USER,
+        simConnectPeriod, onlyChanged ? SIMCONNECT_DATA_REQUEST_FLAG_CHANGED : 0, 0, periodCount - 1, 0));
+}
+
+bool SimConnectBackend::createObject(const char* modelName, const WorldPositionStruct& position, uint requestID)
+{
+    SIMCONNECT_DATA_INITPOSITION pos;
+    pos.Latitude = position.latitude;
+    pos.Longitude = position.longitude;
+    pos.Altitude = position.altitude;
+    pos.Heading = position.heading;
+    pos.Bank = position.bank;
+    pos.Pitch = position.pitch;
+    pos.Airspeed = 0;
+    pos.OnGround = 0;
+
+    return SUCCEEDED(SimConnect_AICreateSimulatedObject_EX1(hSimConnect, modelName, nullptr, pos, requestID));
+}
+
+bool SimConnectBackend::removeObject(uint objectID, uint requestID)
+{
+    return SUCCEEDED(SimConnect_AIRemoveObject(hSimConnect, objectID, requestID));
+}
+
+bool SimConnectBackend::moveObject(uint objectID, const WorldPositionStruct& position)
+{
+    return SUCCEEDED(SimConnect_SetDataOnSimObject(hSimConnect, INDICATOR_POSITION_DEFINITION, objectID, 0, 0, sizeof(WorldPositionStruct),
+        const_cast<WorldPositionStruct*>(&position)));
+}
+
+bool SimConnectBackend::waitForEvents(uint timeout)
+{
+    HANDLE handles[2] = { hDispatchEvent, hWakeUpEvent };
+    DWORD res = WaitForMultipleObjects(2, handles, FALSE, timeout);
+
+    lastWakeUp = std::chrono::steady_clock::now();
+    return res == WAIT_OBJECT_0 || res == WAIT_OBJECT_0 + 1;
+}
+
+void SimConnectBackend::wakeUp()
+{
+    SetEvent(hWakeUpEvent);
+}
+
+bool SimConnectBackend::getNextEvent(SimEvent& event)
+{
+    SIMCONNECT_RECV* pData;
+    DWORD cbData;
+
+    // messages which are not relevant are skipped
+    while (SUCCEEDED(SimConnect_GetNextDispatch(hSimConnect, &pData, &cbData)))
+    {
+        if (convertMessage(pData, event))
+        {
+            event.readyTime = lastWakeUp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SimConnectBackend::convertMessage(SIMCONNECT_RECV* pData, SimEvent& event)
+{
+    switch (pData->dwID)
+    {
+        // Simulation started and stopped events do not occur as expected
+        // According to https://docs.flightsimulator.com/msfs2024/html/6_Programming_APIs/SimConnect/API_Reference/Events_And_Data/SimConnect_SubscribeToSystemEvent.htm
+        // the system event SimStart should be send if the user is in control of an aircraft but it is also send when MSFS starts and is in main menu
+        // -> its currently seems impossible to determine the active running state of the simulation
+       case SIMCONNECT_RECV_ID_EVENT : // Simulation started or stopped
+       {
+           SIMCONNECT_RECV_EVENT* evt = reinterpret_cast<SIMCONNECT_RECV_EVENT*>(pData);
+           switch (evt->uEventID)
+           {
+                case SIM_START:
+                    event.type = SIM_EVENT_STARTED;
+                    return true;
+                case SIM_STOP:
+                    event.type = SIM_EVENT_STOPPED;
+                    return true;
+                case SIM_PAUSE:
+                    event.type = SIM_EVENT_PAUSE;
+                    event.isPaused = evt->dwData == 1;
+                    return true;
+           }
+           return false;
+       }
+       case SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID: // object created with given id
+       {
+           SIMCONNECT_RECV_ASSIGNED_OBJECT_ID* aoi = reinterpret_cast<SIMCONNECT_RECV_ASSIGNED_OBJECT_ID*>(pData);
+           event.type = SIM_EVENT_OBJECT_ASSIGNED;
+           event.requestID = aoi->dwRequestID;
+           event.objectID = aoi->dwObjectID;
+           return true;
+       }
+       case SIMCONNECT_RECV_ID_SYSTEM_STATE: // current state of the simulation
+       {
+           SIMCONNECT_RECV_SYSTEM_STATE* st = reinterpret_cast<SIMCONNECT_RECV_SYSTEM_STATE*>(pData);
+           if (st->dwRequestID != SIM_STATE)
+           {
+               return false;
+           }
+           event.type = SIM_EVENT_RUNNING_STATE;
+           event.isRunning = st->dwInteger == 1;
+           return true;
+       }
+       case SIMCONNECT_RECV_ID_SIMOBJECT_DATA: // polled aircraft information
+       {
+           SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = (SIMCONNECT_RECV_SIMOBJECT_DATA*)pData;
+           if (pObjData->dwRequestID != AIRCRAFT_STATE)
+           {
+               return false;
+           }
+           event.type = SIM_EVENT_AIRCRAFT_STATE;
+           std::memcpy(&event.aircraftState, &pObjData->dwData, sizeof(event.aircraftState));
+           return true;
+       }
+       case SIMCONNECT_RECV_ID_EXCEPTION:
+       {
+           SIMCONNECT_RECV_EXCEPTION* ex = reinterpret_cast<SIMCONNECT_RECV_EXCEPTION*>(pData);
+           event.type = SIM_EVENT_EXCEPTION;
+           event.exception = ex->dwException;
+           return true;
+       }
+       case SIMCONNECT_RECV_ID_QUIT:
+       {
+           event.type = SIM_EVENT_QUIT;
+           return true;
+       }
+    }
+
+    return false;
+}
+
+#endif
\ No newline at end of file
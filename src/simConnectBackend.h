@@ -0,0 +1,115 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#ifdef _WIN32 // SimConnect is only available on Windows
+
+#include "datatypes.h"
+#include "simBackend.h"
+
+#include "windows.h"
+#include "SimConnect.h"
+
+/// <summary>
+/// Backend which connects to Microsoft Flight Simulator by the SimConnect-API.
+/// </summary>
+class SimConnectBackend : public SimBackend {
+public:
+    /// <summary>
+    /// Creates the events which are used to wait for messages.
+    /// </summary>
+    SimConnectBackend();
+
+    /// <summary>
+    /// Closes the events.
+    /// </summary>
+    ~SimConnectBackend() override;
+
+    const char* getName() const override;
+    bool open() override;
+    void close() override;
+    bool createObject(const char* modelName, const WorldPositionStruct& position, uint requestID) override;
+    bool removeObject(uint objectID, uint requestID) override;
+    bool moveObject(uint objectID, const WorldPositionStruct& position) override;
+    bool requestAircraftState(TelemetryPeriod period, uint periodCount, bool onlyChanged) override;
+    bool waitForEvents(uint timeout) override;
+    void wakeUp() override;
+    bool getNextEvent(SimEvent& event) override;
+
+private:
+    /// <summary>
+    /// Handle for the connection to SimConnect
+    /// </summary>
+    HANDLE hSimConnect = NULL;
+
+    /// <summary>
+    /// Event which SimConnect signals when a new message is available
+    /// </summary>
+    HANDLE hDispatchEvent = NULL;
+
+    /// <summary>
+    /// Event which is signaled by wakeUp
+    /// </summary>
+    HANDLE hWakeUpEvent = NULL;
+
+    /// <summary>
+    /// Time at which waitForEvents returned last, the messages are available at least since then
+    /// </summary>
+    std::chrono::steady_clock::time_point lastWakeUp;
+
+    /// <summary>
+    /// Subscribes to SimConnect system events and defines the aircraft information.
+    /// </summary>
+    void subscribeToEvents();
+
+    /// <summary>
+    /// Converts a SimConnect message into an event.
+    /// </summary>
+    /// <param name="pData">Pointer to the data buffer</param>
+    /// <param name="event">Receives the event</param>
+    /// <returns>False if the message is not relevant</returns>
+    bool convertMessage(SIMCONNECT_RECV* pData, SimEvent& event);
+};
+
+/// <summary>
+/// Well-known event ids which occur while communicating with the SimConnect-API.
+/// </summary>
+enum EventIDs : uint {
+    SIM_START = 1,
+    SIM_STOP = 2,
+    SIM_PAUSE = 3,
+};
+
+/// <summary>
+/// Well-known request ids which are used to poll status updates from the SimConnect-API.
+/// </summary>
+enum ReservedRequestIDs : uint {
+    SIM_STATE = 100,
+    AIRCRAFT_STATE = 200,
+};
+
+/// <summary>
+/// Well-known data definition ids to exchange data with die SimConnect-API.
+/// </summary>
+enum DATA_DEFINE_ID {
+    AIRCRAFT_STATE_DEFINITION,
+    INDICATOR_POSITION_DEFINITION,
+};
+
+#endif
\ No newline at end of file
@@ -18,185 +18,731 @@
  */
 #include "simConnectProxy.h"
 #include "log.h"
-#include "stringHelper.h"
+#include "geodesy.h"
 
-#include "SimConnect.h"
 #include <map>
+#include <algorithm>
 #include <vector>
 #include <sstream>
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <chrono>
 
 
-void SimConnectProxy::startSimConnectProxy(SimConnectCallback* callback)
+void SimConnectProxy::startSimConnectProxy(SimConnectCallback* callback, std::unique_ptr<SimBackend> backend)
 {
     this->callback = callback;
+    this->backend = std::move(backend);
 
+    indicatorTypeTableWatcher.start(INDICATOR_MAPPING_FILE, [this](std::shared_ptr<const IndicatorTypeTable> table) {
+        if (table != nullptr)
+        {
+            std::vector<IndicatorPoolSize> poolSizes = table->getPoolSizes();
+            indicatorPool.configure(poolSizes);
+        }
+        indicatorTypeTable.store(std::move(table));
+    });
+
+    isRunning = true;
     recvDataThread = std::thread(&SimConnectProxy::runSimConnectMessageLoop, this);
 }
 
-void SimConnectProxy::subscribeToEvents()
+void SimConnectProxy::handleCommand(const ParsedCommand& command)
 {
-    if (FAILED(SimConnect_SubscribeToSystemEvent(hSimConnect, SIM_START, "SimStart")))
+    if (!isSimulationActive())
+    {
+        Logger::logError("Command cannot be execute: Simulation is not running.");
+        return;
+    }
+
+    if (commandQueue.emplace([&command](ParsedCommand& queuedCommand) {
+        queuedCommand = command;
+        return true;
+    }))
+    {
+        backend->wakeUp();
+    }
+}
+
+void SimConnectProxy::executeCommand(const ParsedCommand& command)
+{
+    if (const SetIndicatorCommand* setCommand = std::get_if<SetIndicatorCommand>(&command))
+    {
+        std::shared_ptr<const IndicatorTypeTable> typeTable = getIndicatorTypeTable();
+        detachAnchors(setCommand->id, 1);
+        placeIndicator(*setCommand, typeTable.get());
+    }
+    else if (const SetIndicatorBatchCommand* batchCommand = std::get_if<SetIndicatorBatchCommand>(&command))
+    {
+        // the whole batch uses the same snapshot of the mapping
+        std::shared_ptr<const IndicatorTypeTable> typeTable = getIndicatorTypeTable();
+        for (ushort i = 0; i < batchCommand->count; i++)
+        {
+            detachAnchors(batchCommand->indicators[i].id, 1);
+            placeIndicator(batchCommand->indicators[i], typeTable.get());
+        }
+    }
+    else if (const PathCommand* pathCommand = std::get_if<PathCommand>(&command))
+    {
+        std::shared_ptr<const IndicatorTypeTable> typeTable = getIndicatorTypeTable();
+        placePath(*pathCommand, typeTable.get());
+    }
+    else if (const AnchorIndicatorCommand* anchorCommand = std::get_if<AnchorIndicatorCommand>(&command))
+    {
+        std::shared_ptr<const IndicatorTypeTable> typeTable = getIndicatorTypeTable();
+        anchorIndicator(*anchorCommand, typeTable.get());
+    }
+    else if (const RemoveIndicatorsCommand* removeCommand = std::get_if<RemoveIndicatorsCommand>(&command))
     {
-        Logger::logError("Failed to register for SIM_START");
+        if (removeCommand->count == 0)
+        {
+            // remove all
+            removePlacedIndicators();
+        }
+        else
+        {
+            removeIndicators(std::span<const ushort>(removeCommand->ids, removeCommand->count));
+        }
+    }
+    else {
+        Logger::logError("Unknown command.");
+    }
+}
+
+void SimConnectProxy::placeIndicator(const SetIndicatorCommand& setCommand, const IndicatorTypeTable* typeTable)
+{
+    const char* indicatorType = typeTable != nullptr ? typeTable->getName(setCommand.indicatorTypeID) : nullptr;
+
+    if (indicatorType == nullptr)
+    {
+        Logger::logError("Indicator type with id " + std::to_string(setCommand.indicatorTypeID) + " does not exist.");
+        return;
+    }
+    std::shared_ptr<const IndicatorLodGroup> lodGroup = typeTable->getLodGroup(setCommand.indicatorTypeID);
+
+    // the aircraft passes a ring of a level of detail group at its nearest model
+    double gateRadius = getGateRadius(indicatorType);
+
+    IndicatorPlacement& placement = indicatorPlacements[setCommand.id];
+
+    // the model of a level of detail group depends on the distance to the aircraft, the current level is kept within the hysteresis
+    uint lodLevel = 0;
+    if (lodGroup != nullptr && hasLodPosition)
+    {
+        double distance = getGreatCircleDistance(lodLatitude, lodLongitude, setCommand.position.latitude, setCommand.position.longitude);
+        lodLevel = placement.isPlaced && placement.lodGroup == lodGroup ? lodGroup->selectLevel(distance, placement.lodLevel) : lodGroup->selectLevel(distance);
+        indicatorType = lodGroup->levels[lodLevel].modelName.c_str();
+    }
+    setLodGroup(setCommand.id, std::move(lodGroup), lodLevel);
+    bool isResident = indicatorRegistry.getState(setCommand.id) != INDICATOR_SLOT_FREE;
+    bool isInRange = indicatorVirtualizer.isInRange(setCommand.position.latitude, setCommand.position.longitude);
+
+    if (placement.isPlaced && placement.modelName == indicatorType)
+    {
+        // a virtual indicator is materialized by the virtualization update
+        if (isSamePosition(placement.position, setCommand.position) && (isResident || indicatorVirtualizer.isEnabled()))
+        {
+            unchangedIndicators.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        placement.position = setCommand.position;
+        indicatorGrid.update(setCommand.id, setCommand.position.latitude, setCommand.position.longitude);
+        gateDetector.update(setCommand.id, setCommand.position, gateRadius);
+
+        if (!isResident)
+        {
+            if (isInRange)
+            {
+                materializeIndicator(setCommand.id);
+            }
+            return;
+        }
+
+        moveIndicator(setCommand.id);
+        return;
     }
-    if (FAILED(SimConnect_SubscribeToSystemEvent(hSimConnect, SIM_STOP, "SimStop")))
+
+    // new indicator or another model, the SimObject of the previous model is returned to its pool
+    if (isResident)
     {
-        Logger::logError("Failed to register for SIM_STOP");
+        retireIndicator(setCommand.id);
     }
 
-    // the simulation might be already running, so we have to poll once for the current state
-    SimConnect_RequestSystemState(hSimConnect, SIM_STATE, "Sim");
+    placement.isPlaced = true;
+    placement.modelName = indicatorType;
+    placement.position = setCommand.position;
+    placement.isMovePending = false;
+    indicatorGrid.update(setCommand.id, setCommand.position.latitude, setCommand.position.longitude);
+    gateDetector.update(setCommand.id, setCommand.position, gateRadius);
 
-    // Aircraft State
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE LATITUDE", "degrees");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE LONGITUDE", "degrees");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE ALTITUDE", "feet");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE HEADING DEGREES TRUE", "degrees");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE BANK DEGREES", "degrees");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "PLANE PITCH DEGREES", "degrees");
-    SimConnect_AddToDataDefinition(hSimConnect, AIRCRAFT_STATE_DEFINITION, "GROUND VELOCITY", "knots");
-    
-    SimConnect_RequestDataOnSimObject(hSimConnect, AIRCRAFT_STATE, AIRCRAFT_STATE_DEFINITION, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_SECOND);
+    if (isInRange)
+    {
+        materializeIndicator(setCommand.id);
+    }
 }
 
-void SimConnectProxy::handleCommand(AbstractCommandConfiguration* command)
+void SimConnectProxy::placePath(const PathCommand& pathCommand, const IndicatorTypeTable* typeTable)
 {
-    if (!isSimulationActive())
+    // checked once, so an unknown type is not reported for every indicator
+    if (typeTable == nullptr || typeTable->getName(pathCommand.indicatorTypeID) == nullptr)
     {
-        Logger::logError("Command cannot be execute: Simulation is not running.");
+        Logger::logError("Indicator type with id " + std::to_string(pathCommand.indicatorTypeID) + " does not exist.");
         return;
     }
 
-    if (command->getCommand() == Command::SET)
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::span<const WorldPositionStruct> positions = pathGenerator.generate(std::span<const PathWaypoint>(pathCommand.waypoints, pathCommand.count),
+        pathCommand.spacing, pathCommand.interpolation, INDICATOR_REGISTRY_SIZE - pathCommand.firstID);
+    long long duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (positions.empty())
+    {
+        Logger::logWarning("Path from ID " + std::to_string(pathCommand.firstID) + " has no length.");
+        return;
+    }
+    if (pathGenerator.wasTruncated())
     {
-        SetIndicatorCommandConfiguration* setCommand = static_cast<SetIndicatorCommandConfiguration*>(command);
+        Logger::logWarning("Path from ID " + std::to_string(pathCommand.firstID) + " is truncated at the last indicator ID.");
+    }
+    Logger::logInfo("Path: " + std::to_string(positions.size()) + " indicators (IDs " + std::to_string(pathCommand.firstID) + " - " +
+        std::to_string(pathCommand.firstID + positions.size() - 1) + ") generated in " + std::to_string(duration) + " us");
 
-        std::string indicatorType = getIndicatorTypeName(setCommand->getIndicatorTypeID());
+    detachAnchors(pathCommand.firstID, positions.size());
 
-        if (indicatorType.empty())
+    SetIndicatorCommand setCommand;
+    setCommand.indicatorTypeID = pathCommand.indicatorTypeID;
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        setCommand.id = static_cast<ushort>(pathCommand.firstID + i);
+        setCommand.position = positions[i];
+        placeIndicator(setCommand, typeTable);
+    }
+}
+
+void SimConnectProxy::anchorIndicator(const AnchorIndicatorCommand& anchorCommand, const IndicatorTypeTable* typeTable)
+{
+    // checked once, so an unknown type is not reported with every aircraft state
+    if (typeTable == nullptr || typeTable->getName(anchorCommand.indicatorTypeID) == nullptr)
+    {
+        Logger::logError("Indicator type with id " + std::to_string(anchorCommand.indicatorTypeID) + " does not exist.");
+        return;
+    }
+
+    AnchoredIndicator anchor{ anchorCommand.id, anchorCommand.indicatorTypeID, anchorCommand.frame, anchorCommand.offset };
+
+    for (AnchoredIndicator& existingAnchor : anchoredIndicators)
+    {
+        if (existingAnchor.id == anchor.id)
         {
-            Logger::logError("Indicator type with id " + std::to_string(setCommand->getIndicatorTypeID()) + " does not exist.");
+            existingAnchor = anchor;
             return;
         }
+    }
 
-        WorldPosition worldPosition = setCommand->getPosition();
+    anchoredIndicators.push_back(anchor);
+}
 
-        SIMCONNECT_DATA_INITPOSITION pos;
-        pos.Latitude = worldPosition.getLatitude();
-        pos.Longitude = worldPosition.getLongitude();
-        pos.Altitude = worldPosition.getAltitude();
-        pos.Heading = worldPosition.getHeading();
-        pos.Bank = worldPosition.getBank();
-        pos.Pitch = worldPosition.getPitch();
-        pos.Airspeed = 0;
-        pos.OnGround = 0;
+void SimConnectProxy::detachAnchors(ushort firstID, size_t count)
+{
+    std::erase_if(anchoredIndicators, [firstID, count](const AnchoredIndicator& anchor) { return anchor.id >= firstID && static_cast<size_t>(anchor.id - firstID) < count; });
+}
 
-        uint requestID = getNextRequestID();
-        setRequestToIndicator(requestID, setCommand->getID());
+void SimConnectProxy::detachAnchors(std::span<const ushort> ids)
+{
+    std::erase_if(anchoredIndicators, [ids](const AnchoredIndicator& anchor) { return std::find(ids.begin(), ids.end(), anchor.id) != ids.end(); });
+}
 
-        uint existingObjectID = getSimObjectByIndicator(setCommand->getID());
-        if (existingObjectID != 0)
+void SimConnectProxy::resolveAnchors(const AircraftStateStruct& aircraftState)
+{
+    if (anchoredIndicators.empty())
+    {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr<const IndicatorTypeTable> typeTable = getIndicatorTypeTable();
+
+    SetIndicatorCommand setCommand;
+    for (const AnchoredIndicator& anchor : anchoredIndicators)
+    {
+        setCommand.id = anchor.id;
+        setCommand.indicatorTypeID = anchor.indicatorTypeID;
+        setCommand.position = resolveAnchor(aircraftState, anchor.frame, anchor.offset);
+        placeIndicator(setCommand, typeTable.get());
+    }
+
+    anchorResolutions++;
+    anchorResolveTimeSum += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+AnchorStatistics SimConnectProxy::getAnchorStatistics()
+{
+    std::scoped_lock lk(statisticsMutex);
+    return anchorStatistics;
+}
+
+void SimConnectProxy::detectGatePassages(const AircraftStateStruct& aircraftState, std::chrono::steady_clock::time_point time)
+{
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    unsigned long long segments = gateDetector.getStatistics().segments;
+
+    std::span<const GateEvent> events = gateDetector.addAircraftState(aircraftState, timestamp);
+
+    // states which did not start a test, e.g. without rings, are not included in the average
+    if (gateDetector.getStatistics().segments != segments)
+    {
+        gateTestTimeSum += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    if (!events.empty())
+    {
+        this->callback->handleGateEvents(events);
+    }
+}
+
+GateStatistics SimConnectProxy::getGateStatistics()
+{
+    std::scoped_lock lk(statisticsMutex);
+    return gateStatistics;
+}
+
+void SimConnectProxy::setLodGroup(ushort id, std::shared_ptr<const IndicatorLodGroup> group, uint level)
+{
+    IndicatorPlacement& placement = indicatorPlacements[id];
+
+    if (group != nullptr && placement.lodGroup == nullptr)
+    {
+        placement.lodIndex = lodIndicators.size();
+        lodIndicators.push_back(id);
+    }
+    else if (group == nullptr && placement.lodGroup != nullptr)
+    {
+        // the last indicator takes the position of the removed one
+        ushort lastID = lodIndicators.back();
+        lodIndicators[placement.lodIndex] = lastID;
+        indicatorPlacements[lastID].lodIndex = placement.lodIndex;
+        lodIndicators.pop_back();
+    }
+
+    placement.lodGroup = std::move(group);
+    placement.lodLevel = level;
+}
+
+void SimConnectProxy::updateLevelsOfDetail(double latitude, double longitude, std::chrono::steady_clock::time_point time)
+{
+    if (time < nextLodUpdate)
+    {
+        return;
+    }
+    nextLodUpdate = time + std::chrono::milliseconds(INDICATOR_LOD_INTERVAL);
+
+    lodLatitude = latitude;
+    lodLongitude = longitude;
+    hasLodPosition = true;
+    if (lodIndicators.empty())
+    {
+        return;
+    }
+    lodUpdates++;
+
+    lodSwapList.clear();
+    for (ushort id : lodIndicators)
+    {
+        // virtual indicators get the level of their distance when they are materialized
+        if (indicatorRegistry.getState(id) == INDICATOR_SLOT_FREE)
+        {
+            continue;
+        }
+
+        IndicatorPlacement& placement = indicatorPlacements[id];
+        double distance = getGreatCircleDistance(latitude, longitude, placement.position.latitude, placement.position.longitude);
+        uint level = placement.lodGroup->selectLevel(distance, placement.lodLevel);
+        if (level != placement.lodLevel)
         {
-            SimConnect_AIRemoveObject(hSimConnect, existingObjectID, getNextRequestID());
+            lodSwapList.push_back(IndicatorLodSwap{ id, level, distance });
         }
+    }
 
-        SimConnect_AICreateSimulatedObject_EX1(hSimConnect, indicatorType.c_str(), nullptr, pos, requestID);
+    // the remaining swaps are found again by the next update
+    deferredLodSwaps += limitIndicatorLodSwaps(lodSwapList, INDICATOR_LOD_SWAP_BUDGET);
+    for (const IndicatorLodSwap& swap : lodSwapList)
+    {
+        // the SimObject of the previous model is returned to its pool
+        retireIndicator(swap.id);
+        IndicatorPlacement& placement = indicatorPlacements[swap.id];
+        placement.lodLevel = swap.level;
+        placement.modelName = placement.lodGroup->levels[swap.level].modelName;
+        materializeIndicator(swap.id);
     }
-    else if (command->getCommand() == Command::REMOVE)
+    lodSwaps += lodSwapList.size();
+}
+
+IndicatorLodStatistics SimConnectProxy::getLodStatistics()
+{
+    std::scoped_lock lk(statisticsMutex);
+    return lodStatistics;
+}
+
+void SimConnectProxy::publishStatistics()
+{
+    std::scoped_lock lk(statisticsMutex);
+
+    virtualizationStatistics = indicatorVirtualizer.getStatistics(indicatorGrid);
+
+    lodStatistics.indicators = lodIndicators.size();
+    lodStatistics.swaps = lodSwaps;
+    lodStatistics.deferredSwaps = deferredLodSwaps;
+    lodStatistics.updates = lodUpdates;
+
+    gateStatistics = gateDetector.getStatistics();
+    gateStatistics.averageTestTime = gateStatistics.segments > 0 ? gateTestTimeSum / gateStatistics.segments : 0;
+
+    anchorStatistics.anchored = anchoredIndicators.size();
+    anchorStatistics.resolutions = anchorResolutions;
+    anchorStatistics.averageResolveTime = anchorResolutions > 0 ? anchorResolveTimeSum / anchorResolutions : 0;
+}
+
+void SimConnectProxy::materializeIndicator(ushort id)
+{
+    IndicatorPlacement& placement = indicatorPlacements[id];
+    const char* modelName = placement.modelName.c_str();
+
+    IndicatorCreateRequest request = indicatorRegistry.beginCreate(id);
+    if (request.previousSimObjectID != 0)
     {
-        RemoveIndicatorsCommandConfiguration* removeCommand = static_cast<RemoveIndicatorsCommandConfiguration*>(command);
-        std::vector<ushort> idsToRemove = removeCommand->getIDsToRemove();
+        removeSimObject(request.previousSimObjectID);
+    }
+    indicatorVirtualizer.markResident(id);
 
-        if (idsToRemove.size() == 0)
+    uint pooledObjectID = indicatorPool.claim(modelName);
+    if (pooledObjectID != 0)
+    {
+        if (indicatorRegistry.assignSimObject(request.requestID, pooledObjectID) != INDICATOR_ASSIGN_OK)
         {
-            // remove all
-            idsToRemove = getAllExistingIndicators();
+            // the connection was lost in the meantime
+            releaseSimObject(modelName, pooledObjectID);
+        }
+        else if (!backend->moveObject(pooledObjectID, placement.position))
+        {
+            Logger::logError("Indicator with ID " + std::to_string(id) + " could not be placed.");
         }
-        removeIndicators(idsToRemove);
+        return;
     }
-    else {
-        Logger::logError("Unknown command.");
+
+    createSimObject(id, request.requestID);
+}
+
+void SimConnectProxy::moveIndicator(ushort id)
+{
+    IndicatorPlacement& placement = indicatorPlacements[id];
+
+    uint simObjectID = indicatorRegistry.getSimObject(id);
+    if (simObjectID == 0)
+    {
+        // the SimObject is moved as soon as its id is assigned, a waiting creation uses the new position
+        placement.isMovePending = true;
+        objectScheduler.updateCreate(id, placement.position.latitude, placement.position.longitude);
+        return;
+    }
+
+    movedIndicators.fetch_add(1, std::memory_order_relaxed);
+    if (!backend->moveObject(simObjectID, placement.position))
+    {
+        Logger::logError("Indicator with ID " + std::to_string(id) + " could not be moved.");
     }
 }
 
-void SimConnectProxy::removeIndicators(std::vector<ushort> indicatorsToRemove)
+void SimConnectProxy::retireIndicator(ushort id)
 {
-    for (ushort id : indicatorsToRemove)
+    uint existingObjectID;
+    if (indicatorRegistry.remove(id, existingObjectID))
     {
-        uint existingObjectID = getSimObjectByIndicator(id);
+        // if the SimObject is not created yet, it is removed as soon as its id is assigned or not requested at all
         if (existingObjectID != 0)
         {
-            SimConnect_AIRemoveObject(hSimConnect, existingObjectID, getNextRequestID());
-            removeIndicatorMapping(id);
+            releaseSimObject(indicatorPlacements[id].modelName.c_str(), existingObjectID);
         }
-        else {
+        else
+        {
+            objectScheduler.cancelCreate(id);
+        }
+    }
+    indicatorVirtualizer.markVirtual(id);
+}
+
+void SimConnectProxy::removeIndicators(std::span<const ushort> indicatorsToRemove)
+{
+    detachAnchors(indicatorsToRemove);
+
+    for (ushort id : indicatorsToRemove)
+    {
+        IndicatorPlacement& placement = indicatorPlacements[id];
+        if (!placement.isPlaced)
+        {
             Logger::logWarning("The indicator with ID " + std::to_string(id) + " cannot be removed because it is unknown.");
+            continue;
         }
+
+        retireIndicator(id);
+        indicatorGrid.remove(id);
+        gateDetector.remove(id);
+        setLodGroup(id, nullptr, 0);
+        placement.isPlaced = false;
     }
 }
 
-void SimConnectProxy::removeAllIndicators()
+void SimConnectProxy::updateVirtualization(double latitude, double longitude, std::chrono::steady_clock::time_point time)
 {
-    removeIndicators(getAllExistingIndicators());
+    if (time < nextVirtualizationUpdate)
+    {
+        return;
+    }
+    nextVirtualizationUpdate = time + std::chrono::milliseconds(INDICATOR_VIRTUALIZATION_INTERVAL);
+
+    if (!indicatorVirtualizer.isEnabled())
+    {
+        return;
+    }
+
+    materializeList.clear();
+    retireList.clear();
+    indicatorVirtualizer.update(indicatorGrid, latitude, longitude, materializeList, retireList);
+
+    // retire first, so the pools can hand the SimObjects to the new indicators
+    for (ushort id : retireList)
+    {
+        retireIndicator(id);
+    }
+    for (ushort id : materializeList)
+    {
+        IndicatorPlacement& placement = indicatorPlacements[id];
+        if (placement.lodGroup != nullptr)
+        {
+            // the distance changed while the indicator was virtual
+            placement.lodLevel = placement.lodGroup->selectLevel(getGreatCircleDistance(latitude, longitude,
+                placement.position.latitude, placement.position.longitude));
+            placement.modelName = placement.lodGroup->levels[placement.lodLevel].modelName;
+        }
+        materializeIndicator(id);
+    }
 }
 
-void SimConnectProxy::resetIndicatorTypeMapping()
+VirtualizationStatistics SimConnectProxy::getVirtualizationStatistics()
 {
-    this->indicatorTypeMapping.clear();
+    std::scoped_lock lk(statisticsMutex);
+    return virtualizationStatistics;
 }
 
-void SimConnectProxy::initIndicatorTypeMapping()
+void SimConnectProxy::setVirtualizationConfiguration(const VirtualizationConfiguration& configuration)
 {
-    std::ifstream indicatorMappingFile("indicators.properties");
+    indicatorVirtualizer.configure(configuration);
+}
 
-    if (!indicatorMappingFile.good())
+void SimConnectProxy::releaseSimObject(const char* modelName, uint simObjectID)
+{
+    if (indicatorPool.release(modelName, simObjectID))
     {
-        Logger::logError("Indicator mappings could not be loaded.");
+        backend->moveObject(simObjectID, indicatorPool.getParkingPosition());
+    }
+    else
+    {
+        removeSimObject(simObjectID);
+    }
+}
+
+void SimConnectProxy::createSimObject(ushort id, uint requestID)
+{
+    const IndicatorPlacement& placement = indicatorPlacements[id];
+    if (objectScheduler.isEnabled())
+    {
+        if (objectScheduler.scheduleCreate(id, requestID, placement.position.latitude, placement.position.longitude, std::chrono::steady_clock::now()))
+        {
+            backend->wakeUp();
+        }
         return;
     }
 
-    while (indicatorMappingFile.good())
+    createdIndicators.fetch_add(1, std::memory_order_relaxed);
+    if (!backend->createObject(placement.modelName.c_str(), placement.position, requestID))
     {
-        std::string row;
-        std::getline(indicatorMappingFile, row);
+        Logger::logError("Indicator with ID " + std::to_string(id) + " could not be placed.");
+    }
+}
 
-        std::vector<std::string> parts = splitString(row, '=');
+void SimConnectProxy::removeSimObject(uint simObjectID)
+{
+    if (objectScheduler.isEnabled())
+    {
+        if (objectScheduler.scheduleRemove(simObjectID, std::chrono::steady_clock::now()))
+        {
+            backend->wakeUp();
+        }
+        return;
+    }
 
-        if (parts.size() != 2) // just a warning if row does not consist of two parts 
+    backend->removeObject(simObjectID, getNextRequestID());
+}
+
+void SimConnectProxy::dispatchObjectOperations()
+{
+    dueRemoveList.clear();
+    dueCreateList.clear();
+    objectScheduler.takeDue(std::chrono::steady_clock::now(), lastAircraftState.latitude, lastAircraftState.longitude, hasAircraftState,
+        dueRemoveList, dueCreateList);
+
+    for (uint simObjectID : dueRemoveList)
+    {
+        backend->removeObject(simObjectID, getNextRequestID());
+    }
+
+    if (dueCreateList.empty())
+    {
+        return;
+    }
+
+    // an indicator which was replaced after its creation was taken gets a stale SimObject, which is removed on assignment
+    for (const ScheduledCreate& create : dueCreateList)
+    {
+        // the SimObject is created at the latest position
+        IndicatorPlacement& placement = indicatorPlacements[create.id];
+        placement.isMovePending = false;
+
+        createdIndicators.fetch_add(1, std::memory_order_relaxed);
+        if (!backend->createObject(placement.modelName.c_str(), placement.position, create.requestID))
         {
-            Logger::logWarning("Invalid indicator mapping: " + row);
-            continue;
+            Logger::logError("Indicator with ID " + std::to_string(create.id) + " could not be placed.");
         }
+    }
+}
+
+void SimConnectProxy::setObjectSchedulerConfiguration(const ObjectSchedulerConfiguration& configuration)
+{
+    objectScheduler.configure(configuration);
+}
+
+ObjectSchedulerStatistics SimConnectProxy::getObjectSchedulerStatistics() const
+{
+    return objectScheduler.getStatistics();
+}
+
+void SimConnectProxy::refillIndicatorPools()
+{
+    if (!isSimulationActive())
+    {
+        return;
+    }
 
-        ulong key = std::stoi(parts[0]);
-        indicatorTypeMapping.insert({ key, parts[1] });
+    // the SimObjects are parked below the user aircraft, so they are created in the loaded area of the simulation
+    if (hasAircraftState)
+    {
+        indicatorPool.setParkingPosition(lastAircraftState.latitude, lastAircraftState.longitude);
+    }
+
+    uint surplusObjects[INDICATOR_POOL_REFILL_BATCH];
+    size_t surplusCount = indicatorPool.takeSurplus(surplusObjects);
+    for (size_t i = 0; i < surplusCount; i++)
+    {
+        removeSimObject(surplusObjects[i]);
     }
+
+    // the indicators are created first, the pools get the remaining tokens
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    IndicatorPoolRefill refills[INDICATOR_POOL_REFILL_BATCH];
+    size_t granted = objectScheduler.acquire(INDICATOR_POOL_REFILL_BATCH, now);
+    size_t refillCount = indicatorPool.getRefills(now, std::span<IndicatorPoolRefill>(refills, granted));
+    objectScheduler.release(granted - refillCount);
+    if (refillCount == 0)
+    {
+        return;
+    }
+
+    WorldPositionStruct parkingPosition = indicatorPool.getParkingPosition();
+    for (size_t i = 0; i < refillCount; i++)
+    {
+        // a request which could not be sent is given up by the pool after INDICATOR_POOL_CREATE_TIMEOUT
+        backend->createObject(refills[i].modelName, parkingPosition, refills[i].requestID);
+    }
+}
+
+std::vector<IndicatorPoolStatistics> SimConnectProxy::getPoolStatistics() const
+{
+    return indicatorPool.getStatistics();
+}
+
+void SimConnectProxy::removeAllIndicators()
+{
+    removeAllRequested.store(true, std::memory_order_release);
+    backend->wakeUp();
 }
 
-const std::unordered_map<ulong, std::string>& SimConnectProxy::getIndicatorTypeMapping()
+void SimConnectProxy::removePlacedIndicators()
 {
-    if (this->indicatorTypeMapping.size() == 0)
+    std::vector<ushort> placedIDs;
+    for (size_t id = 0; id < INDICATOR_REGISTRY_SIZE; id++)
     {
-        this->initIndicatorTypeMapping();
+        if (indicatorPlacements[id].isPlaced)
+        {
+            placedIDs.push_back(static_cast<ushort>(id));
+        }
     }
+    removeIndicators(placedIDs);
+}
 
-    return this->indicatorTypeMapping;
+void SimConnectProxy::executeQueuedCommands()
+{
+    if (removeAllRequested.exchange(false, std::memory_order_acquire))
+    {
+        removePlacedIndicators();
+    }
+
+    if (!isSimulationActive())
+    {
+        // the commands were accepted before the simulation stopped
+        discardQueuedCommands();
+        return;
+    }
+
+    // the commands are executed in place, they are too large to be copied out of the queue
+    while (commandQueue.consume([this](ParsedCommand& command) { executeCommand(command); }))
+    {
+    }
 }
 
-std::string SimConnectProxy::getIndicatorTypeName(ulong indicatorTypeID)
+void SimConnectProxy::discardQueuedCommands()
 {
-    std::unordered_map<ulong, std::string> typeMapping = getIndicatorTypeMapping();
-    std::unordered_map<ulong, std::string>::const_iterator it = typeMapping.find(indicatorTypeID);
-    if (it == typeMapping.end())
+    while (commandQueue.consume([](ParsedCommand&) {}))
     {
-        // nothing found -> return empty string
-        return "";
     }
+}
+
+IndicatorRegistryStatistics SimConnectProxy::getIndicatorStatistics() const
+{
+    return indicatorRegistry.getStatistics();
+}
+
+IndicatorPlacementStatistics SimConnectProxy::getPlacementStatistics() const
+{
+    IndicatorPlacementStatistics statistics;
+    statistics.created = createdIndicators.load(std::memory_order_relaxed);
+    statistics.moved = movedIndicators.load(std::memory_order_relaxed);
+    statistics.deferredMoves = deferredIndicatorMoves.load(std::memory_order_relaxed);
+    statistics.unchanged = unchangedIndicators.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void SimConnectProxy::resetIndicatorTypeMapping()
+{
+    // commands in progress keep their snapshot, the new mapping is published when it is completely loaded
+    indicatorTypeTableWatcher.requestReload();
+}
 
-    return it->second; // return value
+std::shared_ptr<const IndicatorTypeTable> SimConnectProxy::getIndicatorTypeTable()
+{
+    return indicatorTypeTable.load();
 }
 
 bool SimConnectProxy::isSimulationActive()
@@ -207,7 +753,7 @@ bool SimConnectProxy::isSimulationActive()
 int SimConnectProxy::getNextRequestID()
 {
     int nextID = nextRequestID.fetch_add(1);
-    if (nextID <= 0)
+    if (nextID <= 0 || static_cast<uint>(nextID) >= INDICATOR_POOL_REQUEST_FLAG)
     {
         nextID = 1000;
         nextRequestID.store(nextID);
@@ -219,185 +765,304 @@ int SimConnectProxy::getNextRequestID()
 void SimConnectProxy::stopSimConnectProxy()
 {
     isRunning = false;
-    SimConnect_Close(this->hSimConnect);
+    commandQueue.close();
+    backend->wakeUp();
+    if (recvDataThread.joinable())
+    {
+        recvDataThread.join();
+    }
+
+    indicatorTypeTableWatcher.stop();
+
+    // the removals are not paced any more, so no SimObject is left behind
+    dueRemoveList.clear();
+    objectScheduler.takeAllRemoves(dueRemoveList);
+    for (uint simObjectID : dueRemoveList)
+    {
+        backend->removeObject(simObjectID, getNextRequestID());
+    }
+    backend->close();
 }
 
-void SimConnectProxy::setRequestToIndicator(uint requestID, ushort indicatorID)
+void SimConnectProxy::assignSimObject(uint requestID, uint simObjectID)
 {
-    std::scoped_lock lk(requestToIndicatorMutex);
-    requestToIndicator[requestID] = indicatorID;
+    if ((requestID & INDICATOR_CREATE_REQUEST_FLAG) == 0 && (requestID & INDICATOR_POOL_REQUEST_FLAG) != 0)
+    {
+        if (!indicatorPool.addCreated(requestID, simObjectID))
+        {
+            removeSimObject(simObjectID);
+        }
+        return;
+    }
+
+    switch (indicatorRegistry.assignSimObject(requestID, simObjectID))
+    {
+        case INDICATOR_ASSIGN_OK:
+        {
+            // the position may have changed while the SimObject was created
+            ushort indicatorID = static_cast<ushort>(requestID);
+            IndicatorPlacement& placement = indicatorPlacements[indicatorID];
+            if (placement.isMovePending)
+            {
+                placement.isMovePending = false;
+                deferredIndicatorMoves.fetch_add(1, std::memory_order_relaxed);
+                backend->moveObject(simObjectID, placement.position);
+            }
+            break;
+        }
+        case INDICATOR_ASSIGN_STALE:
+            // the indicator was replaced or removed while the SimObject was created
+            removeSimObject(simObjectID);
+            break;
+        case INDICATOR_ASSIGN_UNKNOWN:
+            Logger::logWarning("Unknown indicator ID detected.");
+            break;
+    }
+}
+
+bool SimConnectProxy::connectCore()
+{
+    while (!backend->open())
+    {
+        if (!isRunning)
+        {
+            return false;
+        }
+        discardQueuedCommands();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    Logger::logInfo(std::string("Connected to ") + backend->getName());
+
+    std::scoped_lock lk(telemetryMutex);
+    isConnected = true;
+    backend->requestAircraftState(telemetryConfiguration.period, telemetryConfiguration.periodCount, telemetryConfiguration.adaptive);
+
+    return true;
 }
 
-void SimConnectProxy::setIndicatorToSimObject(uint requestID, uint simObjectID)
+void SimConnectProxy::setTelemetryConfiguration(const TelemetryConfiguration& configuration)
 {
-    std::scoped_lock lk(requestToIndicatorMutex, indicatorToSimObjectMutex);
-    ushort indicatorID = requestToIndicator[requestID];
+    std::scoped_lock lk(telemetryMutex);
+
+    telemetryConfiguration = configuration;
+    telemetryMinimumInterval.store(configuration.rate > 0 ? static_cast<long long>(1e9 / configuration.rate) : 0, std::memory_order_relaxed);
+    isTelemetryAdaptive.store(configuration.adaptive, std::memory_order_relaxed);
+    telemetryResetRequested.store(true, std::memory_order_release);
 
-    if (indicatorID == 0)
+    // in adaptive mode the simulation only reports changed states, unchanged ones are covered by the keep alive
+    if (isConnected && !backend->requestAircraftState(configuration.period, configuration.periodCount, configuration.adaptive))
     {
-        Logger::logWarning("Unknown indicator ID detected.");
+        Logger::logError("Aircraft state updates could not be requested.");
         return;
     }
 
-    requestToIndicator.erase(requestID);
-    indicatorToSimObject[indicatorID] = simObjectID;
+    Logger::logInfo("Aircraft state updates: " + toString(configuration));
 }
 
-uint SimConnectProxy::getSimObjectByIndicator(ushort indicatorID)
+bool SimConnectProxy::isTelemetryUpdateDue(std::chrono::steady_clock::time_point readyTime)
 {
-    std::scoped_lock lk(indicatorToSimObjectMutex);
-    try {
-        return indicatorToSimObject.at(indicatorID);
+    std::chrono::nanoseconds interval(telemetryMinimumInterval.load(std::memory_order_relaxed));
+    if (interval.count() == 0)
+    {
+        return true;
+    }
+
+    // frames arrive with some jitter, a frame slightly before the due time is accepted, otherwise every second update would be lost
+    if (readyTime < nextTelemetryUpdate - interval / 4)
+    {
+        return false;
     }
-    catch (std::out_of_range e)
+
+    nextTelemetryUpdate += interval;
+    if (nextTelemetryUpdate <= readyTime)
     {
-        return 0;
+        nextTelemetryUpdate = readyTime + interval;
     }
+    return true;
 }
 
-std::vector<ushort> SimConnectProxy::getAllExistingIndicators()
+void SimConnectProxy::runSimConnectMessageLoop()
 {
-    std::scoped_lock lk(indicatorToSimObjectMutex);
-    
-    std::vector<ushort> keys(indicatorToSimObject.size());
-
-    for (std::pair<ushort, uint> entry : indicatorToSimObject)
+    if (!connectCore())
     {
-        keys.push_back(entry.first);
+        return;
     }
 
-    return keys;
+    while (isRunning)
+    {
+        // blocks until the backend signals new messages, the proxy is stopped or the next waiting SimObject operation is due
+        if (backend->waitForEvents(objectScheduler.getWaitTimeout(std::chrono::steady_clock::now(), SIM_DISPATCH_WAIT_TIMEOUT)))
+        {
+            dispatchWakeUps.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            dispatchTimeouts.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        drainEvents();
+        executeQueuedCommands();
+        sendTelemetryKeepAlive();
+        dispatchObjectOperations();
+        refillIndicatorPools();
+        publishStatistics();
+    }
 }
 
-void SimConnectProxy::removeIndicatorMapping(ushort indicatorID)
+void SimConnectProxy::handleAircraftState(const SimEvent& event)
 {
-    std::scoped_lock lk(indicatorToSimObjectMutex);
-    indicatorToSimObject.erase(indicatorID);
+    if (telemetryResetRequested.exchange(false, std::memory_order_acquire))
+    {
+        telemetryController.reset();
+    }
+
+    // the anchored indicators follow every reported state, independent of the telemetry rate
+    resolveAnchors(event.aircraftState);
+
+    // the shorter the segments, the closer they follow the flown path
+    detectGatePassages(event.aircraftState, event.readyTime);
+
+    if (!isTelemetryUpdateDue(event.readyTime))
+    {
+        skippedAircraftStates.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    lastAircraftState = event.aircraftState;
+    hasAircraftState = true;
+    updateVirtualization(event.aircraftState.latitude, event.aircraftState.longitude, event.readyTime);
+    updateLevelsOfDetail(event.aircraftState.latitude, event.aircraftState.longitude, event.readyTime);
+
+    if (isTelemetryAdaptive.load(std::memory_order_relaxed) && !telemetryController.shouldSend(event.aircraftState, event.readyTime))
+    {
+        return;
+    }
+
+    aircraftStates.fetch_add(1, std::memory_order_relaxed);
+    this->callback->handleAircraftStateUpdate(AircraftState{ event.aircraftState });
 }
 
-void SimConnectProxy::connectCore()
+void SimConnectProxy::sendTelemetryKeepAlive()
 {
-    // as of dec 2025 there is a bug in SimConnect >= 1.4.5 (https://devsupport.flightsimulator.com/t/memory-leak-in-simconnect-open-function-sdk-1-4-5/17043)
-    // so this only works with SimConnect SDK 1.2.4
-    while (FAILED(SimConnect_Open(&this->hSimConnect, "Visual Flight Path", NULL, 0, 0, SIMCONNECT_OPEN_CONFIGINDEX_LOCAL)))
+    if (!isTelemetryAdaptive.load(std::memory_order_relaxed) || !hasAircraftState || !isSimulationActive())
     {
-        Sleep(10);
+        return;
     }
 
-    subscribeToEvents();
+    if (telemetryController.isKeepAliveDue(std::chrono::steady_clock::now()))
+    {
+        aircraftStates.fetch_add(1, std::memory_order_relaxed);
+        this->callback->handleAircraftStateUpdate(AircraftState{ lastAircraftState });
+    }
 }
 
-void SimConnectProxy::runSimConnectMessageLoop()
+TelemetryControllerStatistics SimConnectProxy::getTelemetryStatistics() const
 {
-    connectCore();
+    return telemetryController.getStatistics();
+}
 
-    isRunning = true;
-    
-    SIMCONNECT_RECV* pData;
-    DWORD cbData;
-    HRESULT res;
+void SimConnectProxy::drainEvents()
+{
+    SimEvent event;
 
-    while (isRunning)
+    while (isRunning && backend->getNextEvent(event))
     {
-        res = SimConnect_GetNextDispatch(hSimConnect, &pData, &cbData);
-
-        if (res == E_FAIL)
+        unsigned long long latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - event.readyTime).count();
+        dispatchedEvents.fetch_add(1, std::memory_order_relaxed);
+        dispatchLatencySum.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > dispatchLatencyMax.load(std::memory_order_relaxed))
         {
-            //no Message in the queue -> wait and continue
-            Sleep(1);
-            continue;
+            dispatchLatencyMax.store(latency, std::memory_order_relaxed); // only written by this thread
         }
 
-        if (SUCCEEDED(res))
-        {
-            handleSimConnectMessageCore(pData);
-        }
+        handleSimEvent(event);
     }
 }
 
-void SimConnectProxy::handleSimConnectMessageCore(SIMCONNECT_RECV* pData)
+SimDispatchStatistics SimConnectProxy::getDispatchStatistics() const
 {
-    switch (pData->dwID)
+    SimDispatchStatistics statistics;
+    statistics.wakeUps = dispatchWakeUps.load(std::memory_order_relaxed);
+    statistics.timeouts = dispatchTimeouts.load(std::memory_order_relaxed);
+    statistics.events = dispatchedEvents.load(std::memory_order_relaxed);
+    statistics.averageLatency = statistics.events == 0 ? 0 : dispatchLatencySum.load(std::memory_order_relaxed) / statistics.events;
+    statistics.maxLatency = dispatchLatencyMax.load(std::memory_order_relaxed);
+    statistics.aircraftStates = aircraftStates.load(std::memory_order_relaxed);
+    statistics.skippedAircraftStates = skippedAircraftStates.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void SimConnectProxy::handleSimEvent(const SimEvent& event)
+{
+    switch (event.type)
     {
-        // Simulation started and stopped events do not occur as expected
-        // According to https://docs.flightsimulator.com/msfs2024/html/6_Programming_APIs/SimConnect/API_Reference/Events_And_Data/SimConnect_SubscribeToSystemEvent.htm
-        // the system event SimStart should be send if the user is in control of an aircraft but it is also send when MSFS starts and is in main menu
-        // -> its currently seems impossible to determine the active running state of the simulation
-       case SIMCONNECT_RECV_ID_EVENT : // Simulation started or stopped
+       case SIM_EVENT_STARTED:
        {
-           SIMCONNECT_RECV_EVENT* evt = reinterpret_cast<SIMCONNECT_RECV_EVENT*>(pData);
-           switch (evt->uEventID)
-           {
-                case SIM_START:
-                {
-                    Logger::logInfo("Simulation started");
-                    simulationIsActive.store(true, std::memory_order_release);
-                    break;
-                }
-                case SIM_STOP:
-                {
-                    Logger::logInfo("Simulation stopped");
-                    simulationIsActive.store(false, std::memory_order_release);
-                    removeAllIndicators();
-                    break;
-                }
-           }
+           Logger::logInfo("Simulation started");
+           simulationIsActive.store(true, std::memory_order_release);
            break;
        }
-       case SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID: // object created with given id
+       case SIM_EVENT_STOPPED:
        {
-           SIMCONNECT_RECV_ASSIGNED_OBJECT_ID* aoi = reinterpret_cast<SIMCONNECT_RECV_ASSIGNED_OBJECT_ID*>(pData);
-
-           this->setIndicatorToSimObject(aoi->dwRequestID, aoi->dwObjectID);
-           
+           Logger::logInfo("Simulation stopped");
+           simulationIsActive.store(false, std::memory_order_release);
+           removePlacedIndicators();
            break;
        }
-       case SIMCONNECT_RECV_ID_SYSTEM_STATE: // current state of the simulation
+       case SIM_EVENT_OBJECT_ASSIGNED: // object created with given id
        {
-           SIMCONNECT_RECV_SYSTEM_STATE* st = reinterpret_cast<SIMCONNECT_RECV_SYSTEM_STATE*>(pData);
-           if (st->dwRequestID == SIM_STATE)
-           {
-               simulationIsActive.store(st->dwInteger == 1, std::memory_order_release);
-           }
+           this->assignSimObject(event.requestID, event.objectID);
+           break;
+       }
+       case SIM_EVENT_RUNNING_STATE: // current state of the simulation
+       {
+           simulationIsActive.store(event.isRunning, std::memory_order_release);
            break;
        }
-       case SIMCONNECT_RECV_ID_SIMOBJECT_DATA: // polled aircraft information
+       case SIM_EVENT_PAUSE:
+       {
+           Logger::logInfo(event.isPaused ? "Simulation paused" : "Simulation resumed");
+           telemetryController.setPaused(event.isPaused);
+           break;
+       }
+       case SIM_EVENT_AIRCRAFT_STATE: // polled aircraft information
        {
            if (!isSimulationActive())
            {
                // The position will also be provided if the simulation is in menus :(
                return;
            }
-           SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = (SIMCONNECT_RECV_SIMOBJECT_DATA*)pData;
-           switch (pObjData->dwRequestID)
-           {
-           case AIRCRAFT_STATE:
-               AircraftStateStruct tmp{};
-               std::memcpy(&tmp, &pObjData->dwData, sizeof(tmp));
-
-               this->callback->handleAircraftStateUpdate(AircraftState{ tmp });
-               break;
-           }
+           handleAircraftState(event);
            break;
        }
-       case SIMCONNECT_RECV_ID_QUIT:
+       case SIM_EVENT_EXCEPTION:
+       {
+           Logger::logWarning("The simulation rejected a request (exception " + std::to_string(event.exception) + ").");
+           break;
+       }
+       case SIM_EVENT_QUIT:
        {
            simulationIsActive.store(false, std::memory_order_release);
+           {
+               std::scoped_lock lk(telemetryMutex);
+               isConnected = false;
+           }
 
            Logger::logInfo("SimConnect connection closed. Waiting for new connection.");
-           // clear all mappings
-
-           { // section for scoped lock
-               std::scoped_lock lk(indicatorToSimObjectMutex);
-               indicatorToSimObject.clear();
-           }
+           // clear all mappings, the SimObjects are lost together with the connection
+           indicatorRegistry.clear();
+           indicatorPool.clear();
+           objectScheduler.clear();
+           // the indicators stay placed, with virtualization they are materialized again near the aircraft
+           indicatorVirtualizer.clearResidents();
 
            // waiting for new connection
-           connectCore();
-
-           Logger::logInfo("SimConnect connection reestablished.");
+           if (connectCore())
+           {
+               Logger::logInfo("SimConnect connection reestablished.");
+           }
            break;
        }
     }
-}
-
+}
\ No newline at end of file
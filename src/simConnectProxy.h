@@ -21,14 +21,69 @@
 #include "datatypes.h"
 #include "udpCommand.h"
 #include "aircraftState.h"
-
-#include "windows.h"
-#include "SimConnect.h"
-#include <unordered_map>
+#include "indicatorTypeTable.h"
+#include "indicatorTypeTableWatcher.h"
+#include "indicatorRegistry.h"
+#include "indicatorPool.h"
+#include "indicatorGrid.h"
+#include "indicatorVirtualizer.h"
+#include "indicatorLod.h"
+#include "pathGenerator.h"
+#include "indicatorAnchor.h"
+#include "gateDetector.h"
+#include "objectScheduler.h"
+#include "simBackend.h"
+#include "telemetry.h"
+#include "telemetryController.h"
+#include "ringBuffer.h"
+
+#include <string>
 #include <vector>
 #include <thread>
-#include <mutex>
 #include <optional>
+#include <span>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+/// Maximum time the message loop blocks without an event before it checks the running state again (in ms)
+#define SIM_DISPATCH_WAIT_TIMEOUT 1000
+
+/// Number of indicator commands which wait for the message loop before handleCommand blocks
+#define SIM_COMMAND_QUEUE_CAPACITY 256
+
+/// <summary>
+/// Snapshot of the counters of the message loop.
+/// </summary>
+struct SimDispatchStatistics {
+    unsigned long long wakeUps;        // waits which ended because of an event or a wake up
+    unsigned long long timeouts;       // waits which ended without an event
+    unsigned long long events;         // handled events
+    unsigned long long averageLatency; // average time between availability and handling of an event in microseconds
+    unsigned long long maxLatency;     // maximum time between availability and handling of an event in microseconds
+    unsigned long long aircraftStates;        // aircraft states which were passed to the callback
+    unsigned long long skippedAircraftStates; // aircraft states which were dropped by the rate limit
+};
+
+/// <summary>
+/// Snapshot of the outcome of the SET commands.
+/// </summary>
+struct IndicatorPlacementStatistics {
+    unsigned long long created;       // SimObjects created, including replacements with another model
+    unsigned long long moved;         // existing SimObjects moved to the new position
+    unsigned long long deferredMoves; // SimObjects moved right after their creation because the position changed meanwhile
+    unsigned long long unchanged;     // SETs which repeated the current position and were skipped
+};
+
+/// <summary>
+/// Snapshot of the counters of the indicators anchored to the aircraft.
+/// </summary>
+struct AnchorStatistics {
+    size_t anchored;                       // indicators which follow the aircraft
+    unsigned long long resolutions;        // aircraft states for which the anchored indicators were placed
+    unsigned long long averageResolveTime; // average time to calculate and place all anchored indicators of an aircraft state in ns
+};
 
 /// <summary>
 /// Callback for status updates from the SimConnect-API
@@ -45,6 +100,12 @@ public:
     /// </summary>
     /// <param name="aircraftState">The current position, orientation, and speed of the simulated aircraft</param>
     virtual void handleAircraftStateUpdate(AircraftState aircraftState) = 0;
+
+    /// <summary>
+    /// Handles the ring passages of the last motion segment of the aircraft.
+    /// </summary>
+    /// <param name="events">The passages in chronological order</param>
+    virtual void handleGateEvents(std::span<const GateEvent> events) = 0;
 };
 
 /// <summary>
@@ -53,51 +114,160 @@ public:
 class SimConnectProxy {
 public:
     /// <summary>
-    /// Starts a new thread to connect with the SimConnect-API. If the API is not available the thread tries until it is stopped.
+    /// Starts a new thread to connect with the simulation backend. If the simulation is not available the thread tries until it is stopped.
     /// Commands cannot be executed until the connection is established.
-    /// The new thread then handles the SimConnect events using the SimConnectCallback.
+    /// The new thread then handles the events of the simulation using the SimConnectCallback.
     /// </summary>
     /// <param name="callback">Callback to handle aircraft status updates</param>
-    void startSimConnectProxy(SimConnectCallback* callback);
+    /// <param name="backend">Connection to the simulation, e.g. SimConnect</param>
+    void startSimConnectProxy(SimConnectCallback* callback, std::unique_ptr<SimBackend> backend);
 
     /// <summary>
-    /// Stops the SimConnectProxy. That means it stops the thread and if the connection to SimConnect has been established it is
+    /// Stops the SimConnectProxy. That means it stops the thread, waits for it and if the connection to SimConnect has been established it is
     /// disconnected.
     /// </summary>
     void stopSimConnectProxy();
 
     /// <summary>
-    /// Executes a command based on the given command configuration.
+    /// Passes the given parsed command to the message loop, which owns the indicators and executes it. Blocks while
+    /// SIM_COMMAND_QUEUE_CAPACITY commands are waiting. Must only be called by one thread, the command executor.
     /// </summary>
-    /// <param name="command">Command configuration</param>
-    void handleCommand(AbstractCommandConfiguration* command);
+    /// <param name="command">Parsed command</param>
+    void handleCommand(const ParsedCommand& command);
 
     /// <summary>
-    /// Removes all indicators which are known by this instance.
+    /// Requests the removal of all indicators which are known by this instance. They are removed by the message loop.
     /// </summary>
     void removeAllIndicators();
 
     /// <summary>
-    /// Resets the indicator type mapping. The mapping will be updated before the next indicator is placed in the simulation.
+    /// Reloads the indicator type mapping in the background. Indicators are placed with the previous mapping until the new one is loaded.
     /// </summary>
     void resetIndicatorTypeMapping();
 
+    /// <summary>
+    /// Changes the period of the aircraft state updates. The change is applied immediately if the simulation is connected,
+    /// otherwise when the connection is established.
+    /// </summary>
+    /// <param name="configuration">New telemetry configuration</param>
+    void setTelemetryConfiguration(const TelemetryConfiguration& configuration);
+
+    /// <summary>
+    /// Returns the counters of the indicator registry.
+    /// </summary>
+    /// <returns>Statistics of the indicator registry</returns>
+    IndicatorRegistryStatistics getIndicatorStatistics() const;
+
+    /// <summary>
+    /// Returns the counters of the adaptive telemetry.
+    /// </summary>
+    /// <returns>Statistics of the adaptive telemetry</returns>
+    TelemetryControllerStatistics getTelemetryStatistics() const;
+
+    /// <summary>
+    /// Returns the counters of the message loop.
+    /// </summary>
+    /// <returns>Statistics of the message loop</returns>
+    SimDispatchStatistics getDispatchStatistics() const;
+
+    /// <summary>
+    /// Returns the counters of the SET commands.
+    /// </summary>
+    /// <returns>Statistics of the indicator placement</returns>
+    IndicatorPlacementStatistics getPlacementStatistics() const;
+
+    /// <summary>
+    /// Returns the counters of the pools of pre-created SimObjects.
+    /// </summary>
+    /// <returns>Statistics of each pool</returns>
+    std::vector<IndicatorPoolStatistics> getPoolStatistics() const;
+
+    /// <summary>
+    /// Changes the radius and maximum count of the materialized indicators. Must be called before startSimConnectProxy.
+    /// </summary>
+    /// <param name="configuration">New virtualization configuration</param>
+    void setVirtualizationConfiguration(const VirtualizationConfiguration& configuration);
+
+    /// <summary>
+    /// Returns the counters of the indicator virtualization.
+    /// </summary>
+    /// <returns>Statistics of the virtualization</returns>
+    VirtualizationStatistics getVirtualizationStatistics();
+
+    /// <summary>
+    /// Returns the counters of the level of detail switching.
+    /// </summary>
+    /// <returns>Statistics of the level of detail switching</returns>
+    IndicatorLodStatistics getLodStatistics();
+
+    /// <summary>
+    /// Returns the counters of the indicators anchored to the aircraft.
+    /// </summary>
+    /// <returns>Statistics of the anchored indicators</returns>
+    AnchorStatistics getAnchorStatistics();
+
+    /// <summary>
+    /// Returns the counters of the gate detection.
+    /// </summary>
+    /// <returns>Statistics of the gate detection</returns>
+    GateStatistics getGateStatistics();
+
+    /// <summary>
+    /// Changes the pacing of the SimObject creations and removals.
+    /// </summary>
+    /// <param name="configuration">New scheduler configuration</param>
+    void setObjectSchedulerConfiguration(const ObjectSchedulerConfiguration& configuration);
+
+    /// <summary>
+    /// Returns the counters of the paced SimObject creations and removals.
+    /// </summary>
+    /// <returns>Statistics of the object scheduler</returns>
+    ObjectSchedulerStatistics getObjectSchedulerStatistics() const;
+
 private:
+    /// <summary>
+    /// Last requested model and position of an indicator, used to move its SimObject instead of replacing it.
+    /// </summary>
+    struct IndicatorPlacement {
+        bool isPlaced; // set by SET, cleared by REMOVE
+        std::string modelName;
+        WorldPositionStruct position;
+        bool isMovePending; // the position changed while the SimObject was created
+        std::shared_ptr<const IndicatorLodGroup> lodGroup; // nullptr if the indicator type maps to a single model
+        uint lodLevel;      // index of modelName in lodGroup
+        size_t lodIndex;    // position in lodIndicators
+    };
+
+    /// <summary>
+    /// Indicator which follows the aircraft.
+    /// </summary>
+    struct AnchoredIndicator {
+        ushort id;
+        uint indicatorTypeID;
+        AnchorFrame frame;
+        AnchorOffset offset;
+    };
+
     /// <summary>
     /// Callback for aircraft status updates.
     /// </summary>
     SimConnectCallback* callback;
 
     /// <summary>
-    /// Handle for the connection to SimConnect
+    /// Connection to the simulation
     /// </summary>
-    HANDLE hSimConnect = NULL;
+    std::unique_ptr<SimBackend> backend;
     
 
     /// <summary>
-    /// Mapping: indicator type id -> model name
+    /// Current snapshot of the mapping indicator type id -> model name, nullptr if it could not be loaded
     /// </summary>
-    std::unordered_map<ulong, std::string> indicatorTypeMapping;
+    std::atomic<std::shared_ptr<const IndicatorTypeTable>> indicatorTypeTable;
+
+    /// <summary>
+    /// Reloads the indicator type mapping when indicators.properties changes.
+    /// </summary>
+    IndicatorTypeTableWatcher indicatorTypeTableWatcher;
 
     /// <summary>
     /// Indicates the status of the thread.
@@ -111,38 +281,290 @@ private:
 
     /// <summary>
     /// Next request id which should be used for SimConnect commands. The next id should be polled by using
-    /// getNextRequestID to prevent collisions with reserved request ids.
+    /// getNextRequestID to prevent collisions with reserved request ids. The ids stay below INDICATOR_POOL_REQUEST_FLAG and
+    /// INDICATOR_CREATE_REQUEST_FLAG, which mark the requests creating pooled SimObjects and indicators.
     /// </summary>
     std::atomic_int nextRequestID{ 1000 }; // < 1000 will be reserved for system events that are actively polled by this application
 
     
     /// <summary>
-    /// Mapping: SimConnect request id -> external indicator id
+    /// Mapping: external indicator id -> SimObject of the indicator
     /// </summary>
-    std::unordered_map<uint, ushort> requestToIndicator;
-    
+    IndicatorRegistry indicatorRegistry;
+
+    /// <summary>
+    /// Last requested placement of each indicator, indexed by external indicator id. This is the desired state of all indicators,
+    /// resident ones have a SimObject in the registry, virtual ones only exist here and in the grid.
+    /// </summary>
+    std::vector<IndicatorPlacement> indicatorPlacements{ INDICATOR_REGISTRY_SIZE };
+
+    /// <summary>
+    /// Indicator commands on their way from the command executor (producer) to the message loop (consumer). The indicator
+    /// placements and everything derived from them are only used by the message loop, so they need no lock and the backend is
+    /// never called while a lock is held.
+    /// </summary>
+    RingBuffer<ParsedCommand> commandQueue{ SIM_COMMAND_QUEUE_CAPACITY, BLOCK };
+
+    /// <summary>
+    /// Set by removeAllIndicators, so the console thread does not need to be a second producer of commandQueue.
+    /// </summary>
+    std::atomic_bool removeAllRequested{ false };
+
+    /// <summary>
+    /// Mutex for the statistics snapshots, which are published by the message loop and read by any thread.
+    /// </summary>
+    mutable std::mutex statisticsMutex;
+
+    /// <summary>
+    /// Snapshot of the virtualization counters. Guarded by statisticsMutex.
+    /// </summary>
+    VirtualizationStatistics virtualizationStatistics{};
+
+    /// <summary>
+    /// Snapshot of the level of detail counters. Guarded by statisticsMutex.
+    /// </summary>
+    IndicatorLodStatistics lodStatistics{};
+
+    /// <summary>
+    /// Snapshot of the gate detection counters. Guarded by statisticsMutex.
+    /// </summary>
+    GateStatistics gateStatistics{};
+
+    /// <summary>
+    /// Snapshot of the counters of the anchored indicators. Guarded by statisticsMutex.
+    /// </summary>
+    AnchorStatistics anchorStatistics{};
+
+    /// <summary>
+    /// Parked SimObjects which are claimed by new indicators.
+    /// </summary>
+    IndicatorPool indicatorPool;
+
+    /// <summary>
+    /// Paces the SimObject creations and removals.
+    /// </summary>
+    ObjectScheduler objectScheduler;
+
+    /// <summary>
+    /// SimObjects which are removed by the current dispatch. Only used by the message loop.
+    /// </summary>
+    std::vector<uint> dueRemoveList;
+
+    /// <summary>
+    /// Indicators whose SimObjects are created by the current dispatch. Only used by the message loop.
+    /// </summary>
+    std::vector<ScheduledCreate> dueCreateList;
+
+    /// <summary>
+    /// Spatial index of all placed indicators. Only used by the message loop.
+    /// </summary>
+    IndicatorGrid indicatorGrid;
+
+    /// <summary>
+    /// Decides which placed indicators are materialized near the aircraft. Only used by the message loop.
+    /// </summary>
+    IndicatorVirtualizer indicatorVirtualizer;
+
+    /// <summary>
+    /// Indicators which are materialized by the current virtualization update. Only used by the message loop.
+    /// </summary>
+    std::vector<ushort> materializeList;
+
+    /// <summary>
+    /// Indicators which are retired by the current virtualization update. Only used by the message loop.
+    /// </summary>
+    std::vector<ushort> retireList;
+
+    /// <summary>
+    /// Time at which the next virtualization update is due. Only used by the message loop.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextVirtualizationUpdate;
+
+    /// <summary>
+    /// Placed indicators with a level of detail group. Only used by the message loop.
+    /// </summary>
+    std::vector<ushort> lodIndicators;
+
+    /// <summary>
+    /// Model swaps of the current level of detail update. Only used by the message loop.
+    /// </summary>
+    std::vector<IndicatorLodSwap> lodSwapList;
+
+    /// <summary>
+    /// Time at which the next level of detail update is due. Only used by the message loop.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextLodUpdate;
+
+    /// <summary>
+    /// Aircraft position of the last level of detail update, used to select the level of new indicators. Only used by the message loop.
+    /// </summary>
+    double lodLatitude = 0;
+
+    /// <summary>
+    /// See lodLatitude.
+    /// </summary>
+    double lodLongitude = 0;
+
+    /// <summary>
+    /// False until the first level of detail update. Only used by the message loop.
+    /// </summary>
+    bool hasLodPosition = false;
+
+    /// <summary>
+    /// Number of model swaps. Only used by the message loop.
+    /// </summary>
+    unsigned long long lodSwaps = 0;
+
+    /// <summary>
+    /// Number of model swaps which were postponed by the budget. Only used by the message loop.
+    /// </summary>
+    unsigned long long deferredLodSwaps = 0;
+
+    /// <summary>
+    /// Number of level of detail updates. Only used by the message loop.
+    /// </summary>
+    unsigned long long lodUpdates = 0;
+
     /// <summary>
-    /// Mapping: external indicator id -> SimConnect handle of the SimObject
+    /// Indicators which are placed relative to the aircraft with every aircraft state. Only used by the message loop.
     /// </summary>
-    std::unordered_map<ushort, uint> indicatorToSimObject;
+    std::vector<AnchoredIndicator> anchoredIndicators;
 
+    /// <summary>
+    /// Number of aircraft states for which the anchored indicators were placed. Only used by the message loop.
+    /// </summary>
+    unsigned long long anchorResolutions = 0;
+
+    /// <summary>
+    /// Sum of the times to place the anchored indicators in ns. Only used by the message loop.
+    /// </summary>
+    unsigned long long anchorResolveTimeSum = 0;
 
     /// <summary>
-    /// Mutex for accessing the request id to external indicator id mapping.
+    /// Detects the passages of the aircraft through the ring indicators. Only used by the message loop.
     /// </summary>
-    std::mutex requestToIndicatorMutex;
+    GateDetector gateDetector;
 
     /// <summary>
-    /// Mutex for accessing the external indicator id to SimObject id mapping.
+    /// Sum of the times to test the motion segments against the rings in ns. Only used by the message loop.
     /// </summary>
-    std::mutex indicatorToSimObjectMutex;
+    unsigned long long gateTestTimeSum = 0;
 
+    /// <summary>
+    /// Generates the indicator positions of PATH commands. Only used by the message loop.
+    /// </summary>
+    PathGenerator pathGenerator;
 
     /// <summary>
-    /// Thread for polling the SimConnect message queue.
+    /// Number of created SimObjects.
+    /// </summary>
+    std::atomic<unsigned long long> createdIndicators{ 0 };
+
+    /// <summary>
+    /// Number of moved SimObjects.
+    /// </summary>
+    std::atomic<unsigned long long> movedIndicators{ 0 };
+
+    /// <summary>
+    /// Number of SimObjects which were moved right after their creation.
+    /// </summary>
+    std::atomic<unsigned long long> deferredIndicatorMoves{ 0 };
+
+    /// <summary>
+    /// Number of SETs which did not change the indicator.
+    /// </summary>
+    std::atomic<unsigned long long> unchangedIndicators{ 0 };
+
+    /// <summary>
+    /// Thread for handling the events of the simulation.
     /// </summary>
     std::thread recvDataThread;
 
+    /// <summary>
+    /// Current telemetry configuration.
+    /// </summary>
+    TelemetryConfiguration telemetryConfiguration;
+
+    /// <summary>
+    /// Mutex for the telemetry configuration and the corresponding request to the backend.
+    /// </summary>
+    std::mutex telemetryMutex;
+
+    /// <summary>
+    /// Indicates if the connection to the backend is established.
+    /// </summary>
+    bool isConnected = false;
+
+    /// <summary>
+    /// Minimum time between two aircraft states passed to the callback in ns, 0 for no limit.
+    /// </summary>
+    std::atomic<long long> telemetryMinimumInterval{ 0 };
+
+    /// <summary>
+    /// Time at which the next aircraft state is due if the rate is limited. Only used by the message loop.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextTelemetryUpdate;
+
+    /// <summary>
+    /// True if the adaptive telemetry is active.
+    /// </summary>
+    std::atomic_bool isTelemetryAdaptive{ false };
+
+    /// <summary>
+    /// Set when the telemetry configuration changed, so the adaptive telemetry starts with the next state.
+    /// </summary>
+    std::atomic_bool telemetryResetRequested{ false };
+
+    /// <summary>
+    /// Decides which aircraft states are sent in adaptive mode. Only used by the message loop.
+    /// </summary>
+    TelemetryController telemetryController;
+
+    /// <summary>
+    /// Last aircraft state reported by the simulation, sent again as keep alive. Only used by the message loop.
+    /// </summary>
+    AircraftStateStruct lastAircraftState{};
+
+    /// <summary>
+    /// False until the first aircraft state was reported. Only used by the message loop.
+    /// </summary>
+    bool hasAircraftState = false;
+
+    /// <summary>
+    /// Number of aircraft states which were passed to the callback.
+    /// </summary>
+    std::atomic<unsigned long long> aircraftStates{ 0 };
+
+    /// <summary>
+    /// Number of aircraft states which were dropped by the rate limit.
+    /// </summary>
+    std::atomic<unsigned long long> skippedAircraftStates{ 0 };
+
+    /// <summary>
+    /// Number of waits which ended because of an event or a wake up.
+    /// </summary>
+    std::atomic<unsigned long long> dispatchWakeUps{ 0 };
+
+    /// <summary>
+    /// Number of waits which ended by the timeout.
+    /// </summary>
+    std::atomic<unsigned long long> dispatchTimeouts{ 0 };
+
+    /// <summary>
+    /// Number of handled events.
+    /// </summary>
+    std::atomic<unsigned long long> dispatchedEvents{ 0 };
+
+    /// <summary>
+    /// Sum of the dispatch latencies of all handled events in microseconds.
+    /// </summary>
+    std::atomic<unsigned long long> dispatchLatencySum{ 0 };
+
+    /// <summary>
+    /// Maximum dispatch latency in microseconds.
+    /// </summary>
+    std::atomic<unsigned long long> dispatchLatencyMax{ 0 };
+
     /// <summary>
     /// Returns true if the simulation is active.
     /// </summary>
@@ -158,105 +580,214 @@ private:
 
 
     /// <summary>
-    /// Initializes the mapping indicator type id -> model name
+    /// Gets the current snapshot of the indicator type mapping.
     /// </summary>
-    void initIndicatorTypeMapping();
+    /// <returns>Mapping: indicator type id -> model name or nullptr if it could not be loaded</returns>
+    std::shared_ptr<const IndicatorTypeTable> getIndicatorTypeTable();
 
     /// <summary>
-    /// Gets the indicator type mapping and initializes it if necessary.
+    /// Executes the given parsed command. Only called by the message loop.
     /// </summary>
-    /// <returns>Mapping: indicator type id -> model name</returns>
-    const std::unordered_map<ulong, std::string>& getIndicatorTypeMapping();
-    
+    /// <param name="command">Parsed command</param>
+    void executeCommand(const ParsedCommand& command);
+
     /// <summary>
-    /// Returns the model name for the give indicator type id or an empty string if the indicator type id is not mapped.
+    /// Executes the commands which were passed by handleCommand and a requested removal of all indicators.
     /// </summary>
-    /// <param name="indicatorTypeID">Requested indicator type id</param>
-    /// <returns>Model name or empty string</returns>
-    std::string getIndicatorTypeName(ulong indicatorTypeID);
+    void executeQueuedCommands();
 
     /// <summary>
-    /// Sets the mapping request id -> external indicator id
+    /// Discards the waiting commands while the simulation is not connected, so the command executor does not block.
     /// </summary>
-    /// <param name="requestID">The request id which is used for the SimConnect request</param>
-    /// <param name="indicatorID">The external indicator id</param>
-    void setRequestToIndicator(uint requestID, ushort indicatorID);
+    void discardQueuedCommands();
 
     /// <summary>
-    /// Sets the mapping indicator id -> SimObject id. The indicator id is determined by the used SimConnect request id.
+    /// Removes all placed indicators. Only called by the message loop.
+    /// </summary>
+    void removePlacedIndicators();
+
+    /// <summary>
+    /// Copies the counters of the subsystems which are owned by the message loop into the statistics snapshots.
+    /// </summary>
+    void publishStatistics();
+
+    /// <summary>
+    /// Assigns the SimObject which was created by the given request to its indicator. If the indicator was replaced or removed
+    /// in the meantime, the SimObject is removed again.
     /// </summary>
     /// <param name="requestID">The SimConnect request id which was used to create the SimObject</param>
     /// <param name="simObjectID">The SimObject id which was created</param>
-    void setIndicatorToSimObject(uint requestID, uint simObjectID);
-    
+    void assignSimObject(uint requestID, uint simObjectID);
+
+    /// <summary>
+    /// Places the indicator of the given SET command. If it already exists with the same model, its SimObject is moved or the command
+    /// is skipped if the position did not change, otherwise the SimObject is replaced. With virtualization only indicators near the
+    /// aircraft get a SimObject.
+    /// </summary>
+    /// <param name="setCommand">Parsed SET command of the indicator</param>
+    /// <param name="typeTable">Snapshot of the indicator type mapping, may be nullptr</param>
+    void placeIndicator(const SetIndicatorCommand& setCommand, const IndicatorTypeTable* typeTable);
+
+    /// <summary>
+    /// Sets the level of detail group of a placed indicator and keeps lodIndicators up to date.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="group">Level of detail group or nullptr</param>
+    /// <param name="level">Index of the current level in the group</param>
+    void setLodGroup(ushort id, std::shared_ptr<const IndicatorLodGroup> group, uint level);
+
+    /// <summary>
+    /// Swaps the models of the resident indicators whose distance to the aircraft crossed a level boundary, at most
+    /// INDICATOR_LOD_SWAP_BUDGET per update and the nearest first. The update runs at most every INDICATOR_LOD_INTERVAL.
+    /// </summary>
+    /// <param name="latitude">Latitude of the aircraft in degrees</param>
+    /// <param name="longitude">Longitude of the aircraft in degrees</param>
+    /// <param name="time">Time of the aircraft state</param>
+    void updateLevelsOfDetail(double latitude, double longitude, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Places the indicators along the path of the given PATH command with consecutive ids. Indicators of a previous, longer path
+    /// with the following ids are kept.
+    /// </summary>
+    /// <param name="pathCommand">Parsed PATH command</param>
+    /// <param name="typeTable">Snapshot of the indicator type mapping, may be nullptr</param>
+    void placePath(const PathCommand& pathCommand, const IndicatorTypeTable* typeTable);
+
+    /// <summary>
+    /// Anchors the indicator of the given ANCHOR command to the aircraft. It is placed with the next aircraft state.
+    /// </summary>
+    /// <param name="anchorCommand">Parsed ANCHOR command</param>
+    /// <param name="typeTable">Snapshot of the indicator type mapping, may be nullptr</param>
+    void anchorIndicator(const AnchorIndicatorCommand& anchorCommand, const IndicatorTypeTable* typeTable);
+
+    /// <summary>
+    /// Stops moving the indicators with the given ids along with the aircraft, because they are placed or removed by a command.
+    /// </summary>
+    /// <param name="firstID">First external indicator id</param>
+    /// <param name="count">Number of consecutive ids</param>
+    void detachAnchors(ushort firstID, size_t count);
+
+    /// <summary>
+    /// Stops moving the indicators with the given ids along with the aircraft.
+    /// </summary>
+    /// <param name="ids">List with external indicator ids</param>
+    void detachAnchors(std::span<const ushort> ids);
+
+    /// <summary>
+    /// Places all anchored indicators relative to the given aircraft state.
+    /// </summary>
+    /// <param name="aircraftState">Position and orientation of the aircraft</param>
+    void resolveAnchors(const AircraftStateStruct& aircraftState);
+
+    /// <summary>
+    /// Tests the motion of the aircraft since the previous state against the nearby rings and passes the passages to the callback.
+    /// </summary>
+    /// <param name="aircraftState">Position of the aircraft</param>
+    /// <param name="time">Time of the aircraft state</param>
+    void detectGatePassages(const AircraftStateStruct& aircraftState, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Creates the SimObject of a placed indicator or takes one from the pool.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    void materializeIndicator(ushort id);
+
     /// <summary>
-    /// Retuns the SimObject id for the external indicator id or 0 if the external id is unknown.
+    /// Moves the SimObject of a resident indicator to its placement, or as soon as it is created.
     /// </summary>
-    /// <param name="indicatorID">The external indicator id</param>
-    /// <returns>SimObject id</returns>
-    uint getSimObjectByIndicator(ushort indicatorID);
+    /// <param name="id">External indicator id</param>
+    void moveIndicator(ushort id);
 
     /// <summary>
-    /// Returns the list of all known external indicator ids.
+    /// Removes the SimObject of an indicator but keeps its placement.
     /// </summary>
-    /// <returns>List with external indicator ids</returns>
-    std::vector<ushort> getAllExistingIndicators();
+    /// <param name="id">External indicator id</param>
+    void retireIndicator(ushort id);
+
+    /// <summary>
+    /// Materializes the indicators near the aircraft and retires the distant ones, at most every INDICATOR_VIRTUALIZATION_INTERVAL.
+    /// </summary>
+    /// <param name="latitude">Latitude of the aircraft in degrees</param>
+    /// <param name="longitude">Longitude of the aircraft in degrees</param>
+    /// <param name="time">Time of the aircraft state</param>
+    void updateVirtualization(double latitude, double longitude, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Returns the SimObject of an indicator to the pool of its model and parks it, or removes it if the pool is full.
+    /// </summary>
+    /// <param name="modelName">Model of the SimObject</param>
+    /// <param name="simObjectID">Id of the SimObject</param>
+    void releaseSimObject(const char* modelName, uint simObjectID);
+
+    /// <summary>
+    /// Requests the SimObjects which are missing in the pools and removes the surplus ones. The creations take the tokens which are
+    /// left by the waiting operations.
+    /// </summary>
+    void refillIndicatorPools();
+
+    /// <summary>
+    /// Creates the SimObject of a pending indicator or queues the creation if the operations are paced.
+    /// </summary>
+    /// <param name="id">External indicator id</param>
+    /// <param name="requestID">Request id of the create request</param>
+    void createSimObject(ushort id, uint requestID);
+
+    /// <summary>
+    /// Removes a SimObject or queues the removal if the operations are paced.
+    /// </summary>
+    /// <param name="simObjectID">Id of the SimObject</param>
+    void removeSimObject(uint simObjectID);
+
+    /// <summary>
+    /// Executes the waiting creations and removals for which the token bucket has tokens.
+    /// </summary>
+    void dispatchObjectOperations();
 
     /// <summary>
     /// Removes the indicators for the given list of external indicator ids.
     /// </summary>
     /// <param name="indicatorsToRemove">List with external indicator ids to remove</param>
-    void removeIndicators(std::vector<ushort> indicatorsToRemove);
+    void removeIndicators(std::span<const ushort> indicatorsToRemove);
     
+
     /// <summary>
-    /// Removes the mapping external indicator id -> SimObject id for the given external indicator id.
+    /// Opens the connection to the simulation. If the simulation is not available the method tries again.
+    /// The method returns when the connection was established or the proxy is stopped.
     /// </summary>
-    /// <param name="indicatorID">External indicator id to be removed</param>
-    void removeIndicatorMapping(ushort indicatorID);
-
+    /// <returns>False if the proxy was stopped before the connection was established</returns>
+    bool connectCore();
 
     /// <summary>
-    /// Opens the connection to SimConnect. If SimConnect is not available the method tries again.
-    /// The method returns when the connection was established.
+    /// Returns true if the aircraft state reported at the given time has to be passed to the callback according to the rate limit.
     /// </summary>
-    void connectCore();
+    /// <param name="readyTime">Time at which the aircraft state was reported</param>
+    /// <returns>False if the aircraft state is dropped</returns>
+    bool isTelemetryUpdateDue(std::chrono::steady_clock::time_point readyTime);
 
     /// <summary>
-    /// Connects to SimConnect and handles the SimConnect message queue.
+    /// Handles an aircraft state reported by the simulation and passes it to the callback if the rate limit and the adaptive telemetry allow it.
     /// </summary>
-    void runSimConnectMessageLoop();
+    /// <param name="event">The aircraft state event</param>
+    void handleAircraftState(const SimEvent& event);
 
     /// <summary>
-    /// Subscribes to SimConnect system events and updated aircraft information.
+    /// Sends the last aircraft state again if the adaptive telemetry did not send a state within the keep alive interval.
     /// </summary>
-    void subscribeToEvents();
+    void sendTelemetryKeepAlive();
 
     /// <summary>
-    /// Core method to handle the SimConnect message.
+    /// Handles all available events of the simulation.
     /// </summary>
-    /// <param name="pData">Pointer to the data buffer</param>
-    void handleSimConnectMessageCore(SIMCONNECT_RECV* pData);
-};
+    void drainEvents();
 
-/// <summary>
-/// Well-known event ids which occur while communicating with the SimConnect-API.
-/// </summary>
-enum EventIDs : uint {
-    SIM_START = 1,
-    SIM_STOP = 2,
-};
-
-/// <summary>
-/// Well-known request ids which are used to poll status updates from the SimConnect-API.
-/// </summary>
-enum ReservedRequestIDs : uint {
-    SIM_STATE = 100,
-    AIRCRAFT_STATE = 200,
-};
+    /// <summary>
+    /// Connects to the simulation and handles its events.
+    /// </summary>
+    void runSimConnectMessageLoop();
 
-/// <summary>
-/// Well-known data definition ids to exchange data with die SimConnect-API.
-/// </summary>
-enum DATA_DEFINE_ID {
-    AIRCRAFT_STATE_DEFINITION,
+    /// <summary>
+    /// Core method to handle an event of the simulation.
+    /// </summary>
+    /// <param name="event">The event</param>
+    void handleSimEvent(const SimEvent& event);
 };
\ No newline at end of file
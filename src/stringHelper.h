@@ -41,4 +41,16 @@ inline std::vector<std::string> splitString(const std::string& s, char delimiter
     }
 
     return tokens;
+}
+
+/// <summary>
+/// Formats an IPv4 address and port as a.b.c.d:port.
+/// </summary>
+/// <param name="address">IPv4 address in host byte order</param>
+/// <param name="port">Port in host byte order</param>
+/// <returns>The formatted address</returns>
+inline std::string formatIPv4Address(unsigned int address, unsigned short port)
+{
+    return std::to_string(address >> 24) + "." + std::to_string((address >> 16) & 0xFF) + "." +
+        std::to_string((address >> 8) & 0xFF) + "." + std::to_string(address & 0xFF) + ":" + std::to_string(port);
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "telemetry.h"
+
+#include <charconv>
+
+/// Highest supported rate of aircraft state updates in Hz
+#define TELEMETRY_MAX_RATE 1000.0
+
+/// Prefix of the adaptive telemetry configurations
+#define TELEMETRY_ADAPTIVE_PREFIX "adaptive:"
+
+bool parseTelemetryConfiguration(const std::string& specification, TelemetryConfiguration* configuration)
+{
+    TelemetryConfiguration parsed;
+    std::string period = specification;
+
+    if (period.starts_with(TELEMETRY_ADAPTIVE_PREFIX))
+    {
+        parsed.adaptive = true;
+        period = period.substr(sizeof(TELEMETRY_ADAPTIVE_PREFIX) - 1);
+    }
+
+    std::string periodName = period;
+    size_t separator = period.find(':');
+
+    if (separator != std::string::npos)
+    {
+        periodName = period.substr(0, separator);
+        const char* first = period.data() + separator + 1;
+        const char* last = period.data() + period.size();
+
+        std::from_chars_result res = std::from_chars(first, last, parsed.periodCount);
+        if (res.ec != std::errc() || res.ptr != last || parsed.periodCount == 0)
+        {
+            return false;
+        }
+    }
+
+    if (periodName == "second")
+    {
+        parsed.period = TELEMETRY_PERIOD_SECOND;
+    }
+    else if (periodName == "sim-frame")
+    {
+        parsed.period = TELEMETRY_PERIOD_SIM_FRAME;
+    }
+    else if (periodName == "visual-frame")
+    {
+        parsed.period = TELEMETRY_PERIOD_VISUAL_FRAME;
+    }
+    else if (separator == std::string::npos && periodName.size() > 2 && periodName.ends_with("hz"))
+    {
+        const char* first = periodName.data();
+        const char* last = periodName.data() + periodName.size() - 2;
+
+        std::from_chars_result res = std::from_chars(first, last, parsed.rate);
+        if (res.ec != std::errc() || res.ptr != last || !(parsed.rate > 0) || parsed.rate > TELEMETRY_MAX_RATE)
+        {
+            return false;
+        }
+        parsed.period = TELEMETRY_PERIOD_SIM_FRAME;
+    }
+    else
+    {
+        return false;
+    }
+
+    *configuration = parsed;
+    return true;
+}
+
+std::string toString(const TelemetryConfiguration& configuration)
+{
+    std::string name = configuration.adaptive ? TELEMETRY_ADAPTIVE_PREFIX : "";
+
+    if (configuration.rate > 0)
+    {
+        char buffer[32];
+        std::to_chars_result res = std::to_chars(buffer, buffer + sizeof(buffer), configuration.rate);
+        return name + std::string(buffer, res.ptr) + "hz";
+    }
+
+    switch (configuration.period)
+    {
+    case TELEMETRY_PERIOD_SECOND: name += "second"; break;
+    case TELEMETRY_PERIOD_SIM_FRAME: name += "sim-frame"; break;
+    case TELEMETRY_PERIOD_VISUAL_FRAME: name += "visual-frame"; break;
+    }
+
+    if (configuration.periodCount > 1)
+    {
+        name += ":" + std::to_string(configuration.periodCount);
+    }
+    return name;
+}
\ No newline at end of file
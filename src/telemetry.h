@@ -0,0 +1,76 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include <string>
+
+/// <summary>
+/// Period in which the simulation reports the aircraft state.
+/// </summary>
+enum TelemetryPeriod {
+    TELEMETRY_PERIOD_SECOND,       // once per second
+    TELEMETRY_PERIOD_SIM_FRAME,    // every simulation frame
+    TELEMETRY_PERIOD_VISUAL_FRAME, // every rendered frame
+};
+
+/// <summary>
+/// Configuration of the aircraft state updates which are sent to the target.
+/// </summary>
+struct TelemetryConfiguration {
+    /// <summary>
+    /// Period in which the simulation reports the aircraft state
+    /// </summary>
+    TelemetryPeriod period = TELEMETRY_PERIOD_SECOND;
+
+    /// <summary>
+    /// Number of periods between two updates, 1 for every period
+    /// </summary>
+    uint periodCount = 1;
+
+    /// <summary>
+    /// Maximum number of updates per second, 0 for no limit
+    /// </summary>
+    double rate = 0;
+
+    /// <summary>
+    /// True if only changed states are reported and states within the dead-bands are suppressed, see TelemetryController
+    /// </summary>
+    bool adaptive = false;
+};
+
+/// <summary>
+/// Parses a telemetry configuration. Supported formats:
+///   second              once per second
+///   sim-frame[:n]       every (n-th) simulation frame
+///   visual-frame[:n]    every (n-th) rendered frame
+///   &lt;rate&gt;hz           simulation frames limited to the given rate, e.g. 30hz
+/// Each format can be prefixed with "adaptive:" to suppress states which do not differ noticeably, e.g. adaptive:sim-frame.
+/// </summary>
+/// <param name="specification">Text to parse</param>
+/// <param name="configuration">Receives the parsed configuration</param>
+/// <returns>False if the text is invalid</returns>
+bool parseTelemetryConfiguration(const std::string& specification, TelemetryConfiguration* configuration);
+
+/// <summary>
+/// Returns the text representation of the configuration in the format of parseTelemetryConfiguration.
+/// </summary>
+/// <param name="configuration">The configuration</param>
+/// <returns>Text representation</returns>
+std::string toString(const TelemetryConfiguration& configuration);
\ No newline at end of file
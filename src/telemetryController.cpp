@@ -0,0 +1,133 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "telemetryController.h"
+
+#include <cmath>
+
+/// Mean earth radius in m
+#define EARTH_RADIUS 6371000.0
+
+/// Length of a nautical mile in m
+#define NAUTICAL_MILE 1852.0
+
+/// Conversion factor degrees -> radians
+#define DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+
+/// <summary>
+/// Returns the difference a - b of two angles in degrees in the range [-180, 180), considering the wrap around at 360 degrees.
+/// </summary>
+static double getSignedAngleDifference(double a, double b)
+{
+    double difference = std::fmod(a - b + 180.0, 360.0);
+    return (difference < 0 ? difference + 360.0 : difference) - 180.0;
+}
+
+/// <summary>
+/// Returns the absolute difference of two angles in degrees, considering the wrap around at 360 degrees.
+/// </summary>
+static double getAngleDifference(double a, double b)
+{
+    return std::fabs(getSignedAngleDifference(a, b));
+}
+
+TelemetryController::TelemetryController(const TelemetryDeadBands& deadBands)
+    : deadBands(deadBands)
+{
+}
+
+bool TelemetryController::shouldSend(const AircraftStateStruct& state, std::chrono::steady_clock::time_point time)
+{
+    if (!hasSentState)
+    {
+        sentStates.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (time - lastSentTime >= std::chrono::milliseconds(deadBands.keepAliveInterval))
+    {
+        keepAliveStates.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (!isPaused && exceedsDeadBands(state, std::chrono::duration<double>(time - lastSentTime).count()))
+    {
+        sentStates.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        suppressedStates.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    lastSentState = state;
+    lastSentTime = time;
+    hasSentState = true;
+    return true;
+}
+
+bool TelemetryController::isKeepAliveDue(std::chrono::steady_clock::time_point time)
+{
+    if (!hasSentState || time - lastSentTime < std::chrono::milliseconds(deadBands.keepAliveInterval))
+    {
+        return false;
+    }
+
+    keepAliveStates.fetch_add(1, std::memory_order_relaxed);
+    lastSentTime = time;
+    return true;
+}
+
+void TelemetryController::setPaused(bool paused)
+{
+    isPaused = paused;
+}
+
+void TelemetryController::reset()
+{
+    hasSentState = false;
+}
+
+TelemetryControllerStatistics TelemetryController::getStatistics() const
+{
+    TelemetryControllerStatistics statistics;
+    statistics.sent = sentStates.load(std::memory_order_relaxed);
+    statistics.suppressed = suppressedStates.load(std::memory_order_relaxed);
+    statistics.keepAlive = keepAliveStates.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+bool TelemetryController::exceedsDeadBands(const AircraftStateStruct& state, double elapsedSeconds) const
+{
+    if (std::fabs(state.altitude - lastSentState.altitude) > deadBands.altitude ||
+        std::fabs(state.speed - lastSentState.speed) > deadBands.speed ||
+        getAngleDifference(state.heading, lastSentState.heading) > deadBands.attitude ||
+        getAngleDifference(state.bank, lastSentState.bank) > deadBands.attitude ||
+        getAngleDifference(state.pitch, lastSentState.pitch) > deadBands.attitude)
+    {
+        return true;
+    }
+
+    // dead reckoning: the last position moved along the heading with the ground speed, flat earth is accurate enough for short distances
+    double distance = lastSentState.speed * NAUTICAL_MILE / 3600.0 * elapsedSeconds;
+    double heading = lastSentState.heading * DEGREES_TO_RADIANS;
+    double latitudeScale = std::cos(lastSentState.latitude * DEGREES_TO_RADIANS);
+
+    double expectedNorth = distance * std::cos(heading);
+    double expectedEast = distance * std::sin(heading);
+    double actualNorth = (state.latitude - lastSentState.latitude) * DEGREES_TO_RADIANS * EARTH_RADIUS;
+    double actualEast = getSignedAngleDifference(state.longitude, lastSentState.longitude) * DEGREES_TO_RADIANS * EARTH_RADIUS * latitudeScale;
+
+    return std::hypot(actualNorth - expectedNorth, actualEast - expectedEast) > deadBands.position;
+}
\ No newline at end of file
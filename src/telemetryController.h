@@ -0,0 +1,160 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "aircraftState.h"
+
+#include <chrono>
+#include <atomic>
+
+/// <summary>
+/// Thresholds of the adaptive telemetry. An aircraft state is sent if one of them is exceeded.
+/// </summary>
+struct TelemetryDeadBands {
+    /// <summary>
+    /// Maximum distance between the position extrapolated from the last sent state and the actual position in m
+    /// </summary>
+    double position = 5;
+
+    /// <summary>
+    /// Maximum altitude change in ft
+    /// </summary>
+    double altitude = 10;
+
+    /// <summary>
+    /// Maximum change of heading, bank and pitch in degrees
+    /// </summary>
+    double attitude = 1;
+
+    /// <summary>
+    /// Maximum change of the ground speed in kts
+    /// </summary>
+    double speed = 2;
+
+    /// <summary>
+    /// Maximum time without a sent state in ms
+    /// </summary>
+    uint keepAliveInterval = 1000;
+};
+
+/// <summary>
+/// Snapshot of the counters of the adaptive telemetry.
+/// </summary>
+struct TelemetryControllerStatistics {
+    unsigned long long sent;       // states which exceeded a dead-band
+    unsigned long long suppressed; // states within all dead-bands
+    unsigned long long keepAlive;  // states which were sent because of the keep alive interval
+};
+
+/// <summary>
+/// Decides which aircraft states are sent in adaptive telemetry mode.
+///
+/// The receiver is expected to extrapolate the position of the last state along the heading with the ground speed. A new state is
+/// only sent if this extrapolation is off by more than the position dead-band, or altitude, attitude or speed changed by more than
+/// their dead-bands. Straight flight and a parked aircraft therefore produce few packets and manoeuvres produce many. While the
+/// simulation is paused only keep alive states are sent.
+/// Only the counters may be read by other threads, all other methods are called by the thread which handles the simulation events.
+/// </summary>
+class TelemetryController {
+public:
+    /// <summary>
+    /// Creates a controller with the given thresholds.
+    /// </summary>
+    /// <param name="deadBands">Thresholds for sending a state</param>
+    explicit TelemetryController(const TelemetryDeadBands& deadBands = TelemetryDeadBands());
+
+    /// <summary>
+    /// Decides if the given aircraft state has to be sent and remembers it as last sent state if so.
+    /// </summary>
+    /// <param name="state">Current aircraft state</param>
+    /// <param name="time">Time of the state</param>
+    /// <returns>True if the state has to be sent</returns>
+    bool shouldSend(const AircraftStateStruct& state, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Returns true if no state was sent within the keep alive interval. Used if the simulation does not report unchanged states.
+    /// </summary>
+    /// <param name="time">Current time</param>
+    /// <returns>True if the last state has to be sent again</returns>
+    bool isKeepAliveDue(std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Sets the pause state of the simulation.
+    /// </summary>
+    /// <param name="paused">True if the simulation is paused</param>
+    void setPaused(bool paused);
+
+    /// <summary>
+    /// Forgets the last sent state, so the next state is sent.
+    /// </summary>
+    void reset();
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <returns>Statistics of the controller</returns>
+    TelemetryControllerStatistics getStatistics() const;
+
+private:
+    /// <summary>
+    /// Thresholds for sending a state.
+    /// </summary>
+    TelemetryDeadBands deadBands;
+
+    /// <summary>
+    /// Last sent state.
+    /// </summary>
+    AircraftStateStruct lastSentState{};
+
+    /// <summary>
+    /// Time of the last sent state.
+    /// </summary>
+    std::chrono::steady_clock::time_point lastSentTime;
+
+    /// <summary>
+    /// False until the first state was sent.
+    /// </summary>
+    bool hasSentState = false;
+
+    /// <summary>
+    /// True if the simulation is paused.
+    /// </summary>
+    bool isPaused = false;
+
+    /// <summary>
+    /// Number of states which exceeded a dead-band.
+    /// </summary>
+    std::atomic<unsigned long long> sentStates{ 0 };
+
+    /// <summary>
+    /// Number of states within all dead-bands.
+    /// </summary>
+    std::atomic<unsigned long long> suppressedStates{ 0 };
+
+    /// <summary>
+    /// Number of states sent because of the keep alive interval.
+    /// </summary>
+    std::atomic<unsigned long long> keepAliveStates{ 0 };
+
+    /// <summary>
+    /// Returns true if the state differs from the extrapolated last sent state by more than one of the dead-bands.
+    /// </summary>
+    bool exceedsDeadBands(const AircraftStateStruct& state, double elapsedSeconds) const;
+};
\ No newline at end of file
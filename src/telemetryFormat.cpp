@@ -0,0 +1,299 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "telemetryFormat.h"
+#include "numberUtils.h"
+#include "byteOrder.h"
+
+#include <cmath>
+
+/// Version 2 keyframes: latitude and longitude in 1e-7 degrees (about 1 cm)
+#define KEYFRAME_COORDINATE_SCALE 1e7
+
+/// Version 2 delta frames: latitude and longitude in 1e-6 degrees (about 11 cm, up to about 3.6 km from the keyframe)
+#define DELTA_COORDINATE_SCALE 1e6
+
+/// Version 2 delta frames: altitude in 0.1 ft
+#define DELTA_ALTITUDE_SCALE 10.0
+
+/// Version 2 delta frames: heading, bank and pitch in 0.01 degrees
+#define DELTA_ANGLE_SCALE 100.0
+
+/// Version 2 delta frames: speed in 0.01 kts
+#define DELTA_SPEED_SCALE 100.0
+
+/// <summary>
+/// Returns the difference a - b of two angles in degrees in the range [-180, 180).
+/// </summary>
+static double getWrappedDifference(double a, double b)
+{
+    double difference = std::fmod(a - b + 180.0, 360.0);
+    return (difference < 0 ? difference + 360.0 : difference) - 180.0;
+}
+
+/// <summary>
+/// Moves an angle into the range [min, min + 360).
+/// </summary>
+static double normalizeAngle(double angle, double min)
+{
+    if (angle < min)
+    {
+        return angle + 360.0;
+    }
+    if (angle >= min + 360.0)
+    {
+        return angle - 360.0;
+    }
+    return angle;
+}
+
+/// <summary>
+/// Scales and rounds a difference to a 16 bit delta.
+/// </summary>
+/// <returns>False if the delta does not fit into 16 bit</returns>
+static bool toDelta(double difference, double scale, ushort* delta)
+{
+    double scaled = std::round(difference * scale);
+    if (!(scaled >= -32768.0 && scaled <= 32767.0))
+    {
+        return false;
+    }
+
+    *delta = static_cast<ushort>(static_cast<short>(scaled));
+    return true;
+}
+
+/// <summary>
+/// Reads a keyframe body, the values are exactly those which the encoder uses as reference for the deltas.
+/// </summary>
+static void readKeyframe(const char* body, AircraftStateStruct& state)
+{
+    state.latitude = static_cast<int>(readUintNetworkByteOrder(body)) / KEYFRAME_COORDINATE_SCALE;
+    state.longitude = static_cast<int>(readUintNetworkByteOrder(body + 4)) / KEYFRAME_COORDINATE_SCALE;
+    state.altitude = readFloatNetworkByteOrder(body + 8);
+    state.heading = readFloatNetworkByteOrder(body + 12);
+    state.bank = readFloatNetworkByteOrder(body + 16);
+    state.pitch = readFloatNetworkByteOrder(body + 20);
+    state.speed = readFloatNetworkByteOrder(body + 24);
+}
+
+bool parseTelemetryFormat(const std::string& name, TelemetryFormat* format)
+{
+    if (name == "v1")
+    {
+        *format = TELEMETRY_FORMAT_V1;
+    }
+    else if (name == "v2")
+    {
+        *format = TELEMETRY_FORMAT_V2;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+const char* getTelemetryFormatName(TelemetryFormat format)
+{
+    return format == TELEMETRY_FORMAT_V2 ? "v2" : "v1";
+}
+
+uint encodeGateEvent(const GateEvent& event, uint sequence, char* buffer)
+{
+    buffer[0] = static_cast<char>(TELEMETRY_FORMAT_V2);
+    buffer[1] = static_cast<char>(event.type == GATE_PASSED ? TELEMETRY_FRAME_GATE_PASSED : TELEMETRY_FRAME_GATE_MISSED);
+    writeUintInNetworkByteOrder(sequence, buffer + 2);
+    writeUint64InNetworkByteOrder(event.timestamp, buffer + 6);
+
+    char* body = buffer + TELEMETRY_V2_HEADER_LENGTH;
+    writeUshortInNetworkByteOrder(event.id, body);
+    writeFloatInNetworkByteOrder(static_cast<float>(event.missDistance), body + 2);
+    return TELEMETRY_V2_GATE_EVENT_LENGTH;
+}
+
+bool decodeGateEvent(const char* data, uint length, GateEvent& event, uint* sequence)
+{
+    if (length != TELEMETRY_V2_GATE_EVENT_LENGTH || data[0] != static_cast<char>(TELEMETRY_FORMAT_V2) ||
+        (data[1] != TELEMETRY_FRAME_GATE_PASSED && data[1] != TELEMETRY_FRAME_GATE_MISSED))
+    {
+        return false;
+    }
+
+    const char* body = data + TELEMETRY_V2_HEADER_LENGTH;
+    event.type = data[1] == TELEMETRY_FRAME_GATE_PASSED ? GATE_PASSED : GATE_MISSED;
+    event.timestamp = readUint64NetworkByteOrder(data + 6);
+    event.id = readUShortNetworkByteOrder(body);
+    event.missDistance = readFloatNetworkByteOrder(body + 2);
+    *sequence = readUintNetworkByteOrder(data + 2);
+    return true;
+}
+
+ ///////////////
+ /// ENCODER ///
+ ///////////////
+TelemetryEncoder::TelemetryEncoder(TelemetryFormat format)
+    : format(format)
+{
+}
+
+uint TelemetryEncoder::encode(const AircraftStateStruct& state, uint64_t timestamp, char* buffer)
+{
+    if (format == TELEMETRY_FORMAT_V1)
+    {
+        double values[7] = { state.latitude, state.longitude, state.altitude, state.heading, state.bank, state.pitch, state.speed };
+        writeDoublesInNetworkByteOrder(values, buffer, 7);
+        return TELEMETRY_V1_MESSAGE_LENGTH;
+    }
+
+    if (hasKeyframe && deltaFrames < TELEMETRY_KEYFRAME_INTERVAL && encodeDelta(state, timestamp, buffer))
+    {
+        deltaFrames++;
+        sequence++;
+        return TELEMETRY_V2_DELTA_LENGTH;
+    }
+
+    writeHeader(TELEMETRY_FRAME_KEY, timestamp, buffer);
+
+    char* body = buffer + TELEMETRY_V2_HEADER_LENGTH;
+    writeUintInNetworkByteOrder(static_cast<uint>(static_cast<int>(std::lround(state.latitude * KEYFRAME_COORDINATE_SCALE))), body);
+    writeUintInNetworkByteOrder(static_cast<uint>(static_cast<int>(std::lround(state.longitude * KEYFRAME_COORDINATE_SCALE))), body + 4);
+    writeFloatInNetworkByteOrder(static_cast<float>(state.altitude), body + 8);
+    writeFloatInNetworkByteOrder(static_cast<float>(state.heading), body + 12);
+    writeFloatInNetworkByteOrder(static_cast<float>(state.bank), body + 16);
+    writeFloatInNetworkByteOrder(static_cast<float>(state.pitch), body + 20);
+    writeFloatInNetworkByteOrder(static_cast<float>(state.speed), body + 24);
+
+    // the deltas refer to the quantized values, so the error does not add up
+    readKeyframe(body, keyframe);
+    keyframeSequence = sequence;
+    hasKeyframe = true;
+    deltaFrames = 0;
+    sequence++;
+    return TELEMETRY_V2_KEYFRAME_LENGTH;
+}
+
+void TelemetryEncoder::setFormat(TelemetryFormat format)
+{
+    this->format = format;
+    hasKeyframe = false;
+}
+
+TelemetryFormat TelemetryEncoder::getFormat() const
+{
+    return format;
+}
+
+void TelemetryEncoder::writeHeader(TelemetryFrameType type, uint64_t timestamp, char* buffer)
+{
+    buffer[0] = static_cast<char>(TELEMETRY_FORMAT_V2);
+    buffer[1] = static_cast<char>(type);
+    writeUintInNetworkByteOrder(sequence, buffer + 2);
+    writeUint64InNetworkByteOrder(timestamp, buffer + 6);
+}
+
+bool TelemetryEncoder::encodeDelta(const AircraftStateStruct& state, uint64_t timestamp, char* buffer)
+{
+    ushort deltas[8];
+    deltas[0] = static_cast<ushort>(keyframeSequence);
+
+    if (!toDelta(state.latitude - keyframe.latitude, DELTA_COORDINATE_SCALE, &deltas[1]) ||
+        !toDelta(getWrappedDifference(state.longitude, keyframe.longitude), DELTA_COORDINATE_SCALE, &deltas[2]) ||
+        !toDelta(state.altitude - keyframe.altitude, DELTA_ALTITUDE_SCALE, &deltas[3]) ||
+        !toDelta(getWrappedDifference(state.heading, keyframe.heading), DELTA_ANGLE_SCALE, &deltas[4]) ||
+        !toDelta(state.bank - keyframe.bank, DELTA_ANGLE_SCALE, &deltas[5]) ||
+        !toDelta(state.pitch - keyframe.pitch, DELTA_ANGLE_SCALE, &deltas[6]) ||
+        !toDelta(state.speed - keyframe.speed, DELTA_SPEED_SCALE, &deltas[7]))
+    {
+        return false;
+    }
+
+    writeHeader(TELEMETRY_FRAME_DELTA, timestamp, buffer);
+    writeUShortsInNetworkByteOrder(deltas, buffer + TELEMETRY_V2_HEADER_LENGTH, 8);
+    return true;
+}
+
+ ///////////////
+ /// DECODER ///
+ ///////////////
+bool TelemetryDecoder::decode(const char* data, uint length, TelemetryFrame& frame)
+{
+    if (length == TELEMETRY_V1_MESSAGE_LENGTH)
+    {
+        double values[7];
+        readDoublesInNetworkByteOrder(data, values, 7);
+
+        frame.format = TELEMETRY_FORMAT_V1;
+        frame.type = TELEMETRY_FRAME_KEY;
+        frame.sequence = 0;
+        frame.timestamp = 0;
+        frame.state.latitude = values[0];
+        frame.state.longitude = values[1];
+        frame.state.altitude = values[2];
+        frame.state.heading = values[3];
+        frame.state.bank = values[4];
+        frame.state.pitch = values[5];
+        frame.state.speed = values[6];
+        return true;
+    }
+
+    if (length < TELEMETRY_V2_HEADER_LENGTH || data[0] != static_cast<char>(TELEMETRY_FORMAT_V2))
+    {
+        return false;
+    }
+
+    frame.format = TELEMETRY_FORMAT_V2;
+    frame.sequence = readUintNetworkByteOrder(data + 2);
+    frame.timestamp = readUint64NetworkByteOrder(data + 6);
+    const char* body = data + TELEMETRY_V2_HEADER_LENGTH;
+
+    if (data[1] == TELEMETRY_FRAME_KEY && length == TELEMETRY_V2_KEYFRAME_LENGTH)
+    {
+        frame.type = TELEMETRY_FRAME_KEY;
+        readKeyframe(body, keyframe);
+        keyframeSequence = frame.sequence;
+        hasKeyframe = true;
+        frame.state = keyframe;
+        return true;
+    }
+
+    if (data[1] == TELEMETRY_FRAME_DELTA && length == TELEMETRY_V2_DELTA_LENGTH)
+    {
+        ushort deltas[8];
+        readUShortsInNetworkByteOrder(body, deltas, 8);
+
+        // without the referenced keyframe the delta is useless
+        if (!hasKeyframe || deltas[0] != static_cast<ushort>(keyframeSequence))
+        {
+            return false;
+        }
+
+        frame.type = TELEMETRY_FRAME_DELTA;
+        frame.state.latitude = keyframe.latitude + static_cast<short>(deltas[1]) / DELTA_COORDINATE_SCALE;
+        frame.state.longitude = normalizeAngle(keyframe.longitude + static_cast<short>(deltas[2]) / DELTA_COORDINATE_SCALE, -180.0);
+        frame.state.altitude = keyframe.altitude + static_cast<short>(deltas[3]) / DELTA_ALTITUDE_SCALE;
+        frame.state.heading = normalizeAngle(keyframe.heading + static_cast<short>(deltas[4]) / DELTA_ANGLE_SCALE, 0.0);
+        frame.state.bank = keyframe.bank + static_cast<short>(deltas[5]) / DELTA_ANGLE_SCALE;
+        frame.state.pitch = keyframe.pitch + static_cast<short>(deltas[6]) / DELTA_ANGLE_SCALE;
+        frame.state.speed = keyframe.speed + static_cast<short>(deltas[7]) / DELTA_SPEED_SCALE;
+        return true;
+    }
+
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "aircraftState.h"
+#include "gateDetector.h"
+
+#include <cstdint>
+#include <string>
+
+/// Length of a version 1 aircraft state message (7 doubles)
+#define TELEMETRY_V1_MESSAGE_LENGTH 56
+
+/// Length of the version 2 header: version (1), frame type (1), sequence (4), timestamp (8)
+#define TELEMETRY_V2_HEADER_LENGTH 14
+
+/// Length of a version 2 keyframe: header, latitude and longitude (2 * 4), altitude, attitude and speed (5 * 4)
+#define TELEMETRY_V2_KEYFRAME_LENGTH (TELEMETRY_V2_HEADER_LENGTH + 28)
+
+/// Length of a version 2 delta frame: header, keyframe sequence (2), seven deltas (7 * 2)
+#define TELEMETRY_V2_DELTA_LENGTH (TELEMETRY_V2_HEADER_LENGTH + 16)
+
+/// Length of a version 2 gate event: header, indicator id (2), miss distance (4)
+#define TELEMETRY_V2_GATE_EVENT_LENGTH (TELEMETRY_V2_HEADER_LENGTH + 6)
+
+/// Size of a buffer which can hold every aircraft state message
+#define TELEMETRY_MAX_MESSAGE_LENGTH TELEMETRY_V1_MESSAGE_LENGTH
+
+/// Maximum number of delta frames after a keyframe, so a receiver recovers quickly from a lost keyframe
+#define TELEMETRY_KEYFRAME_INTERVAL 30
+
+/// <summary>
+/// Wire formats of the aircraft state messages.
+/// TELEMETRY_FORMAT_V1: seven doubles (latitude, longitude, altitude, heading, bank, pitch, speed)
+/// TELEMETRY_FORMAT_V2: header with version, sequence number and timestamp, followed by a keyframe or a delta frame
+/// </summary>
+enum TelemetryFormat { TELEMETRY_FORMAT_V1 = 1, TELEMETRY_FORMAT_V2 = 2 };
+
+/// <summary>
+/// Frame types of the version 2 format.
+/// TELEMETRY_FRAME_KEY: latitude and longitude as fixed point values (1e-7 degrees), altitude, attitude and speed as float32
+/// TELEMETRY_FRAME_DELTA: 16 bit differences to the referenced keyframe (1e-6 degrees, 0.1 ft, 0.01 degrees, 0.01 kts)
+/// TELEMETRY_FRAME_GATE_PASSED, TELEMETRY_FRAME_GATE_MISSED: indicator id and miss distance in m as float32 of a ring passage, the
+/// header carries the time of the passage and a sequence of its own. They are sent to the subscribers of every format.
+/// </summary>
+enum TelemetryFrameType { TELEMETRY_FRAME_KEY = 1, TELEMETRY_FRAME_DELTA = 2, TELEMETRY_FRAME_GATE_PASSED = 3, TELEMETRY_FRAME_GATE_MISSED = 4 };
+
+/// <summary>
+/// A decoded aircraft state message.
+/// </summary>
+struct TelemetryFrame {
+    /// <summary>
+    /// Wire format of the message
+    /// </summary>
+    TelemetryFormat format;
+
+    /// <summary>
+    /// Frame type, always TELEMETRY_FRAME_KEY for version 1
+    /// </summary>
+    TelemetryFrameType type;
+
+    /// <summary>
+    /// Sequence number of the message, 0 for version 1
+    /// </summary>
+    uint sequence;
+
+    /// <summary>
+    /// Monotonic time of the state in microseconds, 0 for version 1
+    /// </summary>
+    uint64_t timestamp;
+
+    /// <summary>
+    /// The aircraft state
+    /// </summary>
+    AircraftStateStruct state;
+};
+
+/// <summary>
+/// Parses the name of a wire format (v1 or v2).
+/// </summary>
+/// <param name="name">Name of the format</param>
+/// <param name="format">Receives the format, unchanged if the name is invalid</param>
+/// <returns>True if the name is valid</returns>
+bool parseTelemetryFormat(const std::string& name, TelemetryFormat* format);
+
+/// <summary>
+/// Returns the name of a wire format (v1 or v2).
+/// </summary>
+/// <param name="format">Wire format</param>
+/// <returns>Name of the format</returns>
+const char* getTelemetryFormatName(TelemetryFormat format);
+
+/// <summary>
+/// Encodes a ring passage as version 2 gate event.
+/// </summary>
+/// <param name="event">The passage</param>
+/// <param name="sequence">Sequence number of the gate event</param>
+/// <param name="buffer">Receives the message, at least TELEMETRY_V2_GATE_EVENT_LENGTH bytes</param>
+/// <returns>Length of the message</returns>
+uint encodeGateEvent(const GateEvent& event, uint sequence, char* buffer);
+
+/// <summary>
+/// Decodes a version 2 gate event. Used by tests and as reference for receivers.
+/// </summary>
+/// <param name="data">The message</param>
+/// <param name="length">Length of the message</param>
+/// <param name="event">Receives the passage</param>
+/// <param name="sequence">Receives the sequence number of the gate event</param>
+/// <returns>False if the message is no gate event</returns>
+bool decodeGateEvent(const char* data, uint length, GateEvent& event, uint* sequence);
+
+/// <summary>
+/// Encodes the aircraft states for one target. In version 2 the encoder remembers the last keyframe, so every target needs its own encoder.
+/// </summary>
+class TelemetryEncoder {
+public:
+    /// <summary>
+    /// Creates an encoder for the given format.
+    /// </summary>
+    /// <param name="format">Wire format</param>
+    explicit TelemetryEncoder(TelemetryFormat format = TELEMETRY_FORMAT_V1);
+
+    /// <summary>
+    /// Encodes the given state into the buffer.
+    /// </summary>
+    /// <param name="state">The aircraft state</param>
+    /// <param name="timestamp">Monotonic time of the state in microseconds</param>
+    /// <param name="buffer">Receives the message, at least TELEMETRY_MAX_MESSAGE_LENGTH bytes</param>
+    /// <returns>Length of the message</returns>
+    uint encode(const AircraftStateStruct& state, uint64_t timestamp, char* buffer);
+
+    /// <summary>
+    /// Changes the wire format. The next version 2 message is a keyframe.
+    /// </summary>
+    /// <param name="format">Wire format</param>
+    void setFormat(TelemetryFormat format);
+
+    /// <summary>
+    /// Returns the wire format.
+    /// </summary>
+    /// <returns>Wire format</returns>
+    TelemetryFormat getFormat() const;
+
+private:
+    /// <summary>
+    /// Wire format
+    /// </summary>
+    TelemetryFormat format;
+
+    /// <summary>
+    /// Sequence number of the next message.
+    /// </summary>
+    uint sequence = 0;
+
+    /// <summary>
+    /// False until the first keyframe was encoded.
+    /// </summary>
+    bool hasKeyframe = false;
+
+    /// <summary>
+    /// Sequence number of the last keyframe.
+    /// </summary>
+    uint keyframeSequence = 0;
+
+    /// <summary>
+    /// Number of delta frames since the last keyframe.
+    /// </summary>
+    uint deltaFrames = 0;
+
+    /// <summary>
+    /// The last keyframe as the receiver decodes it, the deltas are relative to these values.
+    /// </summary>
+    AircraftStateStruct keyframe{};
+
+    /// <summary>
+    /// Writes the version 2 header.
+    /// </summary>
+    void writeHeader(TelemetryFrameType type, uint64_t timestamp, char* buffer);
+
+    /// <summary>
+    /// Writes the state as delta frame if all differences fit into 16 bit.
+    /// </summary>
+    /// <returns>False if the state has to be sent as keyframe</returns>
+    bool encodeDelta(const AircraftStateStruct& state, uint64_t timestamp, char* buffer);
+};
+
+/// <summary>
+/// Decodes the aircraft state messages of one sender. Used by tests and as reference for receivers.
+/// </summary>
+class TelemetryDecoder {
+public:
+    /// <summary>
+    /// Decodes a message of any version.
+    /// </summary>
+    /// <param name="data">The message</param>
+    /// <param name="length">Length of the message</param>
+    /// <param name="frame">Receives the decoded message</param>
+    /// <returns>False if the message is invalid or a delta frame refers to a keyframe which was not received</returns>
+    bool decode(const char* data, uint length, TelemetryFrame& frame);
+
+private:
+    /// <summary>
+    /// False until the first keyframe was received.
+    /// </summary>
+    bool hasKeyframe = false;
+
+    /// <summary>
+    /// Sequence number of the last keyframe.
+    /// </summary>
+    uint keyframeSequence = 0;
+
+    /// <summary>
+    /// The last keyframe.
+    /// </summary>
+    AircraftStateStruct keyframe{};
+};
\ No newline at end of file
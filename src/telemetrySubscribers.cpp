@@ -0,0 +1,265 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "telemetrySubscribers.h"
+
+TelemetrySubscriberRegistry::TelemetrySubscriberRegistry()
+    : streams(TELEMETRY_MAX_SUBSCRIBERS), messageBuffers(TELEMETRY_MAX_SUBSCRIBERS * TELEMETRY_MAX_MESSAGE_LENGTH)
+{
+    subscribers.reserve(TELEMETRY_MAX_SUBSCRIBERS);
+    datagrams.reserve(TELEMETRY_MAX_SUBSCRIBERS);
+
+    for (Stream& stream : streams)
+    {
+        stream.subscribers = 0;
+    }
+}
+
+SubscribeResult TelemetrySubscriberRegistry::subscribe(uint address, ushort port, TelemetryFormat format, ushort rate, bool isPermanent,
+    std::chrono::steady_clock::time_point time)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::chrono::steady_clock::time_point expiry = time + std::chrono::milliseconds(TELEMETRY_SUBSCRIPTION_TIMEOUT);
+
+    if (Subscriber* subscriber = findSubscriber(address, port))
+    {
+        subscriber->expiry = expiry;
+        subscriber->isPermanent = subscriber->isPermanent || isPermanent;
+
+        const Stream& stream = streams[subscriber->stream];
+        if (stream.format != format || stream.rate != rate)
+        {
+            detachStream(subscriber->stream);
+            subscriber->stream = attachStream(format, rate);
+        }
+        return SUBSCRIBE_RENEWED;
+    }
+
+    if (subscribers.size() >= TELEMETRY_MAX_SUBSCRIBERS)
+    {
+        return SUBSCRIBE_FULL;
+    }
+
+    subscribers.push_back(Subscriber{ address, port, isPermanent, expiry, attachStream(format, rate), 0 });
+    return SUBSCRIBE_ADDED;
+}
+
+bool TelemetrySubscriberRegistry::unsubscribe(uint address, ushort port)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Subscriber* subscriber = findSubscriber(address, port);
+    if (subscriber == nullptr)
+    {
+        return false;
+    }
+
+    detachStream(subscriber->stream);
+    subscribers.erase(subscribers.begin() + (subscriber - subscribers.data()));
+    return true;
+}
+
+bool TelemetrySubscriberRegistry::setFormat(uint address, ushort port, TelemetryFormat format)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Subscriber* subscriber = findSubscriber(address, port);
+    if (subscriber == nullptr)
+    {
+        return false;
+    }
+
+    ushort rate = streams[subscriber->stream].rate;
+    detachStream(subscriber->stream);
+    subscriber->stream = attachStream(format, rate);
+    return true;
+}
+
+void TelemetrySubscriberRegistry::setPermanentFormat(TelemetryFormat format)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Subscriber& subscriber : subscribers)
+    {
+        if (subscriber.isPermanent)
+        {
+            ushort rate = streams[subscriber.stream].rate;
+            detachStream(subscriber.stream);
+            subscriber.stream = attachStream(format, rate);
+        }
+    }
+}
+
+std::span<const UDPDatagram> TelemetrySubscriberRegistry::publish(const AircraftStateStruct& state, std::chrono::steady_clock::time_point time,
+    uint64_t timestamp)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // every stream which is due encodes the state once
+    for (uint i = 0; i < streams.size(); i++)
+    {
+        Stream& stream = streams[i];
+        stream.messageLength = 0;
+
+        if (stream.subscribers == 0)
+        {
+            continue;
+        }
+
+        if (stream.rate > 0)
+        {
+            std::chrono::nanoseconds interval(1000000000 / stream.rate);
+
+            // the states arrive with some jitter, a state slightly before the due time is accepted
+            if (time < stream.nextUpdate - interval / 4)
+            {
+                continue;
+            }
+
+            stream.nextUpdate += interval;
+            if (stream.nextUpdate <= time)
+            {
+                stream.nextUpdate = time + interval;
+            }
+        }
+
+        stream.messageLength = stream.encoder.encode(state, timestamp, &messageBuffers[i * TELEMETRY_MAX_MESSAGE_LENGTH]);
+    }
+
+    datagrams.clear();
+    for (Subscriber& subscriber : subscribers)
+    {
+        const Stream& stream = streams[subscriber.stream];
+        if (stream.messageLength > 0)
+        {
+            datagrams.push_back(UDPDatagram{ &messageBuffers[subscriber.stream * TELEMETRY_MAX_MESSAGE_LENGTH], stream.messageLength,
+                subscriber.address, subscriber.port });
+            subscriber.sent++;
+        }
+    }
+
+    return std::span<const UDPDatagram>(datagrams.data(), datagrams.size());
+}
+
+std::span<const UDPDatagram> TelemetrySubscriberRegistry::publishEvent(const char* message, uint length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    datagrams.clear();
+    for (const Subscriber& subscriber : subscribers)
+    {
+        // version 1 receivers only understand the 56 byte state messages
+        if (streams[subscriber.stream].format == TELEMETRY_FORMAT_V2)
+        {
+            datagrams.push_back(UDPDatagram{ message, length, subscriber.address, subscriber.port });
+        }
+    }
+
+    return std::span<const UDPDatagram>(datagrams.data(), datagrams.size());
+}
+
+std::vector<TelemetrySubscriberStatistics> TelemetrySubscriberRegistry::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<TelemetrySubscriberStatistics> statistics;
+    for (const Subscriber& subscriber : subscribers)
+    {
+        const Stream& stream = streams[subscriber.stream];
+        statistics.push_back(TelemetrySubscriberStatistics{ subscriber.address, subscriber.port, stream.format, stream.rate,
+            subscriber.isPermanent, subscriber.sent });
+    }
+    return statistics;
+}
+
+TelemetrySubscriberRegistry::Subscriber* TelemetrySubscriberRegistry::findSubscriber(uint address, ushort port)
+{
+    for (Subscriber& subscriber : subscribers)
+    {
+        if (subscriber.address == address && subscriber.port == port)
+        {
+            return &subscriber;
+        }
+    }
+    return nullptr;
+}
+
+uint TelemetrySubscriberRegistry::attachStream(TelemetryFormat format, ushort rate)
+{
+    uint freeSlot = TELEMETRY_MAX_SUBSCRIBERS;
+    for (uint i = 0; i < streams.size(); i++)
+    {
+        Stream& stream = streams[i];
+        if (stream.subscribers > 0 && stream.format == format && stream.rate == rate)
+        {
+            // the new subscriber needs a keyframe before it can decode the deltas of the stream
+            stream.encoder.setFormat(format);
+            stream.subscribers++;
+            return i;
+        }
+
+        if (stream.subscribers == 0 && freeSlot == TELEMETRY_MAX_SUBSCRIBERS)
+        {
+            freeSlot = i;
+        }
+    }
+
+    // there are never more streams than subscribers, so a slot is always free
+    Stream& stream = streams[freeSlot];
+    stream.format = format;
+    stream.rate = rate;
+    stream.subscribers = 1;
+    stream.encoder.setFormat(format);
+    stream.nextUpdate = std::chrono::steady_clock::time_point();
+    stream.messageLength = 0;
+    return freeSlot;
+}
+
+void TelemetrySubscriberRegistry::detachStream(uint stream)
+{
+    streams[stream].subscribers--;
+}
+
+std::vector<TelemetrySubscriberStatistics> TelemetrySubscriberRegistry::removeExpiredSubscribers(std::chrono::steady_clock::time_point time)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<TelemetrySubscriberStatistics> expired;
+    if (time < nextExpiryCheck)
+    {
+        return expired;
+    }
+    nextExpiryCheck = time + std::chrono::milliseconds(TELEMETRY_EXPIRY_CHECK_INTERVAL);
+
+    for (size_t i = 0; i < subscribers.size();)
+    {
+        Subscriber& subscriber = subscribers[i];
+        if (subscriber.isPermanent || time < subscriber.expiry)
+        {
+            i++;
+            continue;
+        }
+
+        const Stream& stream = streams[subscriber.stream];
+        expired.push_back(TelemetrySubscriberStatistics{ subscriber.address, subscriber.port, stream.format, stream.rate, false, subscriber.sent });
+        detachStream(subscriber.stream);
+        subscribers.erase(subscribers.begin() + i);
+    }
+    return expired;
+}
\ No newline at end of file
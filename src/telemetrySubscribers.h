@@ -0,0 +1,209 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+#include "aircraftState.h"
+#include "telemetryFormat.h"
+#include "udpSendQueue.h"
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <span>
+#include <cstdint>
+
+/// Maximum number of telemetry subscribers including the default target
+#define TELEMETRY_MAX_SUBSCRIBERS 32
+
+/// Time after which a subscriber which did not renew its subscription is removed (in ms)
+#define TELEMETRY_SUBSCRIPTION_TIMEOUT 10000
+
+/// Minimum time between two checks for expired subscriptions (in ms)
+#define TELEMETRY_EXPIRY_CHECK_INTERVAL 1000
+
+/// <summary>
+/// Result of a subscription.
+/// </summary>
+enum SubscribeResult { SUBSCRIBE_ADDED, SUBSCRIBE_RENEWED, SUBSCRIBE_FULL };
+
+/// <summary>
+/// Snapshot of a subscriber and its counter.
+/// </summary>
+struct TelemetrySubscriberStatistics {
+    uint address;             // IPv4 address in host byte order
+    ushort port;              // port in host byte order
+    TelemetryFormat format;   // wire format
+    ushort rate;              // maximum states per second, 0 for every state
+    bool isPermanent;         // default target which never expires
+    unsigned long long sent;  // number of sent states
+};
+
+/// <summary>
+/// Registry of the receivers of the aircraft states.
+///
+/// Subscribers with the same format and rate share a stream: every state is decimated and encoded once per stream and the
+/// message is sent to all subscribers of the stream. This keeps the version 2 delta frames of a stream consistent, because
+/// all its subscribers receive the same keyframes. A new subscriber forces a keyframe on its stream.
+/// publish and publishEvent are called by the thread which handles the simulation events, the other methods by any thread.
+/// </summary>
+class TelemetrySubscriberRegistry {
+public:
+    /// <summary>
+    /// Creates an empty registry and preallocates the message buffers of all streams.
+    /// </summary>
+    TelemetrySubscriberRegistry();
+
+    /// <summary>
+    /// Registers a subscriber or renews its subscription. A renewal may change format and rate.
+    /// </summary>
+    /// <param name="address">IPv4 address in host byte order</param>
+    /// <param name="port">Port in host byte order</param>
+    /// <param name="format">Wire format</param>
+    /// <param name="rate">Maximum states per second, 0 for every state</param>
+    /// <param name="isPermanent">True if the subscription never expires</param>
+    /// <param name="time">Current time</param>
+    /// <returns>SUBSCRIBE_FULL if TELEMETRY_MAX_SUBSCRIBERS are registered</returns>
+    SubscribeResult subscribe(uint address, ushort port, TelemetryFormat format, ushort rate, bool isPermanent, std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Removes a subscriber.
+    /// </summary>
+    /// <param name="address">IPv4 address in host byte order</param>
+    /// <param name="port">Port in host byte order</param>
+    /// <returns>False if the subscriber is unknown</returns>
+    bool unsubscribe(uint address, ushort port);
+
+    /// <summary>
+    /// Changes the format of a subscriber.
+    /// </summary>
+    /// <param name="address">IPv4 address in host byte order</param>
+    /// <param name="port">Port in host byte order</param>
+    /// <param name="format">Wire format</param>
+    /// <returns>False if the subscriber is unknown</returns>
+    bool setFormat(uint address, ushort port, TelemetryFormat format);
+
+    /// <summary>
+    /// Changes the format of the permanent subscribers.
+    /// </summary>
+    /// <param name="format">Wire format</param>
+    void setPermanentFormat(TelemetryFormat format);
+
+    /// <summary>
+    /// Encodes the state once for every stream which is due and returns the messages for all their subscribers.
+    /// </summary>
+    /// <param name="state">The aircraft state</param>
+    /// <param name="time">Time of the state</param>
+    /// <param name="timestamp">Monotonic time of the state in microseconds, written into version 2 messages</param>
+    /// <returns>The messages, valid until the next call</returns>
+    std::span<const UDPDatagram> publish(const AircraftStateStruct& state, std::chrono::steady_clock::time_point time, uint64_t timestamp);
+
+    /// <summary>
+    /// Returns the message for all version 2 subscribers, independent of their rate. Used for events like ring passages,
+    /// which have no representation in version 1.
+    /// </summary>
+    /// <param name="message">The message, it has to stay valid until the datagrams are sent</param>
+    /// <param name="length">Length of the message</param>
+    /// <returns>The messages, valid until the next call</returns>
+    std::span<const UDPDatagram> publishEvent(const char* message, uint length);
+
+    /// <summary>
+    /// Removes the subscribers which did not renew their subscription within TELEMETRY_SUBSCRIPTION_TIMEOUT.
+    /// Checks at most every TELEMETRY_EXPIRY_CHECK_INTERVAL, so it may be called frequently.
+    /// </summary>
+    /// <param name="time">Current time</param>
+    /// <returns>The removed subscribers</returns>
+    std::vector<TelemetrySubscriberStatistics> removeExpiredSubscribers(std::chrono::steady_clock::time_point time);
+
+    /// <summary>
+    /// Returns all subscribers and their counters.
+    /// </summary>
+    /// <returns>Statistics of the subscribers</returns>
+    std::vector<TelemetrySubscriberStatistics> getStatistics() const;
+
+private:
+    /// <summary>
+    /// A registered receiver.
+    /// </summary>
+    struct Subscriber {
+        uint address;
+        ushort port;
+        bool isPermanent;
+        std::chrono::steady_clock::time_point expiry;
+        uint stream;
+        unsigned long long sent;
+    };
+
+    /// <summary>
+    /// Subscribers with the same format and rate. The message of the stream is stored in its slot of messageBuffers.
+    /// </summary>
+    struct Stream {
+        TelemetryFormat format;
+        ushort rate;
+        uint subscribers;
+        TelemetryEncoder encoder;
+        std::chrono::steady_clock::time_point nextUpdate;
+        uint messageLength;
+    };
+
+    /// <summary>
+    /// Guards all members.
+    /// </summary>
+    mutable std::mutex mutex;
+
+    /// <summary>
+    /// Registered subscribers.
+    /// </summary>
+    std::vector<Subscriber> subscribers;
+
+    /// <summary>
+    /// Stream slots, a slot without subscribers is free.
+    /// </summary>
+    std::vector<Stream> streams;
+
+    /// <summary>
+    /// One message buffer of TELEMETRY_MAX_MESSAGE_LENGTH bytes per stream slot.
+    /// </summary>
+    std::vector<char> messageBuffers;
+
+    /// <summary>
+    /// Messages of the last publish or publishEvent call.
+    /// </summary>
+    std::vector<UDPDatagram> datagrams;
+
+    /// <summary>
+    /// Time of the next check for expired subscriptions.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextExpiryCheck;
+
+    /// <summary>
+    /// Returns the subscriber with the given address or nullptr.
+    /// </summary>
+    Subscriber* findSubscriber(uint address, ushort port);
+
+    /// <summary>
+    /// Returns the slot of the stream with the given format and rate, a free slot is used if there is none.
+    /// </summary>
+    uint attachStream(TelemetryFormat format, ushort rate);
+
+    /// <summary>
+    /// Removes a subscriber from its stream.
+    /// </summary>
+    void detachStream(uint stream);
+};
\ No newline at end of file
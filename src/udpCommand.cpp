@@ -17,10 +17,14 @@
  * limitations under the License.
  */
 #include "udpCommand.h"
-#include "flightPathVisualizer.h"
 #include "numberUtils.h"
+#include "byteOrder.h"
+#include "telemetryFormat.h"
+#include "stringHelper.h"
 
 #include <string>
+#include <stdexcept>
+#include <cmath>
 
 #define LATITUDE_MIN -90.0
 #define LATITUDE_MAX 90.0
@@ -28,163 +32,498 @@
 #define LONGITUDE_MIN -180.0
 #define LONGITUDE_MAX 180.0
 
+/// <summary>
+/// Validates the position of a SET command. This is mainly the latitude and longitude of the position.
+/// </summary>
+/// <param name="position">Position to validate</param>
+/// <returns>The result of the validation</returns>
+static ValidationResult validatePosition(const WorldPositionStruct& position)
+{
+    if (!isDoubleInRange(position.latitude, LATITUDE_MIN, LATITUDE_MAX))
+    {
+        return LATITUDE_OUT_OF_RANGE;
+    }
+
+    if (!isDoubleInRange(position.longitude, LONGITUDE_MIN, LONGITUDE_MAX))
+    {
+        return LONGITUDE_OUT_OF_RANGE;
+    }
+
+    return OK;
+}
+
+/// <summary>
+/// Parses and validates a single SET record (indicator id, indicator type id and position without the leading command id).
+/// This layout is used by the SET command as well as by every record of the SET_BATCH command.
+/// </summary>
+/// <param name="record">Raw data of the record (SET_RECORD_LENGTH bytes)</param>
+/// <param name="command">Receives the parsed record</param>
+/// <returns>PARSE_OK or the validation error</returns>
+static ParseError parseSetRecord(const char* record, SetIndicatorCommand& command)
+{
+    command.id = readUShortNetworkByteOrder(record);
+    command.indicatorTypeID = readUintNetworkByteOrder(record + 2);
+
+    // the six position values are consecutive, so they are converted at once
+    double values[6];
+    readDoublesInNetworkByteOrder(record + 6, values, 6);
+    command.position.latitude = values[0];
+    command.position.longitude = values[1];
+    command.position.altitude = values[2];
+    command.position.heading = values[3];
+    command.position.bank = values[4];
+    command.position.pitch = values[5];
+
+    ValidationResult res = validatePosition(command.position);
+
+    if (res == LATITUDE_OUT_OF_RANGE)
+    {
+        return PARSE_LATITUDE_OUT_OF_RANGE;
+    }
+    else if (res == LONGITUDE_OUT_OF_RANGE)
+    {
+        return PARSE_LONGITUDE_OUT_OF_RANGE;
+    }
+
+    return PARSE_OK;
+}
+
+static std::string setIndicatorToString(const SetIndicatorCommand& command)
+{
+    return "Set Indicator: Indicator " + std::to_string(command.id) +
+        " of type " + std::to_string(command.indicatorTypeID) +
+        " Lat: " + std::to_string(command.position.latitude) +
+        ", Long: " + std::to_string(command.position.longitude) +
+        ", Height: " + std::to_string(command.position.altitude) +
+        ", Roll: " + std::to_string(command.position.heading) +
+        ", Pitch: " + std::to_string(command.position.bank) +
+        ", Yaw: " + std::to_string(command.position.pitch);
+}
+
+static std::string setIndicatorBatchToString(const SetIndicatorCommand* indicators, size_t count)
+{
+    return "Set Indicator Batch: " + std::to_string(count) + " indicators (IDs " +
+        std::to_string(indicators[0].id) + " - " + std::to_string(indicators[count - 1].id) + ")";
+}
+
+static std::string removeIndicatorsToString(const ushort* ids, size_t count)
+{
+    if (count == 0)
+    {
+        return "Delete all indicators.";
+    }
+
+    std::string msg = "Delete indicators: ";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        msg = msg + std::to_string(ids[i]);
+        if (i + 1 != count) {
+            msg = msg + ", ";
+        }
+    }
+
+    return msg;
+}
+
+static std::string pathToString(ushort firstID, uint indicatorTypeID, double spacing, PathInterpolation interpolation, size_t count)
+{
+    return "Path: " + std::to_string(count) + " waypoints, " + getPathInterpolationName(interpolation) + ", indicators of type " +
+        std::to_string(indicatorTypeID) + " every " + std::to_string(spacing) + " m from ID " + std::to_string(firstID);
+}
+
+static std::string anchorIndicatorToString(const AnchorIndicatorCommand& command)
+{
+    return "Anchor Indicator: Indicator " + std::to_string(command.id) +
+        " of type " + std::to_string(command.indicatorTypeID) +
+        " in " + getAnchorFrameName(command.frame) + " frame" +
+        " X: " + std::to_string(command.offset.x) +
+        ", Y: " + std::to_string(command.offset.y) +
+        ", Z: " + std::to_string(command.offset.z) +
+        ", Heading: " + std::to_string(command.offset.heading) +
+        ", Bank: " + std::to_string(command.offset.bank) +
+        ", Pitch: " + std::to_string(command.offset.pitch);
+}
+
+static std::string telemetryFormatToString(const TelemetryFormatCommand& command)
+{
+    return "Telemetry format: " + std::string(getTelemetryFormatName(static_cast<TelemetryFormat>(command.format)));
+}
+
+static std::string subscribeToString(const SubscribeCommand& command)
+{
+    return "Subscribe " + formatIPv4Address(command.subscriber.address, command.subscriber.port) + ": format " + getTelemetryFormatName(static_cast<TelemetryFormat>(command.format)) +
+        ", rate " + (command.rate == 0 ? std::string("every state") : std::to_string(command.rate) + " Hz");
+}
+
+static std::string unsubscribeToString(const UnsubscribeCommand& command)
+{
+    return "Unsubscribe " + formatIPv4Address(command.subscriber.address, command.subscriber.port);
+}
+
  //////////////
  /// PARSER ///
  //////////////
-std::unique_ptr<AbstractCommandConfiguration> CommandConfigurationParser::parse(char* raw, uint length)
+ParseError CommandParser::parse(const char* raw, uint length, ParsedCommand& command, CommandSender sender) noexcept
 {
-    std::unique_ptr<AbstractCommandConfiguration> commandConfiguration = nullptr;
-
     if (length < sizeof(ushort))
     {
-        throw std::invalid_argument("missing_command");
+        return PARSE_MISSING_COMMAND;
     }
 
     ushort commandID = readUShortNetworkByteOrder(raw);
 
-    // this has to be improved if there are more than two commands
-    if (commandID != 1 && commandID != 2)
+    switch (commandID)
     {
-        throw std::invalid_argument("unknown_command");
+    case COMMAND_ID_SET:
+    {
+        if (length != SET_MESSAGE_LENGTH)
+        {
+            return PARSE_SET_INVALID_LENGTH;
+        }
+
+        SetIndicatorCommand& setCommand = command.emplace<SetIndicatorCommand>();
+        return parseSetRecord(raw + 2, setCommand);
     }
+    case COMMAND_ID_REMOVE:
+    {
+        if (length % 2 != 0 || length > 2 + MAX_REMOVE_IDS * sizeof(ushort))
+        {
+            return PARSE_REMOVE_INVALID_LENGTH;
+        }
+
+        RemoveIndicatorsCommand& removeCommand = command.emplace<RemoveIndicatorsCommand>();
+        removeCommand.count = static_cast<ushort>((length - 2) / sizeof(ushort));
 
-    if (commandID == 1)
+        readUShortsInNetworkByteOrder(raw + 2, removeCommand.ids, removeCommand.count);
+        return PARSE_OK;
+    }
+    case COMMAND_ID_SET_BATCH:
     {
-        if (length != 56)
+        if (length < SET_BATCH_HEADER_LENGTH)
+        {
+            return PARSE_SET_BATCH_INVALID_LENGTH;
+        }
+
+        ushort count = readUShortNetworkByteOrder(raw + 2);
+
+        if (count == 0 || count > MAX_SET_BATCH_RECORDS || length != static_cast<uint>(SET_BATCH_HEADER_LENGTH + count * SET_RECORD_LENGTH))
+        {
+            return PARSE_SET_BATCH_INVALID_LENGTH;
+        }
+
+        SetIndicatorBatchCommand& batchCommand = command.emplace<SetIndicatorBatchCommand>();
+        batchCommand.count = count;
+
+        // all records are validated, if one of them is invalid the whole batch is rejected
+        const char* record = raw + SET_BATCH_HEADER_LENGTH;
+        for (ushort i = 0; i < count; i++, record += SET_RECORD_LENGTH)
         {
-            throw std::invalid_argument("set_invalid_length");
+            ParseError error = parseSetRecord(record, batchCommand.indicators[i]);
+            if (error != PARSE_OK)
+            {
+                return error;
+            }
         }
-        commandConfiguration = SetIndicatorCommandConfiguration::parse(raw);
+        return PARSE_OK;
     }
-    else if (commandID == 2)
+    case COMMAND_ID_TELEMETRY_FORMAT:
     {
-        if (length % 2 != 0)
+        if (length != TELEMETRY_FORMAT_MESSAGE_LENGTH)
         {
-            throw std::invalid_argument("remove_invalid_length");
+            return PARSE_TELEMETRY_FORMAT_INVALID_LENGTH;
         }
-        commandConfiguration = RemoveIndicatorsCommandConfiguration::parse(raw, length);
+
+        ushort format = readUShortNetworkByteOrder(raw + 2);
+        if (format != TELEMETRY_FORMAT_V1 && format != TELEMETRY_FORMAT_V2)
+        {
+            return PARSE_UNKNOWN_TELEMETRY_FORMAT;
+        }
+
+        TelemetryFormatCommand& formatCommand = command.emplace<TelemetryFormatCommand>();
+        formatCommand.format = format;
+        formatCommand.sender = sender;
+        return PARSE_OK;
     }
+    case COMMAND_ID_SUBSCRIBE:
+    {
+        if (length != SUBSCRIBE_MESSAGE_LENGTH)
+        {
+            return PARSE_SUBSCRIBE_INVALID_LENGTH;
+        }
 
-    return commandConfiguration;
-}
+        ushort format = readUShortNetworkByteOrder(raw + 2);
+        if (format != TELEMETRY_FORMAT_V1 && format != TELEMETRY_FORMAT_V2)
+        {
+            return PARSE_UNKNOWN_TELEMETRY_FORMAT;
+        }
 
+        SubscribeCommand& subscribeCommand = command.emplace<SubscribeCommand>();
+        subscribeCommand.format = format;
+        subscribeCommand.rate = readUShortNetworkByteOrder(raw + 4);
+        subscribeCommand.subscriber = sender;
 
+        // the states may be received on another port than the one the command was sent from
+        ushort port = readUShortNetworkByteOrder(raw + 6);
+        if (port != 0)
+        {
+            subscribeCommand.subscriber.port = port;
+        }
+        return PARSE_OK;
+    }
+    case COMMAND_ID_UNSUBSCRIBE:
+    {
+        if (length != UNSUBSCRIBE_MESSAGE_LENGTH)
+        {
+            return PARSE_UNSUBSCRIBE_INVALID_LENGTH;
+        }
 
-//////////////
-///   SET  ///
-//////////////
+        UnsubscribeCommand& unsubscribeCommand = command.emplace<UnsubscribeCommand>();
+        unsubscribeCommand.subscriber = sender;
 
-std::unique_ptr<SetIndicatorCommandConfiguration> SetIndicatorCommandConfiguration::parse(char* array)
-{
-    ushort id = readUShortNetworkByteOrder(array + 2);
-    uint indicatorTypeID = readUintNetworkByteOrder(array + 4);
-    double latitude = readDoubleinNetworkByteOrder(array + 8);
-    double longitude = readDoubleinNetworkByteOrder(array + 16);
-    double altitude = readDoubleinNetworkByteOrder(array + 24);
-    double heading = readDoubleinNetworkByteOrder(array + 32);
-    double bank = readDoubleinNetworkByteOrder(array + 40);
-    double pitch = readDoubleinNetworkByteOrder(array + 48);
+        ushort port = readUShortNetworkByteOrder(raw + 2);
+        if (port != 0)
+        {
+            unsubscribeCommand.subscriber.port = port;
+        }
+        return PARSE_OK;
+    }
+    case COMMAND_ID_PATH:
+    {
+        if (length < PATH_HEADER_LENGTH)
+        {
+            return PARSE_PATH_INVALID_LENGTH;
+        }
+
+        ushort count = readUShortNetworkByteOrder(raw + 18);
+
+        if (count < 2 || count > MAX_PATH_WAYPOINTS || length != static_cast<uint>(PATH_HEADER_LENGTH + count * PATH_WAYPOINT_LENGTH))
+        {
+            return PARSE_PATH_INVALID_LENGTH;
+        }
+
+        ushort interpolation = readUShortNetworkByteOrder(raw + 16);
+        if (interpolation != PATH_INTERPOLATION_GREAT_CIRCLE && interpolation != PATH_INTERPOLATION_CATMULL_ROM)
+        {
+            return PARSE_UNKNOWN_PATH_INTERPOLATION;
+        }
+
+        double spacing;
+        readDoublesInNetworkByteOrder(raw + 8, &spacing, 1);
+        if (!std::isfinite(spacing) || spacing <= 0)
+        {
+            return PARSE_PATH_INVALID_SPACING;
+        }
+
+        PathCommand& pathCommand = command.emplace<PathCommand>();
+        pathCommand.firstID = readUShortNetworkByteOrder(raw + 2);
+        pathCommand.indicatorTypeID = readUintNetworkByteOrder(raw + 4);
+        pathCommand.spacing = spacing;
+        pathCommand.interpolation = static_cast<PathInterpolation>(interpolation);
+        pathCommand.count = count;
+
+        // all waypoints are validated, if one of them is invalid the whole path is rejected
+        const char* record = raw + PATH_HEADER_LENGTH;
+        for (ushort i = 0; i < count; i++, record += PATH_WAYPOINT_LENGTH)
+        {
+            double values[3];
+            readDoublesInNetworkByteOrder(record, values, 3);
+            PathWaypoint& waypoint = pathCommand.waypoints[i];
+            waypoint.latitude = values[0];
+            waypoint.longitude = values[1];
+            waypoint.altitude = values[2];
+
+            if (!isDoubleInRange(waypoint.latitude, LATITUDE_MIN, LATITUDE_MAX))
+            {
+                return PARSE_LATITUDE_OUT_OF_RANGE;
+            }
+            if (!isDoubleInRange(waypoint.longitude, LONGITUDE_MIN, LONGITUDE_MAX))
+            {
+                return PARSE_LONGITUDE_OUT_OF_RANGE;
+            }
+        }
+        return PARSE_OK;
+    }
+    case COMMAND_ID_ANCHOR:
+    {
+        if (length != ANCHOR_MESSAGE_LENGTH)
+        {
+            return PARSE_ANCHOR_INVALID_LENGTH;
+        }
+
+        ushort frame = readUShortNetworkByteOrder(raw + 8);
+        if (frame != ANCHOR_FRAME_BODY && frame != ANCHOR_FRAME_ENU)
+        {
+            return PARSE_UNKNOWN_ANCHOR_FRAME;
+        }
 
-    WorldPosition worldPos = WorldPosition(latitude, longitude, altitude, heading, bank, pitch);
-    SetIndicatorCommandConfiguration commandConfig = SetIndicatorCommandConfiguration(id, indicatorTypeID, worldPos);
+        double values[6];
+        readDoublesInNetworkByteOrder(raw + 10, values, 6);
+        for (int i = 0; i < 6; i++)
+        {
+            // non-finite values would move the indicator on every aircraft state, as they never compare equal
+            double limit = i < 3 ? ANCHOR_MAX_OFFSET : ANCHOR_MAX_ANGLE;
+            if (!std::isfinite(values[i]) || std::fabs(values[i]) > limit)
+            {
+                return PARSE_ANCHOR_INVALID_OFFSET;
+            }
+        }
 
-    ValidationResult res = commandConfig.validate();
+        AnchorIndicatorCommand& anchorCommand = command.emplace<AnchorIndicatorCommand>();
+        anchorCommand.id = readUShortNetworkByteOrder(raw + 2);
+        anchorCommand.indicatorTypeID = readUintNetworkByteOrder(raw + 4);
+        anchorCommand.frame = static_cast<AnchorFrame>(frame);
+        anchorCommand.offset = AnchorOffset{ values[0], values[1], values[2], values[3], values[4], values[5] };
+        return PARSE_OK;
+    }
+    default:
+        return PARSE_UNKNOWN_COMMAND;
+    }
+}
 
-    if(res == OK)
+const char* CommandParser::getErrorName(ParseError error) noexcept
+{
+    switch (error)
     {
-    return std::make_unique<SetIndicatorCommandConfiguration>(commandConfig);
+    case PARSE_OK: return "ok";
+    case PARSE_MISSING_COMMAND: return "missing_command";
+    case PARSE_UNKNOWN_COMMAND: return "unknown_command";
+    case PARSE_SET_INVALID_LENGTH: return "set_invalid_length";
+    case PARSE_REMOVE_INVALID_LENGTH: return "remove_invalid_length";
+    case PARSE_SET_BATCH_INVALID_LENGTH: return "set_batch_invalid_length";
+    case PARSE_LATITUDE_OUT_OF_RANGE: return "LATITUDE_OUT_OF_RANGE";
+    case PARSE_LONGITUDE_OUT_OF_RANGE: return "LONGITUDE_OUT_OF_RANGE";
+    case PARSE_TELEMETRY_FORMAT_INVALID_LENGTH: return "telemetry_format_invalid_length";
+    case PARSE_UNKNOWN_TELEMETRY_FORMAT: return "unknown_telemetry_format";
+    case PARSE_SUBSCRIBE_INVALID_LENGTH: return "subscribe_invalid_length";
+    case PARSE_UNSUBSCRIBE_INVALID_LENGTH: return "unsubscribe_invalid_length";
+    case PARSE_PATH_INVALID_LENGTH: return "path_invalid_length";
+    case PARSE_PATH_INVALID_SPACING: return "path_invalid_spacing";
+    case PARSE_UNKNOWN_PATH_INTERPOLATION: return "unknown_path_interpolation";
+    case PARSE_ANCHOR_INVALID_LENGTH: return "anchor_invalid_length";
+    case PARSE_UNKNOWN_ANCHOR_FRAME: return "unknown_anchor_frame";
+    case PARSE_ANCHOR_INVALID_OFFSET: return "anchor_invalid_offset";
     }
-    else if(res == LATITUDE_OUT_OF_RANGE)
+    return "unknown_error";
+}
+
+std::string CommandParser::toString(const ParsedCommand& command)
+{
+    if (const SetIndicatorCommand* setCommand = std::get_if<SetIndicatorCommand>(&command))
     {
-        throw std::invalid_argument("LATITUDE_OUT_OF_RANGE");
+        return setIndicatorToString(*setCommand);
     }
-    else if (res == LONGITUDE_OUT_OF_RANGE)
+    else if (const SetIndicatorBatchCommand* batchCommand = std::get_if<SetIndicatorBatchCommand>(&command))
+    {
+        return setIndicatorBatchToString(batchCommand->indicators, batchCommand->count);
+    }
+    else if (const RemoveIndicatorsCommand* removeCommand = std::get_if<RemoveIndicatorsCommand>(&command))
+    {
+        return removeIndicatorsToString(removeCommand->ids, removeCommand->count);
+    }
+    else if (const TelemetryFormatCommand* formatCommand = std::get_if<TelemetryFormatCommand>(&command))
+    {
+        return telemetryFormatToString(*formatCommand);
+    }
+    else if (const SubscribeCommand* subscribeCommand = std::get_if<SubscribeCommand>(&command))
     {
-        throw std::invalid_argument("LONGITUDE_OUT_OF_RANGE");
+        return subscribeToString(*subscribeCommand);
+    }
+    else if (const UnsubscribeCommand* unsubscribeCommand = std::get_if<UnsubscribeCommand>(&command))
+    {
+        return unsubscribeToString(*unsubscribeCommand);
+    }
+    else if (const PathCommand* pathCommand = std::get_if<PathCommand>(&command))
+    {
+        return pathToString(pathCommand->firstID, pathCommand->indicatorTypeID, pathCommand->spacing, pathCommand->interpolation, pathCommand->count);
+    }
+    else if (const AnchorIndicatorCommand* anchorCommand = std::get_if<AnchorIndicatorCommand>(&command))
+    {
+        return anchorIndicatorToString(*anchorCommand);
     }
 
+    return "Empty command.";
 }
 
-ValidationResult SetIndicatorCommandConfiguration::validate()
+std::unique_ptr<AbstractCommandConfiguration> CommandConfigurationParser::parse(char* raw, uint length)
 {
-    if (!isDoubleInRange(position.getLatitude(), LATITUDE_MIN, LATITUDE_MAX))
+    // the parsed command is too large for the stack of every thread, so it is only allocated here
+    std::unique_ptr<ParsedCommand> command = std::make_unique<ParsedCommand>();
+
+    ParseError error = CommandParser::parse(raw, length, *command);
+    if (error != PARSE_OK)
     {
-        return LATITUDE_OUT_OF_RANGE;
+        throw std::invalid_argument(CommandParser::getErrorName(error));
     }
 
-    if (!isDoubleInRange(position.getLongitude(), LONGITUDE_MIN, LONGITUDE_MAX))
+    if (const SetIndicatorCommand* setCommand = std::get_if<SetIndicatorCommand>(command.get()))
     {
-        return LONGITUDE_OUT_OF_RANGE;
+        return std::make_unique<SetIndicatorCommandConfiguration>(*setCommand);
+    }
+    else if (const SetIndicatorBatchCommand* batchCommand = std::get_if<SetIndicatorBatchCommand>(command.get()))
+    {
+        return std::make_unique<SetIndicatorBatchCommandConfiguration>(*batchCommand);
+    }
+    else if (const RemoveIndicatorsCommand* removeCommand = std::get_if<RemoveIndicatorsCommand>(command.get()))
+    {
+        return std::make_unique<RemoveIndicatorsCommandConfiguration>(*removeCommand);
     }
 
-    return OK;
+    // the other commands are only available through CommandParser
+    throw std::invalid_argument(CommandParser::getErrorName(PARSE_UNKNOWN_COMMAND));
 }
 
+
+
+//////////////
+///   SET  ///
+//////////////
+
 ushort SetIndicatorCommandConfiguration::getID()
 {
-    return this->id;
+    return this->command.id;
 }
 
 uint SetIndicatorCommandConfiguration::getIndicatorTypeID()
 {
-    return this->indicatorTypeID;
+    return this->command.indicatorTypeID;
 }
 
 WorldPosition SetIndicatorCommandConfiguration::getPosition()
 {
-    return this->position;
+    return WorldPosition(this->command.position);
 }
 
 std::string SetIndicatorCommandConfiguration::toString()
 {
-    return "Set Indicator: Indicator " + std::to_string(id) + 
-        " of type " + std::to_string(indicatorTypeID) + 
-        " Lat: " + std::to_string(position.getLatitude()) + 
-        ", Long: " + std::to_string(position.getLongitude()) +
-        ", Height: " + std::to_string(position.getAltitude()) + 
-        ", Roll: " + std::to_string(position.getHeading()) + 
-        ", Pitch: " + std::to_string(position.getBank()) +
-        ", Yaw: " + std::to_string(position.getPitch());
+    return setIndicatorToString(command);
 }
 
-//////////////
-/// REMOVE ///
-//////////////
-std::unique_ptr<RemoveIndicatorsCommandConfiguration> RemoveIndicatorsCommandConfiguration::parse(char* array, uint length)
-{
-    RemoveIndicatorsCommandConfiguration command;
+/////////////////
+/// SET BATCH ///
+/////////////////
 
-    for (uint curMemOffset = 2; curMemOffset < length; curMemOffset = curMemOffset + sizeof(ushort))
-    {
-        ushort id = readUShortNetworkByteOrder(array + curMemOffset);
-        command.idsToRemove.push_back(id);
-    }
+std::vector<SetIndicatorCommandConfiguration>& SetIndicatorBatchCommandConfiguration::getIndicators()
+{
+    return this->indicators;
+}
 
-    return std::make_unique<RemoveIndicatorsCommandConfiguration>(command);
+std::string SetIndicatorBatchCommandConfiguration::toString()
+{
+    return "Set Indicator Batch: " + std::to_string(indicators.size()) + " indicators (IDs " +
+        std::to_string(indicators.front().getID()) + " - " + std::to_string(indicators.back().getID()) + ")";
 }
 
-std::vector<ushort> RemoveIndicatorsCommandConfiguration::getIDsToRemove()
+//////////////
+/// REMOVE ///
+//////////////
+
+const std::vector<ushort>& RemoveIndicatorsCommandConfiguration::getIDsToRemove()
 {
     return this->idsToRemove;
 }
 
 std::string RemoveIndicatorsCommandConfiguration::toString()
 {
-    if (idsToRemove.size() == 0)
-    {
-        return "Delete all indicators.";
-    }
-
-    std::string msg = "Delete indicators: ";
-
-    for (uint i = 0; i < idsToRemove.size(); i++)
-    {
-        msg = msg + std::to_string(idsToRemove.at(i));
-        if(i + 1 != idsToRemove.size()) {
-            msg = msg + ", ";
-        }
-        
-    }
-
-    return msg;
+    return removeIndicatorsToString(idsToRemove.data(), idsToRemove.size());
 }
\ No newline at end of file
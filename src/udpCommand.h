@@ -20,22 +20,313 @@
 
 #include "datatypes.h"
 #include "worldPosition.h"
+#include "pathGenerator.h"
+#include "indicatorAnchor.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <variant>
+
+/// Wire ids of the commands
+#define COMMAND_ID_SET 1
+#define COMMAND_ID_REMOVE 2
+#define COMMAND_ID_SET_BATCH 3
+#define COMMAND_ID_TELEMETRY_FORMAT 4
+#define COMMAND_ID_SUBSCRIBE 5
+#define COMMAND_ID_UNSUBSCRIBE 6
+#define COMMAND_ID_PATH 7
+#define COMMAND_ID_ANCHOR 8
+
+/// Maximum length of a command message (UDP payload of an Ethernet frame without fragmentation)
+#define COMMAND_MAX_MESSAGE_LENGTH 1472
+
+/// Length of a complete SET message (command id + record)
+#define SET_MESSAGE_LENGTH 56
+
+/// Length of a SET record: indicator id (2), indicator type id (4), position and orientation (6 * 8)
+#define SET_RECORD_LENGTH 54
+
+/// Length of the SET_BATCH header: command id (2), number of records (2)
+#define SET_BATCH_HEADER_LENGTH 4
+
+/// Length of a TELEMETRY_FORMAT message: command id (2), format version (2)
+#define TELEMETRY_FORMAT_MESSAGE_LENGTH 4
+
+/// Length of a SUBSCRIBE message: command id (2), format version (2), rate in Hz (2), port (2)
+#define SUBSCRIBE_MESSAGE_LENGTH 8
+
+/// Length of an UNSUBSCRIBE message: command id (2), port (2)
+#define UNSUBSCRIBE_MESSAGE_LENGTH 4
+
+/// Length of an ANCHOR message: command id (2), indicator id (2), indicator type id (4), frame (2), offset and orientation (6 * 8)
+#define ANCHOR_MESSAGE_LENGTH 58
+
+/// Maximum distance of an anchored indicator from the aircraft along each axis in m
+#define ANCHOR_MAX_OFFSET 100000.0
+
+/// Maximum absolute value of the orientation angles of an anchored indicator in degrees
+#define ANCHOR_MAX_ANGLE 360.0
+
+/// Length of the PATH header: command id (2), first indicator id (2), indicator type id (4), spacing in m (8), interpolation (2),
+/// number of waypoints (2)
+#define PATH_HEADER_LENGTH 20
+
+/// Length of a PATH waypoint: latitude, longitude and altitude (3 * 8)
+#define PATH_WAYPOINT_LENGTH 24
+
+/// Maximum number of waypoints of a PATH message
+#define MAX_PATH_WAYPOINTS ((COMMAND_MAX_MESSAGE_LENGTH - PATH_HEADER_LENGTH) / PATH_WAYPOINT_LENGTH)
+
+/// Maximum number of records of a SET_BATCH message
+#define MAX_SET_BATCH_RECORDS ((COMMAND_MAX_MESSAGE_LENGTH - SET_BATCH_HEADER_LENGTH) / SET_RECORD_LENGTH)
+
+/// Maximum number of indicator ids of a REMOVE message
+#define MAX_REMOVE_IDS ((COMMAND_MAX_MESSAGE_LENGTH - 2) / 2)
 
 /// <summary>
 /// Command Types which can be executed.
 /// </summary>
-enum Command { SET, REMOVE };
+enum Command { SET, REMOVE, SET_BATCH };
 
 enum ValidationResult {OK, LATITUDE_OUT_OF_RANGE, LONGITUDE_OUT_OF_RANGE,};
 
+/// <summary>
+/// Reasons why a message could not be parsed.
+/// </summary>
+enum ParseError {
+    PARSE_OK,
+    PARSE_MISSING_COMMAND,
+    PARSE_UNKNOWN_COMMAND,
+    PARSE_SET_INVALID_LENGTH,
+    PARSE_REMOVE_INVALID_LENGTH,
+    PARSE_SET_BATCH_INVALID_LENGTH,
+    PARSE_LATITUDE_OUT_OF_RANGE,
+    PARSE_LONGITUDE_OUT_OF_RANGE,
+    PARSE_TELEMETRY_FORMAT_INVALID_LENGTH,
+    PARSE_UNKNOWN_TELEMETRY_FORMAT,
+    PARSE_SUBSCRIBE_INVALID_LENGTH,
+    PARSE_UNSUBSCRIBE_INVALID_LENGTH,
+    PARSE_PATH_INVALID_LENGTH,
+    PARSE_PATH_INVALID_SPACING,
+    PARSE_UNKNOWN_PATH_INTERPOLATION,
+    PARSE_ANCHOR_INVALID_LENGTH,
+    PARSE_UNKNOWN_ANCHOR_FRAME,
+    PARSE_ANCHOR_INVALID_OFFSET,
+};
+
+/// <summary>
+/// Sender of a message, IPv4 address and port in host byte order. The telemetry commands refer to the subscription of the sender.
+/// </summary>
+struct CommandSender {
+    uint address;
+    ushort port;
+};
+
+/// <summary>
+/// Parsed SET command: places an indicator or replaces it if it already exists.
+/// </summary>
+struct SetIndicatorCommand {
+    /// <summary>
+    /// The external indicator id.
+    /// </summary>
+    ushort id;
+
+    /// <summary>
+    /// The numerical representation of the indicator model.
+    /// </summary>
+    uint indicatorTypeID;
+
+    /// <summary>
+    /// Position and orientation of the indicator
+    /// </summary>
+    WorldPositionStruct position;
+};
+
+/// <summary>
+/// Parsed REMOVE command. The ids are stored inline, so the command can be moved through the command queue
+/// without any heap allocation.
+/// </summary>
+struct RemoveIndicatorsCommand {
+    /// <summary>
+    /// Number of valid entries in ids. 0 means that all indicators should be removed.
+    /// </summary>
+    ushort count;
+
+    /// <summary>
+    /// External ids of the indicators which should be removed.
+    /// </summary>
+    ushort ids[MAX_REMOVE_IDS];
+};
+
+/// <summary>
+/// Parsed SET_BATCH command. The records are stored inline, see RemoveIndicatorsCommand.
+/// </summary>
+struct SetIndicatorBatchCommand {
+    /// <summary>
+    /// Number of valid entries in indicators.
+    /// </summary>
+    ushort count;
+
+    /// <summary>
+    /// The SET commands in the order of the message.
+    /// </summary>
+    SetIndicatorCommand indicators[MAX_SET_BATCH_RECORDS];
+};
+
+/// <summary>
+/// Parsed TELEMETRY_FORMAT command: selects the wire format of the aircraft state messages which are sent to the target.
+/// </summary>
+struct TelemetryFormatCommand {
+    /// <summary>
+    /// Version of the wire format (see TelemetryFormat)
+    /// </summary>
+    ushort format;
+
+    /// <summary>
+    /// Sender of the command. If it is a subscriber, its format is changed, otherwise the one of the default target.
+    /// </summary>
+    CommandSender sender;
+};
+
+/// <summary>
+/// Parsed SUBSCRIBE command: registers a telemetry subscriber or renews its subscription.
+/// </summary>
+struct SubscribeCommand {
+    /// <summary>
+    /// Version of the wire format (see TelemetryFormat)
+    /// </summary>
+    ushort format;
+
+    /// <summary>
+    /// Maximum number of aircraft states per second, 0 for every state
+    /// </summary>
+    ushort rate;
+
+    /// <summary>
+    /// Sender of the command. The port is replaced by the port of the message if it is not 0.
+    /// </summary>
+    CommandSender subscriber;
+};
+
+/// <summary>
+/// Parsed UNSUBSCRIBE command: removes a telemetry subscriber.
+/// </summary>
+struct UnsubscribeCommand {
+    /// <summary>
+    /// Sender of the command. The port is replaced by the port of the message if it is not 0.
+    /// </summary>
+    CommandSender subscriber;
+};
+
+/// <summary>
+/// Parsed PATH command: places indicators along a curve through the waypoints. The waypoints are stored inline, see
+/// RemoveIndicatorsCommand.
+/// </summary>
+struct PathCommand {
+    /// <summary>
+    /// External id of the first indicator, the following indicators get the next ids.
+    /// </summary>
+    ushort firstID;
+
+    /// <summary>
+    /// The numerical representation of the indicator model.
+    /// </summary>
+    uint indicatorTypeID;
+
+    /// <summary>
+    /// Distance between two indicators along the ground track in m.
+    /// </summary>
+    double spacing;
+
+    /// <summary>
+    /// Curve through the waypoints.
+    /// </summary>
+    PathInterpolation interpolation;
+
+    /// <summary>
+    /// Number of valid entries in waypoints, at least 2.
+    /// </summary>
+    ushort count;
+
+    /// <summary>
+    /// The waypoints in the order of the message.
+    /// </summary>
+    PathWaypoint waypoints[MAX_PATH_WAYPOINTS];
+};
+
+/// <summary>
+/// Parsed ANCHOR command: places an indicator relative to the aircraft. The extension moves it with every aircraft state until
+/// it is removed or placed with a SET command.
+/// </summary>
+struct AnchorIndicatorCommand {
+    /// <summary>
+    /// The external indicator id.
+    /// </summary>
+    ushort id;
+
+    /// <summary>
+    /// The numerical representation of the indicator model.
+    /// </summary>
+    uint indicatorTypeID;
+
+    /// <summary>
+    /// Frame of the offset.
+    /// </summary>
+    AnchorFrame frame;
+
+    /// <summary>
+    /// Position and orientation relative to the aircraft.
+    /// </summary>
+    AnchorOffset offset;
+};
+
+/// <summary>
+/// A parsed command as tagged value type. std::monostate marks an empty command.
+/// </summary>
+typedef std::variant<std::monostate, SetIndicatorCommand, RemoveIndicatorsCommand, SetIndicatorBatchCommand, TelemetryFormatCommand,
+    SubscribeCommand, UnsubscribeCommand, PathCommand, AnchorIndicatorCommand> ParsedCommand;
+
+/// <summary>
+/// Allocation- and exception-free parser for incoming messages. This is the parser used on the receive path.
+/// </summary>
+class CommandParser
+{
+public:
+    /// <summary>
+    /// Parses the given message into the given command. The message is read in a single pass and nothing is allocated.
+    /// </summary>
+    /// <param name="raw">Raw data</param>
+    /// <param name="length">Length of raw data</param>
+    /// <param name="command">Receives the parsed command, only valid if PARSE_OK is returned</param>
+    /// <param name="sender">Sender of the message, only used by the telemetry commands</param>
+    /// <returns>PARSE_OK or the reason why the message is invalid</returns>
+    static ParseError parse(const char* raw, uint length, ParsedCommand& command, CommandSender sender = CommandSender()) noexcept;
+
+    /// <summary>
+    /// Returns a short, stable name of the parse error (e.g. "set_invalid_length").
+    /// </summary>
+    /// <param name="error">The parse error</param>
+    /// <returns>Name of the parse error</returns>
+    static const char* getErrorName(ParseError error) noexcept;
+
+    /// <summary>
+    /// Returns a human-readable string representation of the command.
+    /// </summary>
+    /// <param name="command">The parsed command</param>
+    /// <returns>Human-readable information about the command</returns>
+    static std::string toString(const ParsedCommand& command);
+};
+
 /// <summary>
 /// Abstract command configuration which at least provides the specified command.
 /// </summary>
 class AbstractCommandConfiguration {
 public:
+    /// <summary>
+    /// Virtual destructor
+    /// </summary>
+    virtual ~AbstractCommandConfiguration() = default;
+
     /// <summary>
     /// Returns the command which is configured by this specific command configuration.
     /// </summary>
@@ -56,11 +347,10 @@ class SetIndicatorCommandConfiguration : public AbstractCommandConfiguration
 {
 public:
     /// <summary>
-    /// Parses the fiven data and creates a command configuration.
+    /// Creates the command configuration from a parsed SET command.
     /// </summary>
-    /// <param name="array">Raw data</param>
-    /// <returns>Command configuration to place a SimObject</returns>
-    static std::unique_ptr<SetIndicatorCommandConfiguration> parse(char* array);
+    /// <param name="command">Parsed SET command</param>
+    explicit SetIndicatorCommandConfiguration(const SetIndicatorCommand& command) : command(command) {};
 
     Command getCommand() override {
         return Command::SET;
@@ -78,7 +368,7 @@ public:
     /// </summary>
     /// <returns>id of indicator model</returns>
     uint getIndicatorTypeID();
-    
+
     /// <summary>
     /// Returns position and orientation of the object.
     /// </summary>
@@ -89,36 +379,9 @@ public:
 
 private:
     /// <summary>
-    /// The external indicator id.
-    /// </summary>
-    ushort id;
-    
-    /// <summary>
-    /// The numierical representation of the indicator model.
-    /// </summary>
-    uint indicatorTypeID;
-
-    /// <summary>
-    /// Position and orientation of the object
-    /// </summary>
-    WorldPosition position;
-
-    /// <summary>
-    /// Private constructor. Use the parse method.
-    /// </summary>
-    /// <param name="id">External indicator id</param>
-    /// <param name="indicatorTypeID">Id of the indicator model</param>
-    /// <param name="worldPosition">Position and orientation</param>
-    SetIndicatorCommandConfiguration(ushort id, 
-                                     uint indicatorTypeID, 
-                                     WorldPosition worldPosition) 
-    : id(id), indicatorTypeID(indicatorTypeID), position(worldPosition) {};
-    
-    /// <summary>
-    /// Validates the settings of the command. This is mainly the latitude and longitude of the position.
+    /// The parsed SET command.
     /// </summary>
-    /// <returns>The result of the validation</returns>
-    ValidationResult validate();
+    SetIndicatorCommand command;
 };
 
 /// <summary>
@@ -127,39 +390,76 @@ private:
 class RemoveIndicatorsCommandConfiguration : public AbstractCommandConfiguration
 {
 public:
+    /// <summary>
+    /// Creates the command configuration from a parsed REMOVE command.
+    /// </summary>
+    /// <param name="command">Parsed REMOVE command</param>
+    explicit RemoveIndicatorsCommandConfiguration(const RemoveIndicatorsCommand& command)
+        : idsToRemove(command.ids, command.ids + command.count) {};
+
     Command getCommand() override {
         return Command::REMOVE;
     }
     std::string toString() override;
-    
-    /// <summary>
-    /// Parses the fiven data and creates a command configuration.
-    /// </summary>
-    /// <param name="array">Raw data</param>
-    /// <param name="length">Length of raw data</param>
-    /// <returns>Command configuration to remove a SimObject</returns>
-    static std::unique_ptr<RemoveIndicatorsCommandConfiguration> parse(char* array, uint length);
 
     /// <summary>
     /// Returns the external ids of the indicators which should be deleted.
     /// </summary>
     /// <returns>List of external indicator ids</returns>
-    std::vector<ushort> getIDsToRemove();
+    const std::vector<ushort>& getIDsToRemove();
 
 private:
     /// <summary>
-    /// Private constructor. Use the parse method.
+    /// List of external indicator ids which should be removed.
     /// </summary>
-    RemoveIndicatorsCommandConfiguration() {};
+    std::vector<ushort> idsToRemove;
+};
 
+/// <summary>
+/// Configuration for the command to place several SimObjects with a single message.
+/// </summary>
+class SetIndicatorBatchCommandConfiguration : public AbstractCommandConfiguration
+{
+public:
     /// <summary>
-    /// List of external indicator ids which should be removed.
+    /// Creates the command configuration from a parsed SET_BATCH command.
     /// </summary>
-    std::vector<ushort> idsToRemove;
+    /// <param name="command">Parsed SET_BATCH command</param>
+    explicit SetIndicatorBatchCommandConfiguration(const SetIndicatorBatchCommand& command)
+        : indicators(command.indicators, command.indicators + command.count) {};
+
+    Command getCommand() override {
+        return Command::SET_BATCH;
+    }
+    std::string toString() override;
+
+    /// <summary>
+    /// Returns the SET commands of the batch in the order of the message.
+    /// </summary>
+    /// <returns>List of SET commands</returns>
+    std::vector<SetIndicatorCommandConfiguration>& getIndicators();
+
+private:
+    /// <summary>
+    /// The SET commands of the batch.
+    /// </summary>
+    std::vector<SetIndicatorCommandConfiguration> indicators;
 };
 
+/// <summary>
+/// Parser which creates heap allocated command configurations and reports invalid messages with exceptions.
+/// It is based on CommandParser and kept for callers that prefer the class based representation of the SET, SET_BATCH and
+/// REMOVE commands, all other commands are rejected as unknown.
+/// </summary>
 class CommandConfigurationParser
 {
 public:
+    /// <summary>
+    /// Parses the given message.
+    /// </summary>
+    /// <param name="raw">Raw data</param>
+    /// <param name="length">Length of raw data</param>
+    /// <returns>The command configuration</returns>
+    /// <exception cref="std::invalid_argument">If the message is invalid, what() contains the name of the ParseError</exception>
     static std::unique_ptr<AbstractCommandConfiguration> parse(char* raw, uint length);
 };
\ No newline at end of file
@@ -16,6 +16,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifdef _WIN32 // Winsock backend, see udpProxyPosix.cpp for other platforms
+
 #include "udpProxy.h"
 #include "aircraftState.h"
 #include "datatypes.h"
@@ -29,12 +31,8 @@
 
 #pragma comment(lib, "ws2_32.lib")
 
-bool UDPProxy::startUDPProxy(ushort udpPort, UDPProxyCallback* callback, std::string targetIPAddress, ushort targetPort)
+bool UDPProxy::startUDPProxy(ushort udpPort, UDPProxyCallback* callback)
 {
-    targetAddr.sin_family = AF_INET;
-    targetAddr.sin_port = htons(targetPort);
-    inet_pton(AF_INET, targetIPAddress.c_str(), &targetAddr.sin_addr);
-
     openUDPSocket(udpPort);
 
     if (sock == INVALID_SOCKET)
@@ -89,13 +87,79 @@ void UDPProxy::openUDPSocket(ushort port)
     Logger::logInfo("UDP Port connected");
 }
 
-void UDPProxy::sendData(char* rawData, uint length)
+void UDPProxy::flushDatagrams()
 {
-    int res = sendto(sock, rawData, length, 0, (sockaddr*)&targetAddr, sizeof(targetAddr));
+    std::span<const UDPDatagram> datagrams = sendQueue.getDatagrams();
+
+    // Winsock has no call which sends several messages to different receivers
+    uint sent = 0;
+    for (const UDPDatagram& datagram : datagrams)
+    {
+        sockaddr_in targetAddr{};
+        targetAddr.sin_family = AF_INET;
+        targetAddr.sin_addr.s_addr = htonl(datagram.address);
+        targetAddr.sin_port = htons(datagram.port);
+
+        int res = sendto(sock, datagram.data, datagram.length, 0, (sockaddr*)&targetAddr, sizeof(targetAddr));
+
+        if (res == SOCKET_ERROR)
+        {
+            handleSendError("WSA Error " + std::to_string(WSAGetLastError()));
+            continue;
+        }
+        sent++;
+    }
 
-    if (res == SOCKET_ERROR)
+    sendQueue.recordSent(sent, static_cast<uint>(datagrams.size()));
+    sendQueue.clear();
+}
+
+bool UDPProxy::parseIPv4Address(const std::string& text, uint* address)
+{
+    in_addr addr;
+    if (inet_pton(AF_INET, text.c_str(), &addr) != 1)
     {
-        Logger::logError("Failed to send aircraft information: " + std::to_string(WSAGetLastError()));
+        return false;
+    }
+
+    *address = ntohl(addr.s_addr);
+    return true;
+}
+
+void UDPProxy::queueDatagram(const char* data, uint length, uint address, ushort port)
+{
+    if (sendQueue.isFull())
+    {
+        flushDatagrams();
+    }
+
+    if (!sendQueue.push(data, length, address, port))
+    {
+        handleSendError("message with " + std::to_string(length) + " bytes is too long");
+    }
+}
+
+void UDPProxy::sendDatagrams(std::span<const UDPDatagram> datagrams)
+{
+    for (const UDPDatagram& datagram : datagrams)
+    {
+        queueDatagram(datagram.data, datagram.length, datagram.address, datagram.port);
+    }
+    flushDatagrams();
+}
+
+UDPSendStatistics UDPProxy::getSendStatistics() const
+{
+    return sendQueue.getStatistics();
+}
+
+void UDPProxy::handleSendError(const std::string& error)
+{
+    unsigned long long suppressedErrors;
+    if (sendQueue.recordError(std::chrono::steady_clock::now(), &suppressedErrors))
+    {
+        Logger::logError("Failed to send aircraft information: " + error +
+            (suppressedErrors > 0 ? " (" + std::to_string(suppressedErrors) + " errors not logged)" : ""));
     }
 }
 
@@ -108,7 +172,7 @@ void UDPProxy::closeUDPSocket()
 void UDPProxy::handleSocket(UDPProxyCallback* callback)
 {
     struct sockaddr_in clientAddr;
-    char buffer[1024];
+    char buffer[UDP_MAX_MESSAGE_SIZE];
     int recvLen;
     int clientAddrLen = sizeof(clientAddr);
 
@@ -116,6 +180,7 @@ void UDPProxy::handleSocket(UDPProxyCallback* callback)
 
     while (isRunning)
     {
+        clientAddrLen = sizeof(clientAddr);
         recvLen = recvfrom(sock, buffer, sizeof(buffer) - 1, 0, (struct sockaddr*)&clientAddr, &clientAddrLen);
 
         // is UDP server stopped?
@@ -132,13 +197,16 @@ void UDPProxy::handleSocket(UDPProxyCallback* callback)
                 continue;
             }
             else if (lastErrorCode == WSAEMSGSIZE) {
-                Logger::logError("Message size is more than 1024 Bytes. Message ignored!");
+                Logger::logError("Message size is more than " + std::to_string(UDP_MAX_MESSAGE_SIZE) + " Bytes. Message ignored!");
                 continue;
             }
             Logger::logError("Failed to handle incoming UDP message. WSA Error: " + std::to_string(lastErrorCode));
             continue;
         }
 
-        callback->handleMessage(buffer, recvLen);
+        UDPMessage message{ buffer, static_cast<uint>(recvLen), ntohl(clientAddr.sin_addr.s_addr), ntohs(clientAddr.sin_port) };
+        callback->handleMessages(std::span<UDPMessage>(&message, 1));
     }
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -20,9 +20,51 @@
 
 #include "datatypes.h"
 #include "aircraftState.h"
+#include "udpSendQueue.h"
 #include <string>
-#include <winsock2.h>
 #include <thread>
+#include <atomic>
+#include <span>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+typedef int SOCKET;
+#define INVALID_SOCKET (-1)
+#endif
+
+/// Maximum size of an incoming UDP message in bytes (UDP payload of an Ethernet frame without fragmentation)
+#define UDP_MAX_MESSAGE_SIZE 1472
+
+/// Maximum number of UDP messages which are received with one system call (if supported by the socket backend)
+#define UDP_RECEIVE_BATCH_SIZE 64
+
+/// <summary>
+/// A received UDP message. The data is only valid until the callback returns.
+/// </summary>
+struct UDPMessage {
+    /// <summary>
+    /// The message as char array
+    /// </summary>
+    char* data;
+
+    /// <summary>
+    /// The length of the array
+    /// </summary>
+    uint length;
+
+    /// <summary>
+    /// IPv4 address of the sender in host byte order
+    /// </summary>
+    uint sourceAddress;
+
+    /// <summary>
+    /// Port of the sender in host byte order
+    /// </summary>
+    ushort sourcePort;
+};
 
 /// <summary>
 /// Callback for incoming messages to show or remove indicators.
@@ -40,10 +82,25 @@ public:
     /// <param name="message">The message as char array</param>
     /// <param name="length">The length of the array</param>
     virtual void handleMessage(char* message, uint length) = 0;
+
+    /// <summary>
+    /// Handles a batch of incoming messages which were received with a single system call.
+    /// The default implementation calls handleMessage for every message.
+    /// </summary>
+    /// <param name="messages">The received messages in order of arrival</param>
+    virtual void handleMessages(std::span<UDPMessage> messages)
+    {
+        for (UDPMessage& message : messages)
+        {
+            handleMessage(message.data, message.length);
+        }
+    }
 };
 
 /// <summary>
 /// Proxy class for incoming and outgoing UDP data traffic.
+/// There are two socket backends: Winsock (udpProxy.cpp) and POSIX sockets (udpProxyPosix.cpp). The POSIX backend
+/// receives up to UDP_RECEIVE_BATCH_SIZE messages per system call and passes them to UDPProxyCallback::handleMessages.
 /// </summary>
 class UDPProxy {
 public: 
@@ -53,17 +110,42 @@ public:
     /// </summary>
     /// <param name="udpPort">Port number for incoming data</param>
     /// <param name="callback">Callback to handle incoming data</param>
-    /// <param name="targetIPAddress">Target IP address for outgoing data</param>
-    /// <param name="targetPort">Target port number for outgoing data</param>
     /// <returns></returns>
-    bool startUDPProxy(ushort udpPort, UDPProxyCallback* callback, std::string targetIPAddress, ushort targetPort);
+    bool startUDPProxy(ushort udpPort, UDPProxyCallback* callback);
 
     /// <summary>
-    /// Sends the given data to the target for outgoing data.
+    /// Copies a message into the send queue. A full queue is sent first.
     /// </summary>
-    /// <param name="rawData">Data to be send</param>
-    /// <param name="length">Data length</param>
-    void sendData(char* rawData, uint length);
+    /// <param name="data">The message</param>
+    /// <param name="length">Length of the message, at most UDP_MAX_SEND_MESSAGE_SIZE</param>
+    /// <param name="address">IPv4 address of the receiver in host byte order</param>
+    /// <param name="port">Port of the receiver in host byte order</param>
+    void queueDatagram(const char* data, uint length, uint address, ushort port);
+
+    /// <summary>
+    /// Sends all queued messages, up to UDP_SEND_BATCH_SIZE messages with one system call.
+    /// </summary>
+    void flushDatagrams();
+
+    /// <summary>
+    /// Queues the given messages and sends them.
+    /// </summary>
+    /// <param name="datagrams">Messages and their receivers</param>
+    void sendDatagrams(std::span<const UDPDatagram> datagrams);
+
+    /// <summary>
+    /// Returns the counters of the outgoing messages.
+    /// </summary>
+    /// <returns>Statistics of the outgoing messages</returns>
+    UDPSendStatistics getSendStatistics() const;
+
+    /// <summary>
+    /// Converts an IPv4 address in dotted notation to an address in host byte order.
+    /// </summary>
+    /// <param name="text">Address in dotted notation</param>
+    /// <param name="address">Receives the address</param>
+    /// <returns>False if the text is no valid IPv4 address</returns>
+    static bool parseIPv4Address(const std::string& text, uint* address);
 
     /// <summary>
     /// Closes the UDP socket, stops the created thread and let it run dry
@@ -74,7 +156,7 @@ private:
     /// <summary>
     /// Flag for the running state of the serverThread.
     /// </summary>
-    bool isRunning;
+    std::atomic_bool isRunning{ false };
 
     /// <summary>
     /// Thread for receiving and handling of messages.
@@ -87,9 +169,32 @@ private:
     SOCKET sock;
 
     /// <summary>
-    /// Information about the target of outgoing messages.
+    /// Outgoing messages which were not sent yet. Only used by the sending thread.
+    /// </summary>
+    UDPSendQueue sendQueue;
+
+#ifndef _WIN32
+    /// <summary>
+    /// Message headers for sendmmsg, one per entry of the send queue.
+    /// </summary>
+    struct mmsghdr sendHeaders[UDP_SEND_BATCH_SIZE];
+
+    /// <summary>
+    /// Data descriptors for sendmmsg, one per entry of the send queue.
+    /// </summary>
+    struct iovec sendIovecs[UDP_SEND_BATCH_SIZE];
+
+    /// <summary>
+    /// Receivers for sendmmsg, one per entry of the send queue.
+    /// </summary>
+    sockaddr_in sendAddrs[UDP_SEND_BATCH_SIZE];
+#endif
+
+    /// <summary>
+    /// Counts a message which could not be sent and logs the error at most once per UDP_SEND_ERROR_LOG_INTERVAL.
     /// </summary>
-    sockaddr_in targetAddr;
+    /// <param name="error">Description of the error</param>
+    void handleSendError(const std::string& error);
 
     /// <summary>
     /// Opens the necessary socket for incoming and outgoing UDP traffic.
@@ -0,0 +1,256 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _WIN32 // POSIX socket backend, see udpProxy.cpp for Windows
+
+#include "udpProxy.h"
+#include "datatypes.h"
+#include "log.h"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+bool UDPProxy::startUDPProxy(ushort udpPort, UDPProxyCallback* callback)
+{
+    // the message headers only reference preallocated memory, so they are initialized once
+    std::memset(sendHeaders, 0, sizeof(sendHeaders));
+    std::memset(sendAddrs, 0, sizeof(sendAddrs));
+
+    openUDPSocket(udpPort);
+
+    if (sock == INVALID_SOCKET)
+    {
+        return false;
+    }
+
+    isRunning = true;
+    serverThread = std::thread(&UDPProxy::handleSocket, this, callback);
+    return true;
+}
+
+void UDPProxy::stopUDPProxy()
+{
+    isRunning = false;
+
+    // closing a socket does not wake up a thread blocked in recvmmsg, shutting it down does
+    shutdown(sock, SHUT_RDWR);
+
+    // Waiting for thread to finish
+    serverThread.join();
+
+    closeUDPSocket();
+}
+
+void UDPProxy::openUDPSocket(ushort port)
+{
+    struct sockaddr_in serverAddr {};
+
+    Logger::logInfo(("Connecting to UDP port " + std::to_string(port) + "...").c_str());
+
+    sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET) {
+        Logger::logError("Create socket failed. Error: " + std::string(strerror(errno)));
+        return;
+    }
+
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = INADDR_ANY;
+    serverAddr.sin_port = htons(port);
+
+    if (bind(sock, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) != 0) {
+        Logger::logError("Failed to bind to socket. Error: " + std::string(strerror(errno)));
+        close(sock);
+        sock = INVALID_SOCKET;
+        return;
+    }
+
+    Logger::logInfo("UDP Port connected");
+}
+
+void UDPProxy::flushDatagrams()
+{
+    std::span<const UDPDatagram> datagrams = sendQueue.getDatagrams();
+    uint count = static_cast<uint>(datagrams.size());
+
+    for (uint i = 0; i < count; i++)
+    {
+        const UDPDatagram& datagram = datagrams[i];
+        sendAddrs[i].sin_family = AF_INET;
+        sendAddrs[i].sin_addr.s_addr = htonl(datagram.address);
+        sendAddrs[i].sin_port = htons(datagram.port);
+        sendIovecs[i].iov_base = const_cast<char*>(datagram.data);
+        sendIovecs[i].iov_len = datagram.length;
+        sendHeaders[i].msg_hdr.msg_name = &sendAddrs[i];
+        sendHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        sendHeaders[i].msg_hdr.msg_iov = &sendIovecs[i];
+        sendHeaders[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // sendmmsg stops at the first message which fails, the remaining ones are sent with the next call
+    uint sent = 0;
+    uint systemCalls = 0;
+    while (sent < count)
+    {
+        int res = sendmmsg(sock, sendHeaders + sent, count - sent, 0);
+        systemCalls++;
+
+        if (res < 0)
+        {
+            handleSendError(strerror(errno));
+            sent++;
+            continue;
+        }
+
+        sendQueue.recordSent(res, 0);
+        sent += res;
+    }
+
+    sendQueue.recordSent(0, systemCalls);
+    sendQueue.clear();
+}
+
+bool UDPProxy::parseIPv4Address(const std::string& text, uint* address)
+{
+    in_addr addr;
+    if (inet_pton(AF_INET, text.c_str(), &addr) != 1)
+    {
+        return false;
+    }
+
+    *address = ntohl(addr.s_addr);
+    return true;
+}
+
+void UDPProxy::queueDatagram(const char* data, uint length, uint address, ushort port)
+{
+    if (sendQueue.isFull())
+    {
+        flushDatagrams();
+    }
+
+    if (!sendQueue.push(data, length, address, port))
+    {
+        handleSendError("message with " + std::to_string(length) + " bytes is too long");
+    }
+}
+
+void UDPProxy::sendDatagrams(std::span<const UDPDatagram> datagrams)
+{
+    for (const UDPDatagram& datagram : datagrams)
+    {
+        queueDatagram(datagram.data, datagram.length, datagram.address, datagram.port);
+    }
+    flushDatagrams();
+}
+
+UDPSendStatistics UDPProxy::getSendStatistics() const
+{
+    return sendQueue.getStatistics();
+}
+
+void UDPProxy::handleSendError(const std::string& error)
+{
+    unsigned long long suppressedErrors;
+    if (sendQueue.recordError(std::chrono::steady_clock::now(), &suppressedErrors))
+    {
+        Logger::logError("Failed to send aircraft information: " + error +
+            (suppressedErrors > 0 ? " (" + std::to_string(suppressedErrors) + " errors not logged)" : ""));
+    }
+}
+
+void UDPProxy::closeUDPSocket()
+{
+    close(sock);
+}
+
+void UDPProxy::handleSocket(UDPProxyCallback* callback)
+{
+    // one preallocated slab for all receive buffers, the message headers point into it
+    std::vector<char> slab(UDP_RECEIVE_BATCH_SIZE * UDP_MAX_MESSAGE_SIZE);
+    std::vector<struct iovec> iovecs(UDP_RECEIVE_BATCH_SIZE);
+    std::vector<struct mmsghdr> headers(UDP_RECEIVE_BATCH_SIZE);
+    std::vector<sockaddr_in> clientAddrs(UDP_RECEIVE_BATCH_SIZE);
+    std::vector<UDPMessage> messages(UDP_RECEIVE_BATCH_SIZE);
+
+    for (uint i = 0; i < UDP_RECEIVE_BATCH_SIZE; i++)
+    {
+        iovecs[i].iov_base = slab.data() + i * UDP_MAX_MESSAGE_SIZE;
+        iovecs[i].iov_len = UDP_MAX_MESSAGE_SIZE;
+    }
+
+    while (isRunning)
+    {
+        for (uint i = 0; i < UDP_RECEIVE_BATCH_SIZE; i++)
+        {
+            headers[i] = {};
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &clientAddrs[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+
+        // blocks until at least one message is available, then takes everything that is already queued
+        int received = recvmmsg(sock, headers.data(), UDP_RECEIVE_BATCH_SIZE, MSG_WAITFORONE, nullptr);
+
+        // is UDP server stopped?
+        if (!isRunning)
+        {
+            return;
+        }
+
+        if (received < 0)
+        {
+            if (errno != EINTR)
+            {
+                Logger::logError("Failed to handle incoming UDP message. Error: " + std::string(strerror(errno)));
+            }
+            continue;
+        }
+
+        uint messageCount = 0;
+        for (int i = 0; i < received; i++)
+        {
+            if (headers[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                Logger::logError("Message size is more than " + std::to_string(UDP_MAX_MESSAGE_SIZE) + " Bytes. Message ignored!");
+                continue;
+            }
+
+            messages[messageCount].data = static_cast<char*>(iovecs[i].iov_base);
+            messages[messageCount].length = headers[i].msg_len;
+            messages[messageCount].sourceAddress = ntohl(clientAddrs[i].sin_addr.s_addr);
+            messages[messageCount].sourcePort = ntohs(clientAddrs[i].sin_port);
+            messageCount++;
+        }
+
+        if (messageCount > 0)
+        {
+            callback->handleMessages(std::span<UDPMessage>(messages.data(), messageCount));
+        }
+    }
+}
+
+#endif
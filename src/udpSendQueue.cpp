@@ -0,0 +1,87 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "udpSendQueue.h"
+
+#include <cstring>
+
+UDPSendQueue::UDPSendQueue()
+    : buffers(UDP_SEND_BATCH_SIZE * UDP_MAX_SEND_MESSAGE_SIZE)
+{
+    datagrams.reserve(UDP_SEND_BATCH_SIZE);
+}
+
+bool UDPSendQueue::push(const char* data, uint length, uint address, ushort port)
+{
+    if (isFull() || length > UDP_MAX_SEND_MESSAGE_SIZE)
+    {
+        return false;
+    }
+
+    char* buffer = &buffers[datagrams.size() * UDP_MAX_SEND_MESSAGE_SIZE];
+    std::memcpy(buffer, data, length);
+    datagrams.push_back(UDPDatagram{ buffer, length, address, port });
+    return true;
+}
+
+std::span<const UDPDatagram> UDPSendQueue::getDatagrams() const
+{
+    return std::span<const UDPDatagram>(datagrams.data(), datagrams.size());
+}
+
+bool UDPSendQueue::isFull() const
+{
+    return datagrams.size() >= UDP_SEND_BATCH_SIZE;
+}
+
+void UDPSendQueue::clear()
+{
+    datagrams.clear();
+}
+
+void UDPSendQueue::recordSent(uint datagrams, uint systemCalls)
+{
+    sentDatagrams.fetch_add(datagrams, std::memory_order_relaxed);
+    this->systemCalls.fetch_add(systemCalls, std::memory_order_relaxed);
+}
+
+bool UDPSendQueue::recordError(std::chrono::steady_clock::time_point time, unsigned long long* suppressedErrors)
+{
+    failedDatagrams.fetch_add(1, std::memory_order_relaxed);
+
+    // an unreachable receiver fails on every state, so only one error per interval is logged
+    if (time < nextErrorLog)
+    {
+        this->suppressedErrors++;
+        return false;
+    }
+
+    nextErrorLog = time + std::chrono::milliseconds(UDP_SEND_ERROR_LOG_INTERVAL);
+    *suppressedErrors = this->suppressedErrors;
+    this->suppressedErrors = 0;
+    return true;
+}
+
+UDPSendStatistics UDPSendQueue::getStatistics() const
+{
+    UDPSendStatistics statistics;
+    statistics.datagrams = sentDatagrams.load(std::memory_order_relaxed);
+    statistics.systemCalls = systemCalls.load(std::memory_order_relaxed);
+    statistics.errors = failedDatagrams.load(std::memory_order_relaxed);
+    return statistics;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+ * Visual Flight Path for Microsoft Flight Simulator 2024
+ * Copyright (c) 2026 Jens Scharmann / Fernuniversitt in Hagen
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "datatypes.h"
+
+#include <vector>
+#include <span>
+#include <atomic>
+#include <chrono>
+
+/// Maximum number of UDP messages which are sent with one system call (if supported by the socket backend)
+#define UDP_SEND_BATCH_SIZE 64
+
+/// Maximum size of an outgoing UDP message in bytes
+#define UDP_MAX_SEND_MESSAGE_SIZE 512
+
+/// Minimum time between two logged send errors, the errors in between are only counted (in ms)
+#define UDP_SEND_ERROR_LOG_INTERVAL 1000
+
+/// <summary>
+/// An outgoing UDP message.
+/// </summary>
+struct UDPDatagram {
+    /// <summary>
+    /// The message as char array
+    /// </summary>
+    const char* data;
+
+    /// <summary>
+    /// The length of the array
+    /// </summary>
+    uint length;
+
+    /// <summary>
+    /// IPv4 address of the receiver in host byte order
+    /// </summary>
+    uint address;
+
+    /// <summary>
+    /// Port of the receiver in host byte order
+    /// </summary>
+    ushort port;
+};
+
+/// <summary>
+/// Snapshot of the counters of the outgoing messages.
+/// </summary>
+struct UDPSendStatistics {
+    unsigned long long datagrams;   // sent messages
+    unsigned long long systemCalls; // system calls which sent them
+    unsigned long long errors;      // messages which could not be sent
+};
+
+/// <summary>
+/// Outgoing messages of the UDPProxy which are waiting to be sent with one system call.
+/// All buffers are allocated by the constructor, so queueing a message never allocates. Only the counters may be read by
+/// other threads, all other methods are called by the sending thread.
+/// </summary>
+class UDPSendQueue {
+public:
+    /// <summary>
+    /// Allocates the buffers for UDP_SEND_BATCH_SIZE messages.
+    /// </summary>
+    UDPSendQueue();
+
+    /// <summary>
+    /// Copies a message into the next free buffer.
+    /// </summary>
+    /// <param name="data">The message</param>
+    /// <param name="length">Length of the message, at most UDP_MAX_SEND_MESSAGE_SIZE</param>
+    /// <param name="address">IPv4 address of the receiver in host byte order</param>
+    /// <param name="port">Port of the receiver in host byte order</param>
+    /// <returns>False if the queue is full or the message too long</returns>
+    bool push(const char* data, uint length, uint address, ushort port);
+
+    /// <summary>
+    /// Returns the queued messages, they point into the buffers of the queue.
+    /// </summary>
+    /// <returns>The queued messages in order</returns>
+    std::span<const UDPDatagram> getDatagrams() const;
+
+    /// <summary>
+    /// Returns true if no further message can be queued.
+    /// </summary>
+    bool isFull() const;
+
+    /// <summary>
+    /// Removes all messages, the buffers are reused.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Counts successfully sent messages.
+    /// </summary>
+    /// <param name="datagrams">Number of sent messages</param>
+    /// <param name="systemCalls">Number of system calls which sent them</param>
+    void recordSent(uint datagrams, uint systemCalls);
+
+    /// <summary>
+    /// Counts a message which could not be sent and decides if the error is logged.
+    /// </summary>
+    /// <param name="time">Current time</param>
+    /// <param name="suppressedErrors">Receives the number of errors which were not logged since the last logged one</param>
+    /// <returns>True if the error should be logged</returns>
+    bool recordError(std::chrono::steady_clock::time_point time, unsigned long long* suppressedErrors);
+
+    /// <summary>
+    /// Returns the current counters.
+    /// </summary>
+    /// <returns>Statistics of the outgoing messages</returns>
+    UDPSendStatistics getStatistics() const;
+
+private:
+    /// <summary>
+    /// One buffer of UDP_MAX_SEND_MESSAGE_SIZE bytes per queued message.
+    /// </summary>
+    std::vector<char> buffers;
+
+    /// <summary>
+    /// Queued messages, the capacity is reserved for UDP_SEND_BATCH_SIZE messages.
+    /// </summary>
+    std::vector<UDPDatagram> datagrams;
+
+    /// <summary>
+    /// Time at which the next error is logged.
+    /// </summary>
+    std::chrono::steady_clock::time_point nextErrorLog;
+
+    /// <summary>
+    /// Errors since the last logged one.
+    /// </summary>
+    unsigned long long suppressedErrors = 0;
+
+    /// <summary>
+    /// Number of sent messages.
+    /// </summary>
+    std::atomic<unsigned long long> sentDatagrams{ 0 };
+
+    /// <summary>
+    /// Number of system calls which sent messages.
+    /// </summary>
+    std::atomic<unsigned long long> systemCalls{ 0 };
+
+    /// <summary>
+    /// Number of messages which could not be sent.
+    /// </summary>
+    std::atomic<unsigned long long> failedDatagrams{ 0 };
+};
\ No newline at end of file
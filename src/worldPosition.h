@@ -18,6 +18,12 @@
  */
 #pragma once
 
+/// Maximum distance between two positions which are treated as the same position (in m)
+#define WORLD_POSITION_DISTANCE_TOLERANCE 0.05
+
+/// Maximum difference between two angles which are treated as the same orientation (in degrees)
+#define WORLD_POSITION_ANGLE_TOLERANCE 0.05
+
 /// <summary>
 /// Plain data structure representing a position and orientation in world coordinates (for usage with SimConnect).
 /// </summary>
@@ -54,6 +60,15 @@ struct WorldPositionStruct
     double pitch;
 };
 
+/// <summary>
+/// Returns true if both positions differ less than WORLD_POSITION_DISTANCE_TOLERANCE and all angles less than
+/// WORLD_POSITION_ANGLE_TOLERANCE, so an object does not have to be moved from one to the other.
+/// </summary>
+/// <param name="a">First position</param>
+/// <param name="b">Second position</param>
+/// <returns>True if the positions are the same within the tolerances</returns>
+bool isSamePosition(const WorldPositionStruct& a, const WorldPositionStruct& b);
+
 ///<summary>
 /// Represents the position and orientation of an object in world coordinates to be used by SimConnect.
 /// </summary>